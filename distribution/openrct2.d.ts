@@ -1435,6 +1435,22 @@ declare global {
         getAllEntitiesOnTile(type: "staff", tilePos: CoordsXY): Staff[];
         getAllEntitiesOnTile(type: "car", tilePos: CoordsXY): Car[];
         getAllEntitiesOnTile(type: "litter", tilePos: CoordsXY): Litter[];
+
+        /**
+         * Reads fields of all entities of the given type in a single call, which is much faster than
+         * reading the same fields from the objects returned by getAllEntities.
+         * Each requested field is returned as a typed array with one element per matching entity,
+         * all arrays use the same entity order.
+         * @param type The type of entity to query.
+         * @param fields The fields to read, e.g. ["id", "x", "y", "happiness"]. Available for all types are
+         * id, x, y and z. Guests and staff also have energy and energyTarget. Guests have happiness,
+         * happinessTarget, nausea, nauseaTarget, hunger, thirst, toilet, mass, cash, isInPark, isLost and
+         * lostCountdown. Staff have colour and orders. Cars have ride, rideObject, vehicleObject, numSeats,
+         * currentStation, mass, acceleration, velocity, bankRotation, trackProgress and remainingDistance.
+         * Litter has creationTick.
+         * @param filter Restricts the entities that are returned.
+         */
+        queryEntities(type: "guest" | "staff" | "car" | "litter" | "balloon" | "duck", fields: string[], filter?: EntityQueryFilter): EntityQueryResult;
         createEntity(type: EntityType, initializer: object): Entity;
 
         /**
@@ -1446,6 +1462,32 @@ declare global {
         getTrackIterator(location: CoordsXY, elementIndex: number): TrackIterator | null;
     }
 
+    interface EntityQueryFilter {
+        /**
+         * Only include entities within this area.
+         */
+        range?: MapRange;
+
+        /**
+         * Only include entities where this field is within min and max, both inclusive.
+         */
+        field?: string;
+        min?: number;
+        max?: number;
+    }
+
+    interface EntityQueryResult {
+        /**
+         * The number of entities that matched the query.
+         */
+        readonly count: number;
+
+        /**
+         * The values of each requested field, e.g. result.happiness[i].
+         */
+        readonly [field: string]: number | Uint8Array | Uint16Array | Int32Array | Uint32Array;
+    }
+
     type TileElementType =
         "surface" | "footpath" | "track" | "small_scenery" | "wall" | "entrance" | "large_scenery" | "banner";
 
@@ -3284,6 +3326,7 @@ declare global {
     type ParkFlags =
         "difficultGuestGeneration" |
         "difficultParkRating" |
+        "fastMapSweeps" |
         "forbidHighConstruction" |
         "forbidLandscapeChanges" |
         "forbidMarketingCampaigns" |
@@ -4703,12 +4746,37 @@ declare global {
 
     interface Profiler {
         getData(): ProfiledFunction[];
+        /**
+         * Gets the time spent in each plugin and each of its hooks. Unlike getData, these are
+         * always recorded, even when the profiler has not been started.
+         */
+        getPluginData(): ProfiledPlugin[];
         start(): void;
         stop(): void;
         reset(): void;
         readonly enabled: boolean;
     }
 
+    interface ProfiledPlugin {
+        readonly name: string;
+        readonly callCount: number;
+        /** Times are in microseconds. */
+        readonly maxTime: number;
+        readonly totalTime: number;
+        /** Number of ticks in which the plugin's hooks took longer than the configured tick budget. */
+        readonly ticksOverBudget: number;
+        /** Whether interval.tick hooks of the plugin are currently being skipped for going over the budget. */
+        readonly isThrottled: boolean;
+        readonly hooks: ProfiledHook[];
+    }
+
+    interface ProfiledHook {
+        readonly hook: HookType;
+        readonly callCount: number;
+        readonly maxTime: number;
+        readonly totalTime: number;
+    }
+
     interface ProfiledFunction {
         readonly name: string;
         readonly callCount: number;
@@ -1150,8 +1150,8 @@ static void WidgetTextBoxDraw(DrawPixelInfo& dpi, WindowBase& w, WidgetIndex wid
     {
         if (widget.text != 0)
         {
-            u8string wrappedString;
-            GfxWrapString(widget.string, bottomRight.x - topLeft.x - 5, FontStyle::Medium, &wrappedString, nullptr);
+            OpenRCT2::FrameArena::String wrappedString;
+            GfxWrapString(widget.string, bottomRight.x - topLeft.x - 5, FontStyle::Medium, wrappedString, nullptr);
             DrawText(dpi, { topLeft.x + 2, topLeft.y }, { w.colours[1] }, wrappedString.c_str(), true);
         }
         return;
@@ -1159,8 +1159,8 @@ static void WidgetTextBoxDraw(DrawPixelInfo& dpi, WindowBase& w, WidgetIndex wid
 
     // String length needs to add 12 either side of box
     // +13 for cursor when max length.
-    u8string wrappedString;
-    GfxWrapString(gTextBoxInput, bottomRight.x - topLeft.x - 5 - 6, FontStyle::Medium, &wrappedString, nullptr);
+    OpenRCT2::FrameArena::String wrappedString;
+    GfxWrapString(gTextBoxInput, bottomRight.x - topLeft.x - 5 - 6, FontStyle::Medium, wrappedString, nullptr);
 
     DrawText(dpi, { topLeft.x + 2, topLeft.y }, { w.colours[1] }, wrappedString.c_str(), true);
 
@@ -1177,7 +1177,10 @@ static void WidgetTextBoxDraw(DrawPixelInfo& dpi, WindowBase& w, WidgetIndex wid
         // Make a new 1 character wide string for measuring the width
         // of the character that the cursor is under.
         width = std::max(
-            GfxGetStringWidthNoFormatting(u8string{ gTextBoxInput[gTextInput->SelectionStart] }, FontStyle::Medium) - 2, 4);
+            GfxGetStringWidthNoFormatting(
+                u8string_view{ &gTextBoxInput[gTextInput->SelectionStart], 1 }, FontStyle::Medium)
+                - 2,
+            4);
     }
 
     if (gTextBoxFrameNo <= 15)
@@ -33,6 +33,7 @@
 #include "core/File.h"
 #include "core/FileScanner.h"
 #include "core/FileStream.h"
+#include "core/FrameArena.h"
 #include "core/Guard.hpp"
 #include "core/Http.h"
 #include "core/MemoryStream.h"
@@ -1078,6 +1079,8 @@ namespace OpenRCT2
             {
                 RunFixedFrame(deltaTime);
             }
+
+            FrameArena::EndFrame();
         }
 
         void UpdateTimeAccumulators(float deltaTime)
@@ -13,6 +13,7 @@
 #include "Context.h"
 #include "Editor.h"
 #include "FileClassifier.h"
+#include "GameStateHash.h"
 #include "GameStateSnapshots.h"
 #include "Input.h"
 #include "OpenRCT2.h"
@@ -70,6 +71,8 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <chrono>
+#include <future>
 #include <iterator>
 #include <memory>
 
@@ -83,6 +86,7 @@ bool gInMapInitCode = false;
 std::string gCurrentLoadedPath;
 bool gIsAutosave = false;
 bool gIsAutosaveLoaded = false;
+static std::future<bool> _autosaveWrite;
 
 bool gLoadKeepWindowsOpen = false;
 
@@ -459,6 +463,7 @@ void GameLoadInit()
 {
     IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
     snapshots->Reset();
+    OpenRCT2::GameStateHash::Get().Reset();
 
     gScreenFlags = SCREEN_FLAGS_PLAYING;
     OpenRCT2::Audio::StopAll();
@@ -677,8 +682,23 @@ static void LimitAutosaveCount(const size_t numberOfFilesToKeep, bool processLan
     }
 }
 
+void GameCheckAutosaveWrite(bool wait)
+{
+    if (!_autosaveWrite.valid())
+        return;
+    if (!wait && _autosaveWrite.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    if (!_autosaveWrite.get())
+        Console::Error::WriteLine("Could not autosave the scenario. Is the save folder writeable?");
+}
+
 void GameAutosave()
 {
+    // The previous autosave may still be written in the background, finish it before
+    // touching the autosave folder again.
+    GameCheckAutosaveWrite(true);
+
     auto subDirectory = DIRID::SAVE;
     const char* fileExtension = ".park";
     uint32_t saveFlags = 0x80000000;
@@ -714,8 +734,7 @@ void GameAutosave()
         File::Copy(path, backupPath, true);
     }
 
-    if (!ScenarioSave(path, saveFlags))
-        Console::Error::WriteLine("Could not autosave the scenario. Is the save folder writeable?");
+    _autosaveWrite = ScenarioSaveInBackground(path, saveFlags);
 }
 
 static void GameLoadOrQuitNoSavePromptCallback(int32_t result, const utf8* path)
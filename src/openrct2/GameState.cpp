@@ -32,6 +32,7 @@
 #include "network/network.h"
 #include "platform/Platform.h"
 #include "profiling/Profiling.h"
+#include "profiling/TickStats.h"
 #include "ride/Vehicle.h"
 #include "scenario/Scenario.h"
 #include "scripting/ScriptEngine.h"
@@ -252,8 +253,13 @@ void GameState::Tick()
 
 void GameState::UpdateLogic()
 {
+    // Starts or stops a requested trace before anything of this tick is recorded.
+    Profiling::TraceTick(gCurrentTicks);
+
     PROFILED_FUNCTION();
 
+    TickStats::BeginTick();
+
     gInUpdateCode = true;
 
     gScreenAge++;
@@ -262,6 +268,7 @@ void GameState::UpdateLogic()
 
     GetContext()->GetReplayManager()->Update();
 
+    TickStats::BeginPhase(TickStats::Phase::Network);
     NetworkUpdate();
 
     if (NetworkGetMode() == NETWORK_MODE_SERVER)
@@ -279,6 +286,7 @@ void GameState::UpdateLogic()
         // Don't run past the server, this condition can happen during map changes.
         if (NetworkGetServerTick() == gCurrentTicks)
         {
+            TickStats::AbortTick();
             gInUpdateCode = false;
             return;
         }
@@ -305,6 +313,7 @@ void GameState::UpdateLogic()
     auto day = _date.GetDay();
 #endif
 
+    TickStats::BeginPhase(TickStats::Phase::World);
     _date.Update();
 
     ScenarioUpdate();
@@ -313,11 +322,17 @@ void GameState::UpdateLogic()
     // Temporarily remove provisional paths to prevent peep from interacting with them
     MapRemoveProvisionalElements();
     MapUpdatePathWideFlags();
+    TickStats::BeginPhase(TickStats::Phase::Peeps);
     PeepUpdateAll();
+    TickStats::BeginPhase(TickStats::Phase::World);
     MapRestoreProvisionalElements();
+    TickStats::BeginPhase(TickStats::Phase::Vehicles);
     VehicleUpdateAll();
+    TickStats::BeginPhase(TickStats::Phase::World);
     UpdateAllMiscEntities();
+    TickStats::BeginPhase(TickStats::Phase::Rides);
     Ride::UpdateAll();
+    TickStats::BeginPhase(TickStats::Phase::World);
 
     if (!(gScreenFlags & SCREEN_FLAGS_EDITOR))
     {
@@ -325,7 +340,9 @@ void GameState::UpdateLogic()
     }
 
     ResearchUpdate();
+    TickStats::BeginPhase(TickStats::Phase::Ratings);
     RideRatingsUpdateAll();
+    TickStats::BeginPhase(TickStats::Phase::Other);
     RideMeasurementsUpdate();
     News::UpdateCurrentItem();
 
@@ -344,8 +361,10 @@ void GameState::UpdateLogic()
         gLastAutoSaveUpdate = Platform::GetTicks();
     }
 
+    TickStats::BeginPhase(TickStats::Phase::Actions);
     GameActions::ProcessQueue();
 
+    TickStats::BeginPhase(TickStats::Phase::Network);
     NetworkProcessPending();
     NetworkFlush();
 
@@ -353,6 +372,7 @@ void GameState::UpdateLogic()
     gSavedAge++;
 
 #ifdef ENABLE_SCRIPTING
+    TickStats::BeginPhase(TickStats::Phase::Hooks);
     auto& hookEngine = GetContext()->GetScriptEngine().GetHookEngine();
     hookEngine.Call(HOOK_TYPE::INTERVAL_TICK, true);
 
@@ -360,8 +380,12 @@ void GameState::UpdateLogic()
     {
         hookEngine.Call(HOOK_TYPE::INTERVAL_DAY, true);
     }
+
+    GetContext()->GetScriptEngine().UpdatePluginBudgets();
 #endif
 
+    TickStats::EndTick(gCurrentTicks - 1);
+
     gInUpdateCode = false;
 }
 
@@ -0,0 +1,397 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "GameStateHash.h"
+
+#include "Game.h"
+#include "core/DataSerialiser.h"
+#include "core/MemoryStream.h"
+#include "entity/EntityRegistry.h"
+#include "entity/Guest.h"
+#include "entity/Litter.h"
+#include "entity/Staff.h"
+#include "management/Finance.h"
+#include "management/Research.h"
+#include "ride/Ride.h"
+#include "ride/Vehicle.h"
+#include "world/Map.h"
+#include "world/Park.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace OpenRCT2
+{
+    class StateHasher
+    {
+        static constexpr uint64_t Seed = 0xcbf29ce484222325ULL;
+        static constexpr uint64_t Prime = 0x00000100000001B3ULL;
+
+        uint64_t _hash = Seed;
+
+    public:
+        void AddBytes(const void* data, size_t length)
+        {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < length; i += sizeof(uint64_t))
+            {
+                uint64_t temp{};
+                std::memcpy(&temp, bytes + i, std::min<size_t>(sizeof(uint64_t), length - i));
+                _hash ^= temp;
+                _hash *= Prime;
+            }
+        }
+
+        template<typename T> void Add(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            AddBytes(&value, sizeof(T));
+        }
+
+        uint64_t GetHash() const
+        {
+            return _hash;
+        }
+    };
+
+    static uint64_t HashMapChunk(size_t index, int32_t chunksPerRow)
+    {
+        const auto chunkX = static_cast<int32_t>(index % chunksPerRow) * GameStateHash::ChunkSize;
+        const auto chunkY = static_cast<int32_t>(index / chunksPerRow) * GameStateHash::ChunkSize;
+
+        StateHasher hasher;
+        for (int32_t y = chunkY; y < std::min(chunkY + GameStateHash::ChunkSize, gMapSize.y); y++)
+        {
+            for (int32_t x = chunkX; x < std::min(chunkX + GameStateHash::ChunkSize, gMapSize.x); x++)
+            {
+                const auto* element = MapGetFirstElementAt(TileCoordsXY{ x, y });
+                if (element == nullptr)
+                    continue;
+
+                uint32_t count = 0;
+                do
+                {
+                    // Ghosts and construction highlights only exist for the local player.
+                    if (element->IsGhost())
+                        continue;
+
+                    auto copy = *element;
+                    copy.SetLastForTile(false);
+                    if (auto* track = copy.AsTrack(); track != nullptr)
+                        track->SetHighlight(false);
+                    hasher.Add(copy);
+                    count++;
+                } while (!(element++)->IsLastForTile());
+                hasher.Add(count);
+            }
+        }
+        return hasher.GetHash();
+    }
+
+    template<typename T> static bool SerialiseEntity(EntityBase* entity, DataSerialiser& ds)
+    {
+        auto* ent = entity->As<T>();
+        if (ent == nullptr)
+            return false;
+
+        ent->Serialise(ds);
+        return true;
+    }
+
+    static uint64_t HashEntity(size_t index)
+    {
+        // Same entity types as GetAllEntitiesChecksum, other entities are allowed to differ between clients.
+        auto* entity = GetEntity(EntityId::FromUnderlying(static_cast<EntityId::UnderlyingType>(index)));
+        if (entity == nullptr)
+            return 0;
+
+        static MemoryStream buffer;
+        buffer.SetPosition(0);
+        DataSerialiser ds(true, buffer);
+        if (!SerialiseEntity<Guest>(entity, ds) && !SerialiseEntity<Staff>(entity, ds)
+            && !SerialiseEntity<Vehicle>(entity, ds) && !SerialiseEntity<Litter>(entity, ds))
+        {
+            return 0;
+        }
+
+        StateHasher hasher;
+        hasher.AddBytes(buffer.GetData(), buffer.GetPosition());
+        return hasher.GetHash();
+    }
+
+    static uint64_t HashRide(size_t index)
+    {
+        const auto* ride = GetRide(RideId::FromUnderlying(static_cast<RideId::UnderlyingType>(index)));
+        if (ride == nullptr)
+            return 0;
+
+        StateHasher hasher;
+        hasher.Add(ride->type);
+        hasher.Add(ride->subtype);
+        hasher.Add(ride->mode);
+        hasher.Add(ride->status);
+        hasher.Add(ride->lifecycle_flags);
+        hasher.Add(ride->vehicles);
+        hasher.Add(ride->NumTrains);
+        hasher.Add(ride->num_cars_per_train);
+        hasher.Add(ride->cur_num_customers);
+        hasher.Add(ride->total_customers);
+        hasher.Add(ride->num_riders);
+        hasher.Add(ride->price);
+        hasher.Add(ride->value);
+        hasher.Add(ride->total_profit);
+        hasher.Add(ride->profit);
+        hasher.Add(ride->income_per_hour);
+        hasher.Add(ride->satisfaction);
+        hasher.Add(ride->popularity);
+        hasher.Add(ride->reliability);
+        hasher.Add(ride->breakdown_reason_pending);
+        hasher.Add(ride->mechanic_status);
+        hasher.Add(ride->mechanic);
+        hasher.Add(ride->downtime);
+        for (const auto& station : ride->GetStations())
+        {
+            hasher.Add(station.Depart);
+            hasher.Add(station.TrainAtStation);
+            hasher.Add(station.QueueLength);
+            hasher.Add(station.LastPeepInQueue);
+        }
+        return hasher.GetHash();
+    }
+
+    static uint64_t HashPark()
+    {
+        StateHasher hasher;
+        hasher.Add(gCash);
+        hasher.Add(gBankLoan);
+        hasher.Add(gCurrentExpenditure);
+        hasher.Add(gCurrentProfit);
+        hasher.Add(gParkFlags);
+        hasher.Add(gParkRating);
+        hasher.Add(gParkEntranceFee);
+        hasher.Add(gParkValue);
+        hasher.Add(gCompanyValue);
+        hasher.Add(gTotalAdmissions);
+        hasher.Add(gTotalIncomeFromAdmissions);
+        hasher.Add(gNumGuestsInPark);
+        hasher.Add(gResearchProgress);
+        return hasher.GetHash();
+    }
+
+    void GameStateHash::Tree::Resize(size_t numLeaves)
+    {
+        Leaves.assign(numLeaves, 0);
+        Blocks.assign((numLeaves + BlockSize - 1) / BlockSize, 0);
+        DirtyLeaves.assign(numLeaves, false);
+        DirtyBlocks.assign(Blocks.size(), false);
+        DirtyList.clear();
+        MarkAll();
+    }
+
+    void GameStateHash::Tree::Mark(size_t index)
+    {
+        if (index >= DirtyLeaves.size() || DirtyLeaves[index])
+            return;
+
+        DirtyLeaves[index] = true;
+        DirtyList.push_back(static_cast<uint32_t>(index));
+    }
+
+    void GameStateHash::Tree::MarkAll()
+    {
+        for (size_t i = 0; i < Leaves.size(); i++)
+        {
+            Mark(i);
+        }
+    }
+
+    GameStateHash& GameStateHash::Get()
+    {
+        static GameStateHash instance;
+        return instance;
+    }
+
+    void GameStateHash::Reset()
+    {
+        GetTree(Category::Map).Resize(GetNumChunks());
+        GetTree(Category::Entities).Resize(MAX_ENTITIES);
+        GetTree(Category::Rides).Resize(OpenRCT2::Limits::MaxRidesInPark);
+        GetTree(Category::Park).Resize(1);
+    }
+
+    void GameStateHash::MarkTileDirty(const CoordsXY& coords)
+    {
+        auto& tree = GetTree(Category::Map);
+        if (tree.Leaves.empty() || coords.IsNull() || coords.x < 0 || coords.y < 0)
+            return;
+
+        const auto tile = TileCoordsXY(coords);
+        const auto chunksPerRow = (gMapSize.x + ChunkSize - 1) / ChunkSize;
+        tree.Mark(static_cast<size_t>((tile.y / ChunkSize) * chunksPerRow + tile.x / ChunkSize));
+    }
+
+    void GameStateHash::MarkEntityDirty(EntityId id)
+    {
+        if (!id.IsNull())
+            GetTree(Category::Entities).Mark(id.ToUnderlying());
+    }
+
+    uint64_t GameStateHash::Update()
+    {
+        if (GetTree(Category::Entities).Leaves.empty())
+            Reset();
+        if (GetTree(Category::Map).Leaves.size() != GetNumChunks())
+            GetTree(Category::Map).Resize(GetNumChunks());
+
+        // Rides and the park are small enough to be re-hashed every tick.
+        GetTree(Category::Rides).MarkAll();
+        GetTree(Category::Park).MarkAll();
+
+        const auto chunksPerRow = (gMapSize.x + ChunkSize - 1) / ChunkSize;
+        const auto slice = gCurrentTicks % ScrubTicks;
+
+        StateHasher rootHasher;
+        for (size_t i = 0; i < NumCategories; i++)
+        {
+            const auto category = static_cast<Category>(i);
+            auto& tree = _trees[i];
+
+            const auto numLeaves = tree.Leaves.size();
+            for (size_t leaf = numLeaves * slice / ScrubTicks; leaf < numLeaves * (slice + 1) / ScrubTicks; leaf++)
+            {
+                tree.Mark(leaf);
+            }
+
+            for (auto leaf : tree.DirtyList)
+            {
+                switch (category)
+                {
+                    case Category::Map:
+                        tree.Leaves[leaf] = HashMapChunk(leaf, chunksPerRow);
+                        break;
+                    case Category::Entities:
+                        tree.Leaves[leaf] = HashEntity(leaf);
+                        break;
+                    case Category::Rides:
+                        tree.Leaves[leaf] = HashRide(leaf);
+                        break;
+                    default:
+                        tree.Leaves[leaf] = HashPark();
+                        break;
+                }
+                tree.DirtyLeaves[leaf] = false;
+                tree.DirtyBlocks[leaf / BlockSize] = true;
+            }
+            tree.DirtyList.clear();
+
+            StateHasher categoryHasher;
+            for (size_t block = 0; block < tree.Blocks.size(); block++)
+            {
+                if (tree.DirtyBlocks[block])
+                {
+                    const auto begin = block * BlockSize;
+                    StateHasher blockHasher;
+                    blockHasher.AddBytes(&tree.Leaves[begin], std::min(BlockSize, numLeaves - begin) * sizeof(uint64_t));
+                    tree.Blocks[block] = blockHasher.GetHash();
+                    tree.DirtyBlocks[block] = false;
+                }
+                categoryHasher.Add(tree.Blocks[block]);
+            }
+            tree.Hash = categoryHasher.GetHash();
+            rootHasher.Add(tree.Hash);
+        }
+        _root = rootHasher.GetHash();
+        return _root;
+    }
+
+    uint64_t GameStateHash::GetRoot() const
+    {
+        return _root;
+    }
+
+    uint64_t GameStateHash::GetCategoryHash(Category category) const
+    {
+        return GetTree(category).Hash;
+    }
+
+    std::array<uint64_t, GameStateHash::NumCategories> GameStateHash::GetCategoryHashes() const
+    {
+        std::array<uint64_t, NumCategories> hashes{};
+        for (size_t i = 0; i < NumCategories; i++)
+        {
+            hashes[i] = _trees[i].Hash;
+        }
+        return hashes;
+    }
+
+    const std::vector<uint64_t>& GameStateHash::GetBlocks(Category category) const
+    {
+        return GetTree(category).Blocks;
+    }
+
+    const std::vector<uint64_t>& GameStateHash::GetLeaves(Category category) const
+    {
+        return GetTree(category).Leaves;
+    }
+
+    const char* GameStateHash::GetCategoryName(Category category)
+    {
+        switch (category)
+        {
+            case Category::Map:
+                return "map";
+            case Category::Entities:
+                return "entities";
+            case Category::Rides:
+                return "rides";
+            case Category::Park:
+                return "park";
+            default:
+                return "unknown";
+        }
+    }
+
+    std::string GameStateHash::GetLeafName(Category category, size_t index)
+    {
+        switch (category)
+        {
+            case Category::Map:
+            {
+                const auto chunksPerRow = static_cast<size_t>(std::max((gMapSize.x + ChunkSize - 1) / ChunkSize, 1));
+                const auto x = static_cast<int32_t>(index % chunksPerRow) * ChunkSize;
+                const auto y = static_cast<int32_t>(index / chunksPerRow) * ChunkSize;
+                return "chunk " + std::to_string(index) + " (tiles " + std::to_string(x) + ", " + std::to_string(y) + " to "
+                    + std::to_string(x + ChunkSize - 1) + ", " + std::to_string(y + ChunkSize - 1) + ")";
+            }
+            case Category::Entities:
+                return "entity " + std::to_string(index);
+            case Category::Rides:
+                return "ride " + std::to_string(index);
+            default:
+                return GetCategoryName(category);
+        }
+    }
+
+    GameStateHash::Tree& GameStateHash::GetTree(Category category)
+    {
+        return _trees[static_cast<size_t>(category)];
+    }
+
+    const GameStateHash::Tree& GameStateHash::GetTree(Category category) const
+    {
+        return _trees[static_cast<size_t>(category)];
+    }
+
+    size_t GameStateHash::GetNumChunks() const
+    {
+        const auto chunksPerRow = (gMapSize.x + ChunkSize - 1) / ChunkSize;
+        const auto chunksPerColumn = (gMapSize.y + ChunkSize - 1) / ChunkSize;
+        return static_cast<size_t>(std::max(chunksPerRow * chunksPerColumn, 0));
+    }
+} // namespace OpenRCT2
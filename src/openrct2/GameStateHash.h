@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Identifiers.h"
+#include "common.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+struct CoordsXY;
+
+namespace OpenRCT2
+{
+    /**
+     * Hash tree over the game state, used to compare server and client state every tick.
+     *
+     * Leaves are map chunks, entities, rides and the park. A leaf is only re-hashed when it has been
+     * marked dirty, or when it falls into the slice of leaves that is re-hashed every tick regardless.
+     * The slice depends only on the current tick so both sides of a connection re-hash the same leaves at
+     * the same time, and any change that was not marked is still picked up within ScrubTicks ticks.
+     */
+    class GameStateHash
+    {
+    public:
+        enum class Category : uint8_t
+        {
+            Map,
+            Entities,
+            Rides,
+            Park,
+            Count,
+        };
+        static constexpr size_t NumCategories = static_cast<size_t>(Category::Count);
+
+        // Side length of a map chunk in tiles.
+        static constexpr int32_t ChunkSize = 32;
+        // Number of ticks it takes for every leaf to be re-hashed at least once.
+        static constexpr uint32_t ScrubTicks = 64;
+        // Number of leaves hashed together into a block.
+        static constexpr size_t BlockSize = 64;
+
+        static GameStateHash& Get();
+
+        void Reset();
+        void MarkTileDirty(const CoordsXY& coords);
+        void MarkEntityDirty(EntityId id);
+
+        // Brings all dirty leaves up to date, returns the root hash.
+        uint64_t Update();
+
+        uint64_t GetRoot() const;
+        uint64_t GetCategoryHash(Category category) const;
+        std::array<uint64_t, NumCategories> GetCategoryHashes() const;
+        const std::vector<uint64_t>& GetBlocks(Category category) const;
+        const std::vector<uint64_t>& GetLeaves(Category category) const;
+
+        static const char* GetCategoryName(Category category);
+        // Describes what a leaf covers, e.g. the tiles of a map chunk.
+        static std::string GetLeafName(Category category, size_t index);
+
+    private:
+        struct Tree
+        {
+            std::vector<uint64_t> Leaves;
+            std::vector<uint64_t> Blocks;
+            std::vector<bool> DirtyLeaves;
+            std::vector<bool> DirtyBlocks;
+            std::vector<uint32_t> DirtyList;
+            uint64_t Hash{};
+
+            void Resize(size_t numLeaves);
+            void Mark(size_t index);
+            void MarkAll();
+        };
+
+        std::array<Tree, NumCategories> _trees;
+        uint64_t _root{};
+
+        Tree& GetTree(Category category);
+        const Tree& GetTree(Category category) const;
+        size_t GetNumChunks() const;
+    };
+} // namespace OpenRCT2
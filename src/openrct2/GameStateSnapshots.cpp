@@ -20,11 +20,17 @@
 #include "entity/MoneyEffect.h"
 #include "entity/Particle.h"
 #include "entity/Staff.h"
+#include "profiling/MemoryStats.h"
 #include "ride/Vehicle.h"
 
+#include <cstring>
+
 static constexpr size_t MaximumGameStateSnapshots = 32;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
 
+// Number of captures that share a keyframe, the captures in between only store the entities that changed.
+static constexpr uint32_t SnapshotKeyframeInterval = MaximumGameStateSnapshots;
+
 #pragma pack(push, 1)
 union EntitySnapshot
 {
@@ -38,126 +44,188 @@ union EntitySnapshot
 assert_struct_size(EntitySnapshot, 0x200);
 #pragma pack(pop)
 
-struct GameStateSnapshot_t
+template<typename T> static bool EntitySizeCheck(DataSerialiser& ds)
 {
-    GameStateSnapshot_t& operator=(GameStateSnapshot_t&& mv) noexcept
+    uint32_t size = sizeof(T);
+    ds << size;
+    if (ds.IsLoading())
     {
-        tick = mv.tick;
-        storedSprites = std::move(mv.storedSprites);
-        return *this;
+        return size == sizeof(T);
     }
+    return true;
+}
 
-    uint32_t tick = InvalidTick;
-    uint32_t srand0 = 0;
+template<typename... T> static bool EntitiesSizeCheck(DataSerialiser& ds)
+{
+    return (EntitySizeCheck<T>(ds) && ...);
+}
 
-    OpenRCT2::MemoryStream storedSprites;
-    OpenRCT2::MemoryStream parkParameters;
+static bool SerialiseSpritesHeader(DataSerialiser& ds)
+{
+    // Encodes and checks the size of each of the entity so that we
+    // can fail gracefully when fields added/removed
+    return EntitiesSizeCheck<Vehicle, Guest, Staff, Litter, MoneyEffect, Balloon, Duck, JumpingFountain, SteamParticle>(ds);
+}
+
+static void SerialiseSprite(EntitySnapshot& sprite, DataSerialiser& ds)
+{
+    ds << sprite.base.Type;
+
+    switch (sprite.base.Type)
+    {
+        case EntityType::Vehicle:
+            reinterpret_cast<Vehicle&>(sprite).Serialise(ds);
+            break;
+        case EntityType::Guest:
+            reinterpret_cast<Guest&>(sprite).Serialise(ds);
+            break;
+        case EntityType::Staff:
+            reinterpret_cast<Staff&>(sprite).Serialise(ds);
+            break;
+        case EntityType::Litter:
+            reinterpret_cast<Litter&>(sprite).Serialise(ds);
+            break;
+        case EntityType::MoneyEffect:
+            reinterpret_cast<MoneyEffect&>(sprite).Serialise(ds);
+            break;
+        case EntityType::Balloon:
+            reinterpret_cast<Balloon&>(sprite).Serialise(ds);
+            break;
+        case EntityType::Duck:
+            reinterpret_cast<Duck&>(sprite).Serialise(ds);
+            break;
+        case EntityType::JumpingFountain:
+            reinterpret_cast<JumpingFountain&>(sprite).Serialise(ds);
+            break;
+        case EntityType::SteamParticle:
+            reinterpret_cast<SteamParticle&>(sprite).Serialise(ds);
+            break;
+        case EntityType::Null:
+            break;
+        default:
+            break;
+    }
+}
 
-    template<typename T> bool EntitySizeCheck(DataSerialiser& ds)
+// Must pass a function that can access the sprite.
+static void SerialiseSprites(
+    OpenRCT2::MemoryStream& stream, std::function<EntitySnapshot*(const EntityId)> getEntity, const size_t numSprites,
+    bool saving)
+{
+    const bool loading = !saving;
+
+    stream.SetPosition(0);
+    DataSerialiser ds(saving, stream);
+
+    std::vector<uint32_t> indexTable;
+    indexTable.reserve(numSprites);
+
+    uint32_t numSavedSprites = 0;
+
+    if (saving)
     {
-        uint32_t size = sizeof(T);
-        ds << size;
-        if (ds.IsLoading())
+        for (EntityId::UnderlyingType i = 0; i < numSprites; i++)
         {
-            return size == sizeof(T);
+            auto entity = getEntity(EntityId::FromUnderlying(i));
+            if (entity == nullptr || entity->base.Type == EntityType::Null)
+                continue;
+            indexTable.push_back(static_cast<uint32_t>(i));
         }
-        return true;
+        numSavedSprites = static_cast<uint32_t>(indexTable.size());
     }
-    template<typename... T> bool EntitiesSizeCheck(DataSerialiser& ds)
+
+    if (!SerialiseSpritesHeader(ds))
     {
-        return (EntitySizeCheck<T>(ds) && ...);
+        LOG_ERROR("Entity index corrupted!");
+        return;
     }
+    ds << numSavedSprites;
 
-    // Must pass a function that can access the sprite.
-    void SerialiseSprites(std::function<EntitySnapshot*(const EntityId)> getEntity, const size_t numSprites, bool saving)
+    if (loading)
     {
-        const bool loading = !saving;
-
-        storedSprites.SetPosition(0);
-        DataSerialiser ds(saving, storedSprites);
-
-        std::vector<uint32_t> indexTable;
-        indexTable.reserve(numSprites);
-
-        uint32_t numSavedSprites = 0;
+        indexTable.resize(numSavedSprites);
+    }
 
-        if (saving)
-        {
-            for (EntityId::UnderlyingType i = 0; i < numSprites; i++)
-            {
-                auto entity = getEntity(EntityId::FromUnderlying(i));
-                if (entity == nullptr || entity->base.Type == EntityType::Null)
-                    continue;
-                indexTable.push_back(static_cast<uint32_t>(i));
-            }
-            numSavedSprites = static_cast<uint32_t>(indexTable.size());
-        }
+    for (uint32_t i = 0; i < numSavedSprites; i++)
+    {
+        ds << indexTable[i];
 
-        // Encodes and checks the size of each of the entity so that we
-        // can fail gracefully when fields added/removed
-        if (!EntitiesSizeCheck<Vehicle, Guest, Staff, Litter, MoneyEffect, Balloon, Duck, JumpingFountain, SteamParticle>(ds))
+        const EntityId spriteIdx = EntityId::FromUnderlying(indexTable[i]);
+        EntitySnapshot* entity = getEntity(spriteIdx);
+        if (entity == nullptr)
         {
             LOG_ERROR("Entity index corrupted!");
             return;
         }
-        ds << numSavedSprites;
+        SerialiseSprite(*entity, ds);
+    }
+}
 
-        if (loading)
-        {
-            indexTable.resize(numSavedSprites);
-        }
+static uint64_t HashSpriteData(const void* data, size_t length)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x00000100000001B3ULL;
+    }
+    // Zero is reserved for entities that do not exist.
+    return hash != 0 ? hash : 1;
+}
 
-        for (uint32_t i = 0; i < numSavedSprites; i++)
-        {
-            ds << indexTable[i];
+// Hash of the whole memory of the entity. Much cheaper than serialising it, so unchanged entities can be skipped.
+static uint64_t HashSpriteMemory(const EntitySnapshot& sprite)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t offset = 0; offset < sizeof(sprite.Pad00); offset += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, sprite.Pad00 + offset, sizeof(word));
+        hash = (hash ^ word) * 0x00000100000001B3ULL;
+    }
+    return hash;
+}
 
-            const EntityId spriteIdx = EntityId::FromUnderlying(indexTable[i]);
-            EntitySnapshot* entity = getEntity(spriteIdx);
-            if (entity == nullptr)
-            {
-                LOG_ERROR("Entity index corrupted!");
-                return;
-            }
-            auto& sprite = *entity;
+/*
+ * Full capture of all entities, shared by every differential snapshot captured after it.
+ */
+struct GameStateKeyframe
+{
+    // Same layout as the stored sprites of a full snapshot.
+    OpenRCT2::MemoryStream storedSprites;
+    // Hash of the serialised data of each entity, zero if the entity does not exist.
+    std::vector<uint64_t> spriteHashes;
+    // Hash of the memory of each entity, an entity whose memory is unchanged is not serialised again.
+    std::vector<uint64_t> memoryHashes;
+    OpenRCT2::MemoryStats::TrackedSize trackedSize{ OpenRCT2::MemoryStats::Subsystem::Snapshots };
+};
 
-            ds << sprite.base.Type;
+struct GameStateSnapshot_t
+{
+    GameStateSnapshot_t& operator=(GameStateSnapshot_t&& mv) noexcept
+    {
+        tick = mv.tick;
+        storedSprites = std::move(mv.storedSprites);
+        keyframe = std::move(mv.keyframe);
+        trackedSize = std::move(mv.trackedSize);
+        return *this;
+    }
 
-            switch (sprite.base.Type)
-            {
-                case EntityType::Vehicle:
-                    reinterpret_cast<Vehicle&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Guest:
-                    reinterpret_cast<Guest&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Staff:
-                    reinterpret_cast<Staff&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Litter:
-                    reinterpret_cast<Litter&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::MoneyEffect:
-                    reinterpret_cast<MoneyEffect&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Balloon:
-                    reinterpret_cast<Balloon&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Duck:
-                    reinterpret_cast<Duck&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::JumpingFountain:
-                    reinterpret_cast<JumpingFountain&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::SteamParticle:
-                    reinterpret_cast<SteamParticle&>(sprite).Serialise(ds);
-                    break;
-                case EntityType::Null:
-                    break;
-                default:
-                    break;
-            }
-        }
+    void UpdateTrackedSize()
+    {
+        trackedSize.Set(sizeof(*this) + storedSprites.GetLength() + parkParameters.GetLength());
     }
+
+    uint32_t tick = InvalidTick;
+    uint32_t srand0 = 0;
+
+    // When keyframe is set this only contains the entities that changed since the keyframe, a removed
+    // entity is stored as EntityType::Null. Otherwise it contains all entities.
+    OpenRCT2::MemoryStream storedSprites;
+    OpenRCT2::MemoryStream parkParameters;
+    std::shared_ptr<GameStateKeyframe> keyframe;
+    OpenRCT2::MemoryStats::TrackedSize trackedSize{ OpenRCT2::MemoryStats::Subsystem::Snapshots };
 };
 
 struct GameStateSnapshots final : public IGameStateSnapshots
@@ -165,6 +233,8 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     virtual void Reset() override final
     {
         _snapshots.clear();
+        _keyframe.reset();
+        _capturesSinceKeyframe = 0;
     }
 
     virtual GameStateSnapshot_t& CreateSnapshot() override final
@@ -183,8 +253,13 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
-        snapshot.SerialiseSprites(
-            [](const EntityId index) { return reinterpret_cast<EntitySnapshot*>(GetEntity(index)); }, MAX_ENTITIES, true);
+        if (_keyframe == nullptr || _capturesSinceKeyframe >= SnapshotKeyframeInterval || !CaptureDelta(snapshot))
+        {
+            CaptureKeyframe();
+            CaptureDelta(snapshot);
+        }
+        _capturesSinceKeyframe++;
+        snapshot.UpdateTrackedSize();
 
         // LOG_INFO("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.storedSprites.GetLength()));
     }
@@ -203,8 +278,131 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     {
         ds << snapshot.tick;
         ds << snapshot.srand0;
-        ds << snapshot.storedSprites;
+        if (ds.IsSaving() && snapshot.keyframe != nullptr)
+        {
+            // Differential snapshots are always sent and stored in full.
+            auto spriteList = BuildSpriteList(snapshot);
+            OpenRCT2::MemoryStream storedSprites;
+            SerialiseSprites(
+                storedSprites, [&spriteList](const EntityId index) { return &spriteList[index.ToUnderlying()]; },
+                MAX_ENTITIES, true);
+            ds << storedSprites;
+        }
+        else
+        {
+            ds << snapshot.storedSprites;
+            snapshot.keyframe.reset();
+        }
         ds << snapshot.parkParameters;
+        snapshot.UpdateTrackedSize();
+    }
+
+    /*
+     * Serialises the entity into the scratch buffer, the data can be used until the next call.
+     */
+    const OpenRCT2::MemoryStream& SerialiseToScratch(EntitySnapshot& sprite)
+    {
+        _scratch.SetPosition(0);
+        DataSerialiser ds(true, _scratch);
+        SerialiseSprite(sprite, ds);
+        return _scratch;
+    }
+
+    void CaptureKeyframe()
+    {
+        auto keyframe = std::make_shared<GameStateKeyframe>();
+        keyframe->spriteHashes.resize(MAX_ENTITIES);
+        keyframe->memoryHashes.resize(MAX_ENTITIES);
+
+        uint32_t numSprites = 0;
+        for (EntityId::UnderlyingType i = 0; i < MAX_ENTITIES; i++)
+        {
+            const auto* entity = GetEntity(EntityId::FromUnderlying(i));
+            if (entity != nullptr && entity->Type != EntityType::Null)
+                numSprites++;
+        }
+
+        DataSerialiser ds(true, keyframe->storedSprites);
+        SerialiseSpritesHeader(ds);
+        ds << numSprites;
+
+        for (EntityId::UnderlyingType i = 0; i < MAX_ENTITIES; i++)
+        {
+            auto* entity = reinterpret_cast<EntitySnapshot*>(GetEntity(EntityId::FromUnderlying(i)));
+            if (entity == nullptr || entity->base.Type == EntityType::Null)
+                continue;
+
+            uint32_t index = i;
+            ds << index;
+
+            const auto& data = SerialiseToScratch(*entity);
+            const auto length = static_cast<size_t>(data.GetPosition());
+            keyframe->storedSprites.Write(data.GetData(), length);
+            keyframe->spriteHashes[i] = HashSpriteData(data.GetData(), length);
+            keyframe->memoryHashes[i] = HashSpriteMemory(*entity);
+        }
+
+        keyframe->trackedSize.Set(
+            sizeof(GameStateKeyframe) + keyframe->storedSprites.GetLength()
+            + (keyframe->spriteHashes.size() + keyframe->memoryHashes.size()) * sizeof(uint64_t));
+        _keyframe = std::move(keyframe);
+        _capturesSinceKeyframe = 0;
+    }
+
+    /*
+     * Stores the entities that differ from the current keyframe, returns false if the difference has grown too
+     * large for a differential snapshot to be worth it.
+     */
+    bool CaptureDelta(GameStateSnapshot_t& snapshot)
+    {
+        const auto maxLength = _keyframe->storedSprites.GetLength() / 2;
+
+        auto& stream = snapshot.storedSprites;
+        stream.SetPosition(0);
+        DataSerialiser ds(true, stream);
+
+        uint32_t numChanged = 0;
+        ds << numChanged;
+
+        for (EntityId::UnderlyingType i = 0; i < MAX_ENTITIES; i++)
+        {
+            auto* entity = reinterpret_cast<EntitySnapshot*>(GetEntity(EntityId::FromUnderlying(i)));
+            const auto keyframeHash = _keyframe->spriteHashes[i];
+            uint32_t index = i;
+
+            if (entity == nullptr || entity->base.Type == EntityType::Null)
+            {
+                if (keyframeHash != 0)
+                {
+                    ds << index;
+                    ds << EntityType::Null;
+                    numChanged++;
+                }
+                continue;
+            }
+
+            if (keyframeHash != 0 && HashSpriteMemory(*entity) == _keyframe->memoryHashes[i])
+                continue;
+
+            // The memory may differ in fields that are not serialised, only store the entity if its data changed.
+            const auto& data = SerialiseToScratch(*entity);
+            const auto length = static_cast<size_t>(data.GetPosition());
+            if (HashSpriteData(data.GetData(), length) == keyframeHash)
+                continue;
+
+            ds << index;
+            stream.Write(data.GetData(), length);
+            numChanged++;
+
+            if (stream.GetPosition() > maxLength)
+                return false;
+        }
+
+        stream.SetPosition(0);
+        ds << numChanged;
+
+        snapshot.keyframe = _keyframe;
+        return true;
     }
 
     std::vector<EntitySnapshot> BuildSpriteList(GameStateSnapshot_t& snapshot) const
@@ -218,8 +416,34 @@ struct GameStateSnapshots final : public IGameStateSnapshots
             sprite.base.Type = EntityType::Null;
         }
 
-        snapshot.SerialiseSprites(
-            [&spriteList](const EntityId index) { return &spriteList[index.ToUnderlying()]; }, MAX_ENTITIES, false);
+        auto getSprite = [&spriteList](const EntityId index) { return &spriteList[index.ToUnderlying()]; };
+        if (snapshot.keyframe == nullptr)
+        {
+            SerialiseSprites(snapshot.storedSprites, getSprite, MAX_ENTITIES, false);
+            return spriteList;
+        }
+
+        SerialiseSprites(snapshot.keyframe->storedSprites, getSprite, MAX_ENTITIES, false);
+
+        snapshot.storedSprites.SetPosition(0);
+        DataSerialiser ds(false, snapshot.storedSprites);
+
+        uint32_t numChanged = 0;
+        ds << numChanged;
+        for (uint32_t i = 0; i < numChanged; i++)
+        {
+            uint32_t index = 0;
+            ds << index;
+            if (index >= spriteList.size())
+            {
+                LOG_ERROR("Entity index corrupted!");
+                break;
+            }
+
+            auto& sprite = spriteList[index];
+            sprite = EntitySnapshot();
+            SerialiseSprite(sprite, ds);
+        }
 
         return spriteList;
     }
@@ -787,6 +1011,9 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
 private:
     CircularBuffer<std::unique_ptr<GameStateSnapshot_t>, MaximumGameStateSnapshots> _snapshots;
+    std::shared_ptr<GameStateKeyframe> _keyframe;
+    uint32_t _capturesSinceKeyframe = 0;
+    OpenRCT2::MemoryStream _scratch;
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots()
@@ -80,7 +80,8 @@ struct IGameStateSnapshots
     virtual void LinkSnapshot(GameStateSnapshot_t& snapshot, uint32_t tick, uint32_t srand0) = 0;
 
     /*
-     * This will fill the snapshot with the current game state in a compact form.
+     * This will fill the snapshot with the current game state in a compact form. Consecutive captures share a
+     * keyframe and only store the entities that changed since then.
      */
     virtual void Capture(GameStateSnapshot_t& snapshot) = 0;
 
@@ -131,6 +131,7 @@ private:
             case PATHID::CACHE_OBJECTS:
             case PATHID::CACHE_TRACKS:
             case PATHID::CACHE_SCENARIOS:
+            case PATHID::CACHE_OBJECTS_SHARED:
                 return DIRBASE::CACHE;
             case PATHID::SCORES_RCT2:
                 return DIRBASE::RCT2;
@@ -279,6 +280,7 @@ const u8string PlatformEnvironment::FileNames[] = {
     u8"objects.idx",                             // CACHE_OBJECTS
     u8"tracks.idx",                              // CACHE_TRACKS
     u8"scenarios.idx",                           // CACHE_SCENARIOS
+    u8"objects.cache",                           // CACHE_OBJECTS_SHARED
     u8"groups.json",                             // NETWORK_GROUPS
     u8"servers.cfg",                             // NETWORK_SERVERS
     u8"users.json",                              // NETWORK_USERS
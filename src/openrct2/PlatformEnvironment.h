@@ -62,6 +62,7 @@ namespace OpenRCT2
         CACHE_OBJECTS,           // Object repository cache (objects.idx).
         CACHE_TRACKS,            // Track repository cache (tracks.idx).
         CACHE_SCENARIOS,         // Scenario repository cache (scenarios.idx).
+        CACHE_OBJECTS_SHARED,    // Object definitions shared by instances without graphics (objects.cache).
         NETWORK_GROUPS,          // Server groups with permissions (groups.json).
         NETWORK_SERVERS,         // Saved servers (servers.cfg).
         NETWORK_USERS,           // Users and their groups (users.json).
@@ -11,6 +11,7 @@
 
 #include "Context.h"
 #include "Game.h"
+#include "GameState.h"
 #include "GameStateSnapshots.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
@@ -24,6 +25,9 @@
 #include "actions/TrackPlaceAction.h"
 #include "config/Config.h"
 #include "core/DataSerialiser.h"
+#include "core/File.h"
+#include "core/FileStream.h"
+#include "core/Memory.hpp"
 #include "core/Path.hpp"
 #include "entity/EntityRegistry.h"
 #include "entity/EntityTweener.h"
@@ -35,7 +39,9 @@
 #include "world/Park.h"
 #include "zlib.h"
 
+#include <algorithm>
 #include <chrono>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -78,6 +84,31 @@ namespace OpenRCT2
         OpenRCT2::MemoryStream data;
     };
 
+    enum class ReplayBlockType : uint8_t
+    {
+        Keyframe, // Park, park parameters, cheats and a game state snapshot to restart playback from.
+        Events,   // Commands and checksums recorded since the previous block.
+        End,      // Last tick and final game state snapshot.
+        Index,    // Table of all previous blocks, followed by the file footer.
+    };
+
+    struct ReplayBlockIndexEntry
+    {
+        ReplayBlockType type;
+        uint32_t tick;
+        uint32_t commandIndex; // For keyframes, the first command not yet applied to the saved park.
+        uint64_t offset;
+    };
+
+    struct ReplayCompressedBlock
+    {
+        ReplayBlockType type;
+        uint32_t tick;
+        uint32_t commandIndex;
+        uint32_t uncompressedSize;
+        std::vector<uint8_t> data;
+    };
+
     struct ReplayRecordData
     {
         uint32_t magic;
@@ -95,13 +126,26 @@ namespace OpenRCT2
         std::vector<std::pair<uint32_t, EntitiesChecksum>> checksums;
         uint32_t checksumIndex;
         OpenRCT2::MemoryStream gameStateSnapshots;
+
+        // Streamed recordings (version 11+).
+        std::unique_ptr<OpenRCT2::IStream> outputStream;
+        std::vector<ReplayBlockIndexEntry> blocks;
+        uint32_t numCommands;      // Commands already flushed to the file.
+        uint32_t numChecksums;     // Checksums already flushed to the file.
+        uint32_t nextFlushTick;    // Tick at which pending commands and checksums are written out.
+        uint32_t nextKeyframeTick; // Tick at which the next keyframe is written out.
+        std::future<ReplayCompressedBlock> pendingKeyframe; // Keyframe still being compressed on a worker thread.
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 10;
-        static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
-        static constexpr int ReplayCompressionLevel = 9;
+        static constexpr uint16_t ReplayVersion = 11;
+        static constexpr uint16_t ReplayMonolithicVersion = 10; // Last version written as a single compressed body.
+        static constexpr uint32_t ReplayMagic = 0x5243524F;      // ORCR.
+        static constexpr uint32_t ReplayIndexMagic = 0x58444952; // RIDX.
+        static constexpr int ReplayCompressionLevel = 1;
+        static constexpr uint32_t ReplayFlushTicks = 400;       // ~10 seconds.
+        static constexpr uint32_t ReplayKeyframeTicks = 12000; // ~5 minutes.
         static constexpr int NormalRecordingChecksumTicks = 1;
         static constexpr int SilentRecordingChecksumTicks = 40; // Same as network server
 
@@ -167,6 +211,12 @@ namespace OpenRCT2
                 _nextChecksumTick = gCurrentTicks + ChecksumTicksDelta();
             }
 
+            if (_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION)
+            {
+                if (!UpdateRecordingStream())
+                    return;
+            }
+
             if (_mode == ReplayMode::RECORDING)
             {
                 if (gCurrentTicks >= _currentRecording->tickEnd)
@@ -242,24 +292,31 @@ namespace OpenRCT2
                 replayData->tickEnd = k_MaxReplayTicks;
 
             replayData->filePath = name;
-
-            auto context = GetContext();
-            auto& objManager = context->GetObjectManager();
-            auto objects = objManager.GetPackableObjects();
-
-            auto exporter = std::make_unique<ParkFileExporter>();
-            exporter->ExportObjectsList = objects;
-            exporter->Export(replayData->parkData);
-
             replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
+            replayData->nextFlushTick = gCurrentTicks + ReplayFlushTicks;
+            replayData->nextKeyframeTick = gCurrentTicks + ReplayKeyframeTicks;
 
-            DataSerialiser parkParamsDs(true, replayData->parkParams);
-            SerialiseParkParameters(parkParamsDs);
+            // The header and an initial keyframe are written straight away, everything else is appended
+            // as the recording progresses.
+            try
+            {
+                replayData->outputStream = std::make_unique<FileStream>(name, FILE_MODE_WRITE);
 
-            DataSerialiser cheatDataDs(true, replayData->cheatData);
-            SerialiseCheats(cheatDataDs);
+                DataSerialiser headerDs(true, *replayData->outputStream);
+                headerDs << replayData->magic;
+                headerDs << replayData->version;
+                headerDs << replayData->networkId;
+                headerDs << replayData->name;
+                headerDs << replayData->timeRecorded;
+                headerDs << replayData->tickStart;
 
-            TakeGameStateSnapshot(replayData->gameStateSnapshots);
+                BeginKeyframe(*replayData);
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR("Unable to write to file '%s': %s", name.c_str(), ex.what());
+                return false;
+            }
 
             if (_mode != ReplayMode::NORMALISATION)
                 _mode = ReplayMode::RECORDING;
@@ -278,61 +335,37 @@ namespace OpenRCT2
 
             if (discard)
             {
-                _currentRecording.reset();
+                DiscardRecording();
                 _mode = ReplayMode::NONE;
                 return true;
             }
 
-            _currentRecording->tickEnd = gCurrentTicks;
+            auto& recording = *_currentRecording;
+            recording.tickEnd = gCurrentTicks;
 
             {
                 EntitiesChecksum checksum = GetAllEntitiesChecksum();
                 AddChecksum(gCurrentTicks, std::move(checksum));
             }
 
-            TakeGameStateSnapshot(_currentRecording->gameStateSnapshots);
-
-            // Serialise Body.
-            DataSerialiser recSerialiser(true);
-            Serialise(recSerialiser, *_currentRecording);
-
-            const auto& stream = recSerialiser.GetStream();
-            unsigned long streamLength = static_cast<unsigned long>(stream.GetLength());
-            unsigned long compressLength = compressBound(streamLength);
-
-            MemoryStream data(compressLength);
-
-            ReplayRecordFile file{ _currentRecording->magic, _currentRecording->version, streamLength, data };
-
-            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
-            compress2(
-                compressBuf.get(), &compressLength, static_cast<const unsigned char*>(stream.GetData()), stream.GetLength(),
-                ReplayCompressionLevel);
-            file.data.Write(compressBuf.get(), compressLength);
-
-            DataSerialiser fileSerialiser(true);
-            fileSerialiser << file.magic;
-            fileSerialiser << file.version;
-            fileSerialiser << file.uncompressedSize;
-            fileSerialiser << file.data;
-
             bool result = false;
-
-            const std::string& outFile = _currentRecording->filePath;
-
-            FILE* fp = fopen(outFile.c_str(), "wb");
-            if (fp != nullptr)
+            try
             {
-                const auto& fileStream = fileSerialiser.GetStream();
-                fwrite(fileStream.GetData(), 1, fileStream.GetLength(), fp);
-                fclose(fp);
+                FinishKeyframe(recording, true);
+                WriteEvents(recording);
+
+                MemoryStream endPayload;
+                DataSerialiser endDs(true, endPayload);
+                endDs << recording.tickEnd;
+                TakeGameStateSnapshot(endPayload);
+                WriteBlock(recording, ReplayBlockType::End, 0, endPayload);
 
+                WriteIndex(recording);
                 result = true;
             }
-            else
+            catch (const std::exception& ex)
             {
-                LOG_ERROR("Unable to write to file '%s'", outFile.c_str());
-                result = false;
+                LOG_ERROR("Unable to write to file '%s': %s", recording.filePath.c_str(), ex.what());
             }
 
             // When normalizing the output we don't touch the mode.
@@ -369,14 +402,18 @@ namespace OpenRCT2
                 info.Ticks = gCurrentTicks - data->tickStart;
             else if (_mode == ReplayMode::PLAYING)
                 info.Ticks = data->tickEnd - data->tickStart;
-            info.NumCommands = static_cast<uint32_t>(data->commands.size());
-            info.NumChecksums = static_cast<uint32_t>(data->checksums.size());
+            info.NumCommands = data->numCommands + static_cast<uint32_t>(data->commands.size());
+            info.NumChecksums = data->numChecksums + static_cast<uint32_t>(data->checksums.size());
 
             return true;
         }
 
         void LoadAndCompareSnapshot(MemoryStream& snapshotStream)
         {
+            // Recordings that were never stopped properly have no final snapshot.
+            if (snapshotStream.GetPosition() >= snapshotStream.GetLength())
+                return;
+
             DataSerialiser ds(false, snapshotStream);
 
             IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
@@ -455,6 +492,73 @@ namespace OpenRCT2
             return _faultyChecksumIndex != -1;
         }
 
+        virtual bool SeekPlayback(uint32_t replayTick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            auto& data = *_currentReplay;
+            if (data.version <= ReplayMonolithicVersion)
+            {
+                LOG_ERROR("Replay version %u does not support seeking.", data.version);
+                return false;
+            }
+
+            const uint32_t targetTick = data.tickStart + std::min(replayTick, data.tickEnd - data.tickStart);
+
+            // Restart from the closest keyframe at or before the target, there is always one at the start.
+            auto keyframe = std::find_if(data.blocks.rbegin(), data.blocks.rend(), [targetTick](const auto& block) {
+                return block.type == ReplayBlockType::Keyframe && block.tick <= targetTick;
+            });
+            if (keyframe == data.blocks.rend())
+                return false;
+
+            MemoryStream snapshot;
+            try
+            {
+                FileStream fs(data.filePath, FILE_MODE_OPEN);
+                ReadKeyframe(fs, *keyframe, data, snapshot);
+
+                data.commands.clear();
+                for (const auto& block : data.blocks)
+                {
+                    if (block.type == ReplayBlockType::Events)
+                        ReadEvents(fs, block, data, keyframe->commandIndex, false);
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR("Unable to read replay keyframe: %s", ex.what());
+                return false;
+            }
+
+            if (!LoadReplayDataMap(data))
+            {
+                LOG_ERROR("Unable to load map.");
+                StopPlayback();
+                return false;
+            }
+
+            gCurrentTicks = keyframe->tick;
+            LoadAndCompareSnapshot(snapshot);
+
+            auto checksum = std::lower_bound(
+                data.checksums.begin(), data.checksums.end(), gCurrentTicks,
+                [](const auto& entry, uint32_t tick) { return entry.first < tick; });
+            data.checksumIndex = static_cast<uint32_t>(std::distance(data.checksums.begin(), checksum));
+            _faultyChecksumIndex = -1;
+            gGamePaused = 0;
+
+            // Fast forward to the requested tick, playback stops by itself when the end is reached.
+            auto* gameState = GetContext()->GetGameState();
+            while (_mode == ReplayMode::PLAYING && gCurrentTicks < targetTick)
+            {
+                gameState->UpdateLogic();
+            }
+
+            return true;
+        }
+
         virtual bool StopPlayback() override
         {
             if (_mode != ReplayMode::PLAYING && _mode != ReplayMode::NORMALISATION)
@@ -501,6 +605,392 @@ namespace OpenRCT2
         }
 
     private:
+        void DiscardRecording()
+        {
+            // Closes the stream before removing the partial file.
+            const auto filePath = _currentRecording->filePath;
+            _currentRecording.reset();
+            File::Delete(filePath);
+        }
+
+        bool UpdateRecordingStream()
+        {
+            auto& recording = *_currentRecording;
+            try
+            {
+                FinishKeyframe(recording, false);
+
+                // Events are held back while a keyframe is pending so that blocks stay in tick order.
+                if (gCurrentTicks >= recording.nextFlushTick && !recording.pendingKeyframe.valid())
+                {
+                    WriteEvents(recording);
+                    recording.nextFlushTick = gCurrentTicks + ReplayFlushTicks;
+                }
+                if (gCurrentTicks >= recording.nextKeyframeTick)
+                {
+                    FinishKeyframe(recording, true);
+                    WriteEvents(recording);
+                    BeginKeyframe(recording);
+                    recording.nextKeyframeTick = gCurrentTicks + ReplayKeyframeTicks;
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR("Unable to write to file '%s': %s", recording.filePath.c_str(), ex.what());
+                DiscardRecording();
+                if (_mode == ReplayMode::RECORDING)
+                    _mode = ReplayMode::NONE;
+                return false;
+            }
+            return true;
+        }
+
+        static ReplayCompressedBlock CompressBlock(
+            ReplayBlockType type, uint32_t tick, uint32_t commandIndex, const MemoryStream& payload)
+        {
+            ReplayCompressedBlock block{ type, tick, commandIndex, static_cast<uint32_t>(payload.GetLength()), {} };
+
+            unsigned long compressedSize = compressBound(block.uncompressedSize);
+            block.data.resize(compressedSize);
+            if (compress2(
+                    block.data.data(), &compressedSize, static_cast<const unsigned char*>(payload.GetData()),
+                    block.uncompressedSize, ReplayCompressionLevel)
+                != Z_OK)
+            {
+                throw IOException("Unable to compress replay block.");
+            }
+            block.data.resize(compressedSize);
+            return block;
+        }
+
+        static void WriteCompressedBlock(ReplayRecordData& data, const ReplayCompressedBlock& block)
+        {
+            auto& stream = *data.outputStream;
+
+            ReplayBlockIndexEntry entry{ block.type, block.tick, block.commandIndex, stream.GetPosition() };
+
+            DataSerialiser ds(true, stream);
+            ds << entry.type;
+            ds << entry.tick;
+            ds << entry.commandIndex;
+            ds << block.uncompressedSize;
+            ds << static_cast<uint32_t>(block.data.size());
+            stream.Write(block.data.data(), block.data.size());
+
+            data.blocks.push_back(entry);
+        }
+
+        void WriteBlock(ReplayRecordData& data, ReplayBlockType type, uint32_t commandIndex, const MemoryStream& payload)
+        {
+            WriteCompressedBlock(data, CompressBlock(type, gCurrentTicks, commandIndex, payload));
+        }
+
+        // Only the game state is read here, compressing the park and the keyframe is left to a worker thread as
+        // that takes long enough on large parks to cause a visible hitch. See FinishKeyframe.
+        void BeginKeyframe(ReplayRecordData& data)
+        {
+            auto& objManager = GetContext()->GetObjectManager();
+
+            ParkFileExporter exporter;
+            exporter.ExportObjectsList = objManager.GetPackableObjects();
+            auto writeParkData = exporter.ExportDeferred();
+
+            MemoryStream parkParams;
+            DataSerialiser parkParamsDs(true, parkParams);
+            SerialiseParkParameters(parkParamsDs);
+
+            MemoryStream cheatData;
+            DataSerialiser cheatDataDs(true, cheatData);
+            SerialiseCheats(cheatDataDs);
+
+            MemoryStream snapshot;
+            TakeGameStateSnapshot(snapshot);
+
+            // Commands already recorded are part of the saved park and must not be replayed on top of it.
+            data.pendingKeyframe = std::async(
+                std::launch::async,
+                [writeParkData = std::move(writeParkData), parkParams = std::move(parkParams),
+                 cheatData = std::move(cheatData), snapshot = std::move(snapshot), tick = gCurrentTicks,
+                 commandIndex = _commandId]() mutable {
+                    MemoryStream parkData;
+                    writeParkData(parkData);
+
+                    MemoryStream payload;
+                    DataSerialiser ds(true, payload);
+                    ds << parkData;
+                    ds << parkParams;
+                    ds << cheatData;
+                    ds << snapshot;
+                    return CompressBlock(ReplayBlockType::Keyframe, tick, commandIndex, payload);
+                });
+        }
+
+        // Writes out the keyframe started by BeginKeyframe once it is ready, rethrows any error from the worker thread.
+        static void FinishKeyframe(ReplayRecordData& data, bool wait)
+        {
+            if (!data.pendingKeyframe.valid())
+                return;
+            if (!wait && data.pendingKeyframe.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return;
+
+            WriteCompressedBlock(data, data.pendingKeyframe.get());
+        }
+
+        void WriteEvents(ReplayRecordData& data)
+        {
+            if (data.commands.empty() && data.checksums.empty())
+                return;
+
+            MemoryStream payload;
+            DataSerialiser ds(true, payload);
+
+            uint32_t countCommands = static_cast<uint32_t>(data.commands.size());
+            ds << countCommands;
+            for (auto& command : data.commands)
+            {
+                SerialiseCommand(ds, const_cast<ReplayCommand&>(command));
+            }
+
+            uint32_t countChecksums = static_cast<uint32_t>(data.checksums.size());
+            ds << countChecksums;
+            for (auto& checksum : data.checksums)
+            {
+                ds << checksum.first;
+                ds << checksum.second.raw;
+            }
+
+            WriteBlock(data, ReplayBlockType::Events, 0, payload);
+
+            data.numCommands += countCommands;
+            data.numChecksums += countChecksums;
+            data.commands.clear();
+            data.checksums.clear();
+        }
+
+        void WriteIndex(ReplayRecordData& data)
+        {
+            MemoryStream payload;
+            DataSerialiser ds(true, payload);
+
+            uint32_t count = static_cast<uint32_t>(data.blocks.size());
+            ds << count;
+            for (const auto& block : data.blocks)
+            {
+                ds << block.type;
+                ds << block.tick;
+                ds << block.commandIndex;
+                ds << block.offset;
+            }
+
+            WriteBlock(data, ReplayBlockType::Index, 0, payload);
+
+            // Fixed size footer so readers can find the index without scanning every block.
+            DataSerialiser footerDs(true, *data.outputStream);
+            footerDs << data.blocks.back().offset;
+            footerDs << ReplayIndexMagic;
+        }
+
+        static void ReadBlockHeader(
+            IStream& stream, ReplayBlockIndexEntry& entry, uint32_t& uncompressedSize, uint32_t& compressedSize)
+        {
+            entry.offset = stream.GetPosition();
+
+            DataSerialiser ds(false, stream);
+            ds << entry.type;
+            ds << entry.tick;
+            ds << entry.commandIndex;
+            ds << uncompressedSize;
+            ds << compressedSize;
+        }
+
+        static MemoryStream ReadBlock(IStream& stream, const ReplayBlockIndexEntry& block)
+        {
+            stream.SetPosition(block.offset);
+
+            ReplayBlockIndexEntry entry{};
+            uint32_t uncompressedSize = 0;
+            uint32_t compressedSize = 0;
+            ReadBlockHeader(stream, entry, uncompressedSize, compressedSize);
+            if (entry.type != block.type)
+                throw IOException("Replay block type mismatch.");
+
+            auto compressed = stream.ReadArray<uint8_t>(compressedSize);
+
+            auto* payload = Memory::Allocate<uint8_t>(uncompressedSize);
+            unsigned long outSize = uncompressedSize;
+            if (uncompress(payload, &outSize, compressed.get(), compressedSize) != Z_OK || outSize != uncompressedSize)
+            {
+                Memory::Free(payload);
+                throw IOException("Unable to decompress replay block.");
+            }
+            return MemoryStream(payload, uncompressedSize, MEMORY_ACCESS::READ | MEMORY_ACCESS::OWNER);
+        }
+
+        static bool ReadBlockIndex(IStream& stream, uint64_t headerEnd, std::vector<ReplayBlockIndexEntry>& blocks)
+        {
+            constexpr uint64_t footerSize = sizeof(uint64_t) + sizeof(uint32_t);
+            const auto length = stream.GetLength();
+            if (length < headerEnd + footerSize)
+                return false;
+
+            try
+            {
+                stream.SetPosition(length - footerSize);
+
+                uint64_t indexOffset = 0;
+                uint32_t magic = 0;
+                DataSerialiser footerDs(false, stream);
+                footerDs << indexOffset;
+                footerDs << magic;
+                if (magic != ReplayIndexMagic)
+                    return false;
+
+                auto payload = ReadBlock(stream, { ReplayBlockType::Index, 0, 0, indexOffset });
+                DataSerialiser ds(false, payload);
+
+                uint32_t count = 0;
+                ds << count;
+                blocks.resize(count);
+                for (auto& block : blocks)
+                {
+                    ds << block.type;
+                    ds << block.tick;
+                    ds << block.commandIndex;
+                    ds << block.offset;
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_WARNING("Replay index could not be read: %s", ex.what());
+                blocks.clear();
+                return false;
+            }
+            return true;
+        }
+
+        static void ScanBlocks(IStream& stream, uint64_t headerEnd, std::vector<ReplayBlockIndexEntry>& blocks)
+        {
+            // Without an index (e.g. the game quit while recording) walk the blocks one by one and keep
+            // every block that was written completely.
+            stream.SetPosition(headerEnd);
+            const auto length = stream.GetLength();
+            try
+            {
+                while (stream.GetPosition() < length)
+                {
+                    ReplayBlockIndexEntry entry{};
+                    uint32_t uncompressedSize = 0;
+                    uint32_t compressedSize = 0;
+                    ReadBlockHeader(stream, entry, uncompressedSize, compressedSize);
+                    if (entry.type == ReplayBlockType::Index || stream.GetPosition() + compressedSize > length)
+                        break;
+
+                    stream.Seek(compressedSize, STREAM_SEEK_CURRENT);
+                    blocks.push_back(entry);
+                }
+            }
+            catch (const std::exception&)
+            {
+                // Truncated block header.
+            }
+        }
+
+        void ReadKeyframe(IStream& stream, const ReplayBlockIndexEntry& block, ReplayRecordData& data, MemoryStream& snapshot)
+        {
+            auto payload = ReadBlock(stream, block);
+            DataSerialiser ds(false, payload);
+            data.parkData = MemoryStream();
+            data.parkParams = MemoryStream();
+            data.cheatData = MemoryStream();
+            ds << data.parkData;
+            ds << data.parkParams;
+            ds << data.cheatData;
+            ds << snapshot;
+
+            data.parkData.SetPosition(0);
+            data.parkParams.SetPosition(0);
+            data.cheatData.SetPosition(0);
+            snapshot.SetPosition(0);
+        }
+
+        void ReadEvents(
+            IStream& stream, const ReplayBlockIndexEntry& block, ReplayRecordData& data, uint32_t firstCommandIndex,
+            bool readChecksums)
+        {
+            auto payload = ReadBlock(stream, block);
+            DataSerialiser ds(false, payload);
+
+            uint32_t countCommands = 0;
+            ds << countCommands;
+            for (uint32_t i = 0; i < countCommands; i++)
+            {
+                ReplayCommand command = {};
+                SerialiseCommand(ds, command);
+                if (command.commandIndex >= firstCommandIndex)
+                    data.commands.emplace(std::move(command));
+            }
+
+            if (!readChecksums)
+                return;
+
+            uint32_t countChecksums = 0;
+            ds << countChecksums;
+            for (uint32_t i = 0; i < countChecksums; i++)
+            {
+                auto& checksum = data.checksums.emplace_back();
+                ds << checksum.first;
+                ds << checksum.second.raw;
+            }
+        }
+
+        bool ReadStreamedReplay(IStream& stream, ReplayRecordData& data)
+        {
+            DataSerialiser ds(false, stream);
+            ds << data.networkId;
+            ds << data.name;
+            ds << data.timeRecorded;
+            ds << data.tickStart;
+            CheckNetworkVersion(data);
+
+            const auto headerEnd = stream.GetPosition();
+            if (!ReadBlockIndex(stream, headerEnd, data.blocks))
+            {
+                LOG_WARNING("Replay has no index, it was probably not stopped properly.");
+                ScanBlocks(stream, headerEnd, data.blocks);
+            }
+
+            if (data.blocks.empty() || data.blocks.front().type != ReplayBlockType::Keyframe)
+            {
+                LOG_ERROR("Replay does not start with a keyframe.");
+                return false;
+            }
+
+            // The park of the first keyframe is loaded right away, later keyframes are only read when seeking.
+            MemoryStream startSnapshot;
+            ReadKeyframe(stream, data.blocks.front(), data, startSnapshot);
+            data.gameStateSnapshots.Write(startSnapshot.GetData(), startSnapshot.GetLength());
+
+            data.tickEnd = data.tickStart;
+            for (const auto& block : data.blocks)
+            {
+                data.tickEnd = std::max(data.tickEnd, block.tick);
+                if (block.type == ReplayBlockType::Events)
+                {
+                    ReadEvents(stream, block, data, 0, true);
+                }
+                else if (block.type == ReplayBlockType::End)
+                {
+                    auto payload = ReadBlock(stream, block);
+                    DataSerialiser endDs(false, payload);
+                    endDs << data.tickEnd;
+                    data.gameStateSnapshots.Write(
+                        static_cast<const uint8_t*>(payload.GetData()) + payload.GetPosition(),
+                        payload.GetLength() - payload.GetPosition());
+                }
+            }
+            return true;
+        }
+
         int ChecksumTicksDelta() const
         {
             switch (_recordType)
@@ -600,8 +1090,6 @@ namespace OpenRCT2
 
         bool ReadReplayData(const std::string& file, ReplayRecordData& data)
         {
-            MemoryStream stream;
-
             std::string fileName = file;
             if (fileName.size() < 5 || fileName.substr(fileName.size() - 5) != ".parkrep")
             {
@@ -611,18 +1099,48 @@ namespace OpenRCT2
             std::string outPath = GetContext()->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::REPLAY);
             std::string outFile = Path::Combine(outPath, fileName);
 
-            bool loaded = false;
-            if (ReadReplayFromFile(outFile, stream))
-            {
+            if (File::Exists(outFile))
                 data.filePath = outFile;
-                loaded = true;
+            else if (File::Exists(file))
+                data.filePath = file;
+            else
+                return false;
+
+            try
+            {
+                FileStream fs(data.filePath, FILE_MODE_OPEN);
+
+                DataSerialiser ds(false, fs);
+                ds << data.magic;
+                ds << data.version;
+                if (data.magic != ReplayMagic)
+                {
+                    LOG_ERROR("Magic does not match %08X, expected: %08X", data.magic, ReplayMagic);
+                    return false;
+                }
+                if (data.version > ReplayMonolithicVersion)
+                {
+                    if (data.version != ReplayVersion)
+                    {
+                        LOG_ERROR("Invalid version detected %04X, expected: %04X", data.version, ReplayVersion);
+                        return false;
+                    }
+                    if (!ReadStreamedReplay(fs, data))
+                        return false;
+
+                    data.gameStateSnapshots.SetPosition(0);
+                    return true;
+                }
             }
-            else if (ReadReplayFromFile(file, stream))
+            catch (const std::exception& ex)
             {
-                data.filePath = file;
-                loaded = true;
+                LOG_ERROR("Unable to read replay '%s': %s", data.filePath.c_str(), ex.what());
+                return false;
             }
-            if (!loaded)
+
+            // Older replays are a single compressed body.
+            MemoryStream stream;
+            if (!ReadReplayFromFile(data.filePath, stream))
                 return false;
 
             if (!TryDecompress(stream))
@@ -704,7 +1222,20 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == ReplayVersion;
+            return data.version == ReplayMonolithicVersion;
+        }
+
+        void CheckNetworkVersion(const ReplayRecordData& data)
+        {
+#ifndef DISABLE_NETWORK
+            // NOTE: This does not mean the replay will not function, only a warning.
+            if (data.networkId != NetworkGetVersion())
+            {
+                LOG_WARNING(
+                    "Replay network version mismatch: '%s', expected: '%s'", data.networkId.c_str(),
+                    NetworkGetVersion().c_str());
+            }
+#endif
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -716,22 +1247,14 @@ namespace OpenRCT2
                 return false;
             }
             serialiser << data.version;
-            if (data.version != ReplayVersion && !Compatible(data))
+            if (!Compatible(data))
             {
-                LOG_ERROR("Invalid version detected %04X, expected: %04X", data.version, ReplayVersion);
+                LOG_ERROR("Invalid version detected %04X, expected: %04X", data.version, ReplayMonolithicVersion);
                 return false;
             }
 
             serialiser << data.networkId;
-#ifndef DISABLE_NETWORK
-            // NOTE: This does not mean the replay will not function, only a warning.
-            if (data.networkId != NetworkGetVersion())
-            {
-                LOG_WARNING(
-                    "Replay network version mismatch: '%s', expected: '%s'", data.networkId.c_str(),
-                    NetworkGetVersion().c_str());
-            }
-#endif
+            CheckNetworkVersion(data);
 
             serialiser << data.name;
             serialiser << data.timeRecorded;
@@ -10,6 +10,7 @@
 #include "GameAction.h"
 
 #include "../Context.h"
+#include "../GameStateHash.h"
 #include "../ReplayManager.h"
 #include "../core/Guard.hpp"
 #include "../core/Memory.hpp"
@@ -365,6 +366,13 @@ namespace GameActions
 
             LogActionFinish(logContext, action, result);
 
+            // Ghosts and client only actions are local to this player and must not affect the state hash.
+            if (result.Error == GameActions::Status::Ok && (flags & GAME_COMMAND_FLAG_GHOST) == 0
+                && !(actionFlags & GameActions::Flags::ClientOnly))
+            {
+                GameStateHash::Get().MarkTileDirty(result.Position);
+            }
+
             // If not top level just give away the result.
             if (!topLevel)
                 return result;
@@ -0,0 +1,943 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../core/Console.hpp"
+#include "../core/FileStream.h"
+#include "../core/FrameArena.h"
+#include "../core/JobPool.h"
+#include "../core/MemoryStream.h"
+#include "../core/OrcaStream.hpp"
+#include "../core/Path.hpp"
+#include "../core/Timer.hpp"
+#include "../drawing/Drawing.h"
+#include "../drawing/SpriteCache.h"
+#include "../drawing/X8DrawingEngine.h"
+#include "../entity/EntityList.h"
+#include "../localisation/Formatter.h"
+#include "../localisation/Formatting.h"
+#include "../localisation/StringIds.h"
+#include "../scenario/Scenario.h"
+#include "../sprites.h"
+#include "../util/Util.h"
+#include "../world/Footpath.h"
+#include "../world/Map.h"
+#include "CommandLine.hpp"
+
+#ifdef ENABLE_SCRIPTING
+#    include "../scripting/ScriptEngine.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace OpenRCT2;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition NoOptions[]
+{
+    OptionTableEnd
+};
+
+static exitcode_t HandleBenchParkCompression(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchFormat(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchDirtyRegions(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchSpriteBlit(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchTileQueries(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchTileSweep(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleBenchMapSweeps(CommandLineArgEnumerator* argEnumerator);
+#ifdef ENABLE_SCRIPTING
+static exitcode_t HandleBenchPluginEntityQuery(CommandLineArgEnumerator* argEnumerator);
+#endif
+
+const CommandLineCommand CommandLine::BenchCommands[]{
+    // Main commands
+    DefineCommand("park-compression", "<park>...", NoOptions, HandleBenchParkCompression),
+    DefineCommand("format", "", NoOptions, HandleBenchFormat),
+    DefineCommand("dirty-regions", "[<pattern>...]", NoOptions, HandleBenchDirtyRegions),
+    DefineCommand("sprite-blit", "", NoOptions, HandleBenchSpriteBlit),
+    DefineCommand("tile-queries", "<park>", NoOptions, HandleBenchTileQueries),
+    DefineCommand("tile-sweep", "<park>", NoOptions, HandleBenchTileSweep),
+    DefineCommand("map-sweeps", "<park>", NoOptions, HandleBenchMapSweeps),
+#ifdef ENABLE_SCRIPTING
+    DefineCommand("plugin-entity-query", "<park>", NoOptions, HandleBenchPluginEntityQuery),
+#endif
+
+    CommandTableEnd
+};
+// clang-format on
+
+static constexpr int32_t BenchIterations = 5;
+
+static exitcode_t HandleBenchParkCompression(CommandLineArgEnumerator* argEnumerator)
+{
+    struct Codec
+    {
+        const char* Name;
+        uint32_t Compression;
+    };
+    static constexpr std::array<Codec, 3> Codecs{ {
+        { "none", OrcaStream::COMPRESSION_NONE },
+        { "gzip", OrcaStream::COMPRESSION_GZIP },
+        { "zlib-blocks", OrcaStream::COMPRESSION_ZLIB_BLOCKS },
+    } };
+
+    const utf8* rawPath;
+    if (!argEnumerator->TryPopString(&rawPath))
+    {
+        Console::Error::WriteLine("Expected one or more park files.");
+        return EXITCODE_FAIL;
+    }
+
+    Console::WriteLine("%-32s %-12s %12s %10s %10s", "park", "codec", "size", "save ms", "load ms");
+    do
+    {
+        auto path = Path::GetAbsolute(rawPath);
+        try
+        {
+            FileStream fs(path, FILE_MODE_OPEN);
+            OrcaStream source(fs, OrcaStream::Mode::READING);
+            auto pendingWrite = source.Detach();
+
+            for (const auto& codec : Codecs)
+            {
+                pendingWrite.SetCompression(codec.Compression);
+
+                MemoryStream encoded;
+                Timer timer;
+                for (int32_t i = 0; i < BenchIterations; i++)
+                {
+                    encoded = MemoryStream();
+                    pendingWrite.WriteTo(encoded);
+                }
+                auto saveTime = timer.GetElapsedTimeAndRestart();
+                for (int32_t i = 0; i < BenchIterations; i++)
+                {
+                    encoded.SetPosition(0);
+                    OrcaStream decoded(encoded, OrcaStream::Mode::READING);
+                }
+                auto loadTime = timer.GetElapsedTime();
+
+                Console::WriteLine(
+                    "%-32s %-12s %12llu %10.2f %10.2f", Path::GetFileName(path).c_str(), codec.Name,
+                    static_cast<unsigned long long>(encoded.GetLength()), saveTime.count() * 1000.0f / BenchIterations,
+                    loadTime.count() * 1000.0f / BenchIterations);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to benchmark %s: %s", path.c_str(), e.what());
+            return EXITCODE_FAIL;
+        }
+    } while (argEnumerator->TryPopString(&rawPath));
+
+    return EXITCODE_OK;
+}
+
+static exitcode_t HandleBenchFormat(CommandLineArgEnumerator* argEnumerator)
+{
+    static constexpr int32_t CallsPerIteration = 100000;
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    struct Case
+    {
+        const char* Name;
+        StringId Format;
+        Formatter Args;
+    };
+    std::array<Case, 6> cases{ {
+        { "cash", STR_BOTTOM_TOOLBAR_CASH, {} },
+        { "park-rating", STR_PARK_RATING_LABEL, {} },
+        { "park-value", STR_PARK_VALUE_LABEL, {} },
+        { "date", STR_DATE_FORMAT_MY, {} },
+        { "string-by-id", STR_STRINGID, {} },
+        { "string", STR_STRING, {} },
+    } };
+    cases[0].Args.Add<money64>(123456789);
+    cases[1].Args.Add<int16_t>(999);
+    cases[2].Args.Add<money64>(-9876543);
+    cases[3].Args.Add<uint16_t>(5);
+    cases[3].Args.Add<uint16_t>(12);
+    cases[4].Args.Add<StringId>(STR_PARK_RATING_LABEL);
+    cases[4].Args.Add<int16_t>(512);
+    cases[5].Args.Add<const char*>("Mr. Bean's Roller Coaster");
+
+    Console::WriteLine("%-16s %10s %12s %32s", "format", "ns/call", "allocs/call", "result");
+    for (const auto& c : cases)
+    {
+        char buffer[256];
+        // The first call builds the format template, which is the only allocation expected for a string id.
+        FormatStringLegacy(buffer, sizeof(buffer), c.Format, c.Args.Data());
+
+        const auto heapAllocations = FrameArena::GetHeapAllocationCount();
+        Timer timer;
+        for (int32_t i = 0; i < BenchIterations * CallsPerIteration; i++)
+        {
+            FormatStringLegacy(buffer, sizeof(buffer), c.Format, c.Args.Data());
+        }
+        const auto calls = static_cast<double>(BenchIterations) * CallsPerIteration;
+        const auto elapsedNs = timer.GetElapsedTime().count() * 1e9;
+        const auto allocations = FrameArena::GetHeapAllocationCount() - heapAllocations;
+        if constexpr (FrameArena::CountsHeapAllocations)
+        {
+            Console::WriteLine("%-16s %10.1f %12.3f %32s", c.Name, elapsedNs / calls, allocations / calls, buffer);
+        }
+        else
+        {
+            // Heap allocations are only counted in builds with ENABLE_ALLOCATION_COUNTING.
+            Console::WriteLine("%-16s %10.1f %12s %32s", c.Name, elapsedNs / calls, "-", buffer);
+        }
+    }
+
+    return EXITCODE_OK;
+}
+
+namespace
+{
+    struct InvalidatedRect
+    {
+        int32_t Left;
+        int32_t Top;
+        int32_t Right;
+        int32_t Bottom;
+    };
+
+    struct InvalidationPattern
+    {
+        std::string Name;
+        std::vector<std::vector<InvalidatedRect>> Frames;
+    };
+} // namespace
+
+// Same screen size and block size as a 1080p window drawn by X8DrawingEngine.
+static constexpr int32_t DirtyScreenWidth = 1920;
+static constexpr int32_t DirtyScreenHeight = 1080;
+static constexpr uint32_t DirtyBlockShiftX = 7;
+static constexpr uint32_t DirtyBlockShiftY = 5;
+
+static std::vector<InvalidationPattern> GetBuiltInInvalidationPatterns()
+{
+    std::vector<InvalidationPattern> patterns;
+
+    patterns.push_back({ "full-screen", { { { 0, 0, DirtyScreenWidth, DirtyScreenHeight } } } });
+
+    auto& drag = patterns.emplace_back(InvalidationPattern{ "window-drag", {} });
+    for (int32_t i = 0; i < 60; i++)
+    {
+        const int32_t x = 100 + i * 10, y = 100 + i * 6;
+        drag.Frames.push_back({ { x - 10, y - 6, x + 390, y + 294 }, { x, y, x + 400, y + 300 } });
+    }
+
+    auto& panels = patterns.emplace_back(InvalidationPattern{ "ui-panels", {} });
+    for (int32_t i = 0; i < 60; i++)
+    {
+        panels.Frames.push_back({
+            { 0, 0, DirtyScreenWidth, 28 },
+            { 0, DirtyScreenHeight - 70, DirtyScreenWidth, DirtyScreenHeight },
+            { 1200, 200, 1800, 600 },
+            { 300 + i, 400, 340 + i, 420 },
+        });
+    }
+
+    // Pseudo-random but fixed so runs can be compared.
+    auto& sprites = patterns.emplace_back(InvalidationPattern{ "scattered-sprites", {} });
+    uint32_t seed = 12345;
+    for (int32_t i = 0; i < 60; i++)
+    {
+        auto& frame = sprites.Frames.emplace_back();
+        for (int32_t j = 0; j < 200; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            const int32_t x = (seed >> 8) % DirtyScreenWidth;
+            seed = seed * 1103515245 + 12345;
+            const int32_t y = (seed >> 8) % DirtyScreenHeight;
+            frame.push_back({ x, y, x + 24, y + 32 });
+        }
+    }
+    return patterns;
+}
+
+// A pattern file has one "left top right bottom" rectangle per line, with an empty line between frames.
+static bool TryReadInvalidationPattern(const std::string& path, InvalidationPattern& pattern)
+{
+    std::ifstream in(path);
+    if (!in.is_open())
+        return false;
+
+    pattern.Name = Path::GetFileName(path);
+    pattern.Frames.emplace_back();
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (!line.empty() && line[0] == '#')
+            continue;
+
+        InvalidatedRect rect{};
+        std::istringstream lineStream(line);
+        if (lineStream >> rect.Left >> rect.Top >> rect.Right >> rect.Bottom)
+        {
+            pattern.Frames.back().push_back(rect);
+        }
+        else if (!pattern.Frames.back().empty())
+        {
+            pattern.Frames.emplace_back();
+        }
+    }
+    return true;
+}
+
+// Marks blocks the same way as X8DrawingEngine::Invalidate.
+static void InvalidateDirtyGrid(Drawing::DirtyGrid& grid, const InvalidatedRect& rect)
+{
+    const auto left = std::max(rect.Left, 0);
+    const auto top = std::max(rect.Top, 0);
+    const auto right = std::min(rect.Right, DirtyScreenWidth);
+    const auto bottom = std::min(rect.Bottom, DirtyScreenHeight);
+    if (left >= right || top >= bottom)
+        return;
+
+    for (int32_t y = top >> grid.BlockShiftY; y <= (bottom - 1) >> static_cast<int32_t>(grid.BlockShiftY); y++)
+    {
+        for (int32_t x = left >> grid.BlockShiftX; x <= (right - 1) >> static_cast<int32_t>(grid.BlockShiftX); x++)
+        {
+            grid.Blocks[y * grid.BlockColumns + x] = 0xFF;
+        }
+    }
+}
+
+// The number of window stack traversals when every column of blocks is drawn on its own.
+static size_t CountDirtyColumnRuns(const Drawing::DirtyGrid& grid)
+{
+    size_t runs = 0;
+    for (uint32_t x = 0; x < grid.BlockColumns; x++)
+    {
+        bool inRun = false;
+        for (uint32_t y = 0; y < grid.BlockRows; y++)
+        {
+            const bool dirty = grid.Blocks[y * grid.BlockColumns + x] != 0;
+            if (dirty && !inRun)
+                runs++;
+            inRun = dirty;
+        }
+    }
+    return runs;
+}
+
+static exitcode_t HandleBenchDirtyRegions(CommandLineArgEnumerator* argEnumerator)
+{
+    std::vector<InvalidationPattern> patterns;
+    const utf8* rawPath;
+    while (argEnumerator->TryPopString(&rawPath))
+    {
+        auto& pattern = patterns.emplace_back();
+        if (!TryReadInvalidationPattern(Path::GetAbsolute(rawPath), pattern))
+        {
+            Console::Error::WriteLine("Unable to read %s", rawPath);
+            return EXITCODE_FAIL;
+        }
+    }
+    if (patterns.empty())
+    {
+        patterns = GetBuiltInInvalidationPatterns();
+    }
+
+    Drawing::DirtyGrid grid{};
+    grid.BlockShiftX = DirtyBlockShiftX;
+    grid.BlockShiftY = DirtyBlockShiftY;
+    grid.BlockWidth = 1 << DirtyBlockShiftX;
+    grid.BlockHeight = 1 << DirtyBlockShiftY;
+    grid.BlockColumns = (DirtyScreenWidth >> DirtyBlockShiftX) + 1;
+    grid.BlockRows = (DirtyScreenHeight >> DirtyBlockShiftY) + 1;
+    std::vector<uint8_t> blocks(grid.BlockColumns * grid.BlockRows);
+    grid.Blocks = blocks.data();
+
+    std::vector<Drawing::DirtyRect> rects;
+    Console::WriteLine("%-20s %8s %14s %14s %12s", "pattern", "frames", "columns/frame", "rects/frame", "us/frame");
+    for (const auto& pattern : patterns)
+    {
+        size_t columnRuns = 0;
+        size_t mergedRects = 0;
+        double elapsed = 0;
+        for (int32_t i = 0; i < BenchIterations; i++)
+        {
+            for (const auto& frame : pattern.Frames)
+            {
+                for (const auto& rect : frame)
+                {
+                    InvalidateDirtyGrid(grid, rect);
+                }
+                columnRuns += CountDirtyColumnRuns(grid);
+
+                Timer timer;
+                Drawing::ExtractDirtyRects(grid, rects);
+                elapsed += timer.GetElapsedTime().count();
+                mergedRects += rects.size();
+            }
+        }
+
+        const auto frames = static_cast<double>(pattern.Frames.size()) * BenchIterations;
+        Console::WriteLine(
+            "%-20s %8zu %14.1f %14.1f %12.2f", pattern.Name.c_str(), pattern.Frames.size(), columnRuns / frames,
+            mergedRects / frames, elapsed * 1e6 / frames);
+    }
+
+    return EXITCODE_OK;
+}
+
+static constexpr int32_t SpriteBlitBufferSize = 512;
+// The buffer is hashed every this many sprites so every sprite contributes to the checksum.
+static constexpr int32_t SpriteBlitHashInterval = 256;
+
+static uint32_t HashSpriteBlitBuffer(uint32_t hash, const std::vector<uint8_t>& buffer)
+{
+    for (auto pixel : buffer)
+    {
+        hash = (hash ^ pixel) * 16777619u;
+    }
+    return hash;
+}
+
+static exitcode_t HandleBenchSpriteBlit(CommandLineArgEnumerator* argEnumerator)
+{
+    // Graphics are left enabled so g1 gets loaded.
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    std::vector<ImageIndex> sprites;
+    for (ImageIndex i = 0; i < SPR_G1_END; i++)
+    {
+        auto g1 = GfxGetG1Element(i);
+        if (g1 != nullptr && g1->offset != nullptr && (g1->flags & G1_FLAG_RLE_COMPRESSION))
+        {
+            sprites.push_back(i);
+        }
+    }
+
+    std::vector<const RLEBlitKernels*> kernelSets = { &GetRLEBlitKernelsScalar() };
+    if (SSE41Available())
+        kernelSets.push_back(&GetRLEBlitKernelsSse4_1());
+    if (AVX2Available())
+        kernelSets.push_back(&GetRLEBlitKernelsAvx2());
+
+    // Pair blending stays per pixel, so only the modes that go through the kernels are measured.
+    struct Mode
+    {
+        const char* Name;
+        ImageId Image;
+    };
+    const std::array<Mode, 3> modes{ {
+        { "plain", ImageId() },
+        { "remap", ImageId().WithPrimary(COLOUR_BRIGHT_RED) },
+        { "transparent", ImageId().WithTransparency(COLOUR_LIGHT_BLUE) },
+    } };
+
+    Console::WriteLine("%zu RLE sprites", sprites.size());
+    Console::WriteLine(
+        "%-12s %-12s %4s %10s %8s %8s %8s", "kernels", "mode", "zoom", "ms/pass", "speedup", "output", "hit %");
+    const auto& defaultKernels = GetRLEBlitKernels();
+    std::vector<uint8_t> buffer(SpriteBlitBufferSize * SpriteBlitBufferSize);
+    for (const auto& mode : modes)
+    {
+        for (int8_t zoom = 0; zoom <= 3; zoom++)
+        {
+            DrawPixelInfo dpi;
+            dpi.bits = buffer.data();
+            dpi.width = SpriteBlitBufferSize << zoom;
+            dpi.height = SpriteBlitBufferSize << zoom;
+            dpi.zoom_level = ZoomLevel{ zoom };
+
+            double scalarElapsed = 0;
+            uint32_t scalarHash = 0;
+            // Each kernel set is measured without the sprite cache, followed by a run drawing from the cache.
+            for (size_t run = 0; run <= kernelSets.size(); run++)
+            {
+                const bool cached = run == kernelSets.size();
+                const auto* kernels = cached ? &defaultKernels : kernelSets[run];
+                SetRLEBlitKernels(*kernels);
+                Drawing::SpriteCache::SetMemoryLimit(cached ? Drawing::SpriteCache::DefaultMemoryLimit : 0);
+                if (cached)
+                {
+                    // Fill the cache so only drawing from it is measured
+                    for (auto sprite : sprites)
+                    {
+                        auto g1 = GfxGetG1Element(sprite);
+                        GfxDrawSpriteSoftware(dpi, mode.Image.WithIndex(sprite), { -g1->x_offset, -g1->y_offset });
+                    }
+                    Drawing::SpriteCache::ResetStats();
+                }
+
+                double elapsed = 0;
+                uint32_t hash = 2166136261u;
+                for (int32_t i = 0; i < BenchIterations; i++)
+                {
+                    std::fill(buffer.begin(), buffer.end(), PALETTE_INDEX_10);
+                    for (size_t j = 0; j < sprites.size(); j += SpriteBlitHashInterval)
+                    {
+                        const auto end = std::min(sprites.size(), j + SpriteBlitHashInterval);
+                        Timer timer;
+                        for (size_t k = j; k < end; k++)
+                        {
+                            auto g1 = GfxGetG1Element(sprites[k]);
+                            auto image = mode.Image.WithIndex(sprites[k]);
+                            GfxDrawSpriteSoftware(dpi, image, { -g1->x_offset, -g1->y_offset });
+                        }
+                        elapsed += timer.GetElapsedTime().count();
+                        hash = HashSpriteBlitBuffer(hash, buffer);
+                    }
+                }
+
+                if (run == 0)
+                {
+                    scalarElapsed = elapsed;
+                    scalarHash = hash;
+                }
+                const auto stats = Drawing::SpriteCache::GetStats();
+                const auto lookups = stats.Hits + stats.Misses;
+                Console::WriteLine(
+                    "%-12s %-12s %4d %10.2f %8.2f %8s %8.1f", cached ? "cached" : kernels->Name, mode.Name, zoom,
+                    elapsed * 1000.0 / BenchIterations, scalarElapsed / elapsed, hash == scalarHash ? "match" : "MISMATCH",
+                    lookups != 0 ? stats.Hits * 100.0 / lookups : 0.0);
+                Drawing::SpriteCache::Clear();
+            }
+        }
+    }
+    SetRLEBlitKernels(defaultKernels);
+    Drawing::SpriteCache::SetMemoryLimit(Drawing::SpriteCache::DefaultMemoryLimit);
+
+    return EXITCODE_OK;
+}
+
+using FirstElementFunc = TileElement* (*)(const TileCoordsXY&, TileElementType);
+
+// Starts every query at the first element of the tile, which is what the lookups did before tiles tracked the types
+// of their elements.
+static TileElement* ScanFirstElementOfType(const TileCoordsXY& loc, TileElementType)
+{
+    return MapGetFirstElementAt(loc);
+}
+
+template<typename TPredicate>
+static TileElement* FindTileElement(FirstElementFunc first, const TileCoordsXY& loc, TileElementType type, TPredicate pred)
+{
+    auto* tileElement = first(loc, type);
+    if (tileElement == nullptr)
+        return nullptr;
+    do
+    {
+        if (tileElement->GetType() == type && pred(*tileElement))
+            return tileElement;
+    } while (!(tileElement++)->IsLastForTile());
+    return nullptr;
+}
+
+// Counts the elements of a type that intersect the space at each height of interest, like the clearance checks done for
+// vehicles and construction that only care about one type of element.
+static uint64_t CountIntersecting(
+    FirstElementFunc first, const TileCoordsXY& loc, TileElementType type, int32_t surfaceHeight, int32_t numLevels)
+{
+    // Two levels, enough for a path or a piece of track with its supports.
+    static constexpr int32_t ClearanceHeight = 4;
+
+    uint64_t result = 0;
+    for (int32_t i = 0; i < numLevels; i++)
+    {
+        const auto z = surfaceHeight + i * 2;
+        auto* element = FindTileElement(first, loc, type, [z](const TileElement& e) {
+            return !e.IsGhost() && e.BaseHeight < z + ClearanceHeight && e.ClearanceHeight > z;
+        });
+        result += element != nullptr ? 1 : 0;
+    }
+    return result;
+}
+
+static exitcode_t HandleBenchTileQueries(CommandLineArgEnumerator* argEnumerator)
+{
+    struct Query
+    {
+        const char* Name;
+        // Runs the query at every height of interest on a tile and returns a checksum of what it found.
+        uint64_t (*Run)(FirstElementFunc first, const TileCoordsXY& loc, int32_t surfaceHeight);
+    };
+    // The heights around the surface of a tile that are queried, guests walk on paths up to a few levels above it.
+    static constexpr int32_t QueryLevels = 8;
+    static constexpr std::array<Query, 7> Queries{ {
+        { "path-at-height",
+          [](FirstElementFunc first, const TileCoordsXY& loc, int32_t surfaceHeight) -> uint64_t {
+              uint64_t result = 0;
+              for (int32_t i = 0; i < QueryLevels; i++)
+              {
+                  const auto z = surfaceHeight + i * 2;
+                  auto* element = FindTileElement(first, loc, TileElementType::Path, [z](const TileElement& e) {
+                      return !e.IsGhost() && e.BaseHeight == z;
+                  });
+                  result += element != nullptr ? z : 0;
+              }
+              return result;
+          } },
+        { "path-blocked",
+          [](FirstElementFunc first, const TileCoordsXY& loc, int32_t surfaceHeight) -> uint64_t {
+              uint64_t result = 0;
+              for (int32_t i = 0; i < QueryLevels; i++)
+              {
+                  const auto z = surfaceHeight + i * 2;
+                  auto* element = FindTileElement(first, loc, TileElementType::Path, [z](const TileElement& e) {
+                      return e.BaseHeight >= z && e.BaseHeight <= z + PATH_HEIGHT_STEP;
+                  });
+                  result += element != nullptr && element->AsPath()->IsBlockedByVehicle() ? 1 : 0;
+              }
+              return result;
+          } },
+        { "track-at-height",
+          [](FirstElementFunc first, const TileCoordsXY& loc, int32_t surfaceHeight) -> uint64_t {
+              uint64_t result = 0;
+              for (int32_t i = 0; i < QueryLevels; i++)
+              {
+                  const auto z = surfaceHeight + i * 2;
+                  auto* element = FindTileElement(
+                      first, loc, TileElementType::Track, [z](const TileElement& e) { return e.BaseHeight == z; });
+                  result += element != nullptr ? element->AsTrack()->GetTrackType() + 1 : 0;
+              }
+              return result;
+          } },
+        { "entrance",
+          [](FirstElementFunc first, const TileCoordsXY& loc, int32_t) -> uint64_t {
+              auto* element = FindTileElement(
+                  first, loc, TileElementType::Entrance, [](const TileElement&) { return true; });
+              return element != nullptr ? element->BaseHeight : 0;
+          } },
+        { "path-clearance",
+          [](FirstElementFunc first, const TileCoordsXY& loc, int32_t surfaceHeight) -> uint64_t {
+              return CountIntersecting(first, loc, TileElementType::Path, surfaceHeight, QueryLevels);
+          } },
+        { "track-clearance",
+          [](FirstElementFunc first, const TileCoordsXY& loc, int32_t surfaceHeight) -> uint64_t {
+              return CountIntersecting(first, loc, TileElementType::Track, surfaceHeight, QueryLevels);
+          } },
+        { "scenery-clearance",
+          [](FirstElementFunc first, const TileCoordsXY& loc, int32_t surfaceHeight) -> uint64_t {
+              return CountIntersecting(first, loc, TileElementType::SmallScenery, surfaceHeight, QueryLevels)
+                  + CountIntersecting(first, loc, TileElementType::LargeScenery, surfaceHeight, QueryLevels)
+                  + CountIntersecting(first, loc, TileElementType::Wall, surfaceHeight, QueryLevels);
+          } },
+    } };
+
+    const utf8* rawPath;
+    if (!argEnumerator->TryPopString(&rawPath))
+    {
+        Console::Error::WriteLine("Expected a park file.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    auto path = Path::GetAbsolute(rawPath);
+    if (!context->LoadParkFromFile(path))
+    {
+        Console::Error::WriteLine("Unable to load %s", path.c_str());
+        return EXITCODE_FAIL;
+    }
+
+    std::vector<std::pair<TileCoordsXY, int32_t>> tiles;
+    size_t numElements = 0;
+    for (int32_t y = 0; y < gMapSize.y; y++)
+    {
+        for (int32_t x = 0; x < gMapSize.x; x++)
+        {
+            const TileCoordsXY loc{ x, y };
+            auto* surfaceElement = MapGetSurfaceElementAt(loc);
+            if (surfaceElement == nullptr)
+                continue;
+            tiles.emplace_back(loc, surfaceElement->BaseHeight);
+            auto* element = MapGetFirstElementAt(loc);
+            do
+            {
+                numElements++;
+            } while (!(element++)->IsLastForTile());
+        }
+    }
+    Console::WriteLine(
+        "%zu tiles, %.2f elements per tile", tiles.size(),
+        tiles.empty() ? 0.0 : static_cast<double>(numElements) / tiles.size());
+
+    Console::WriteLine("%-18s %10s %10s %8s %10s", "query", "scan ms", "typed ms", "speedup", "result");
+    for (const auto& query : Queries)
+    {
+        std::array<double, 2> elapsed{};
+        std::array<uint64_t, 2> results{};
+        const std::array<FirstElementFunc, 2> firstFuncs{ ScanFirstElementOfType, MapGetFirstElementOfTypeAt };
+        for (size_t f = 0; f < firstFuncs.size(); f++)
+        {
+            Timer timer;
+            for (int32_t i = 0; i < BenchIterations; i++)
+            {
+                results[f] = 0;
+                for (const auto& [loc, surfaceHeight] : tiles)
+                {
+                    results[f] += query.Run(firstFuncs[f], loc, surfaceHeight);
+                }
+            }
+            elapsed[f] = timer.GetElapsedTime().count() * 1000.0 / BenchIterations;
+        }
+        Console::WriteLine(
+            "%-18s %10.2f %10.2f %7.2fx %10llu %s", query.Name, elapsed[0], elapsed[1],
+            elapsed[1] > 0 ? elapsed[0] / elapsed[1] : 0.0, static_cast<unsigned long long>(results[1]),
+            results[0] == results[1] ? "match" : "MISMATCH");
+    }
+
+    return EXITCODE_OK;
+}
+
+static exitcode_t HandleBenchTileSweep(CommandLineArgEnumerator* argEnumerator)
+{
+    const utf8* rawPath;
+    if (!argEnumerator->TryPopString(&rawPath))
+    {
+        Console::Error::WriteLine("Expected a park file.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    auto path = Path::GetAbsolute(rawPath);
+    if (!context->LoadParkFromFile(path))
+    {
+        Console::Error::WriteLine("Unable to load %s", path.c_str());
+        return EXITCODE_FAIL;
+    }
+
+    const auto alignTileElements = gConfigGeneral.AlignTileElements;
+    Console::WriteLine("%-10s %10s %12s %10s %16s", "layout", "elements", "cache lines", "ms", "result");
+    for (auto aligned : { false, true })
+    {
+        gConfigGeneral.AlignTileElements = aligned;
+        ReorganiseTileElements();
+
+        // Walks every element of every tile on the map, like MapUpdateTiles and painting do.
+        size_t cacheLines = 0;
+        uint64_t result = 0;
+        Timer timer;
+        for (int32_t i = 0; i < BenchIterations; i++)
+        {
+            cacheLines = 0;
+            result = 0;
+            for (int32_t y = 0; y < gMapSize.y; y++)
+            {
+                for (int32_t x = 0; x < gMapSize.x; x++)
+                {
+                    const auto* element = MapGetFirstElementAt(TileCoordsXY{ x, y });
+                    const auto* firstElement = element;
+                    do
+                    {
+                        result += element->BaseHeight + EnumValue(element->GetType());
+                    } while (!(element++)->IsLastForTile());
+
+                    const auto firstLine = reinterpret_cast<uintptr_t>(firstElement) / TILE_ELEMENT_CACHE_LINE_SIZE;
+                    const auto lastLine = (reinterpret_cast<uintptr_t>(element) - 1) / TILE_ELEMENT_CACHE_LINE_SIZE;
+                    cacheLines += lastLine - firstLine + 1;
+                }
+            }
+        }
+        Console::WriteLine(
+            "%-10s %10zu %12zu %10.2f %16llu", aligned ? "aligned" : "packed", GetTileElements().size(), cacheLines,
+            timer.GetElapsedTime().count() * 1000.0 / BenchIterations, static_cast<unsigned long long>(result));
+    }
+    gConfigGeneral.AlignTileElements = alignTileElements;
+    ReorganiseTileElements();
+
+    return EXITCODE_OK;
+}
+
+static uint64_t HashMapSweepState()
+{
+    // FNV-1a over everything the sweeps can change.
+    uint64_t hash = 14695981039346656037ull;
+    auto hashBytes = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    const auto elements = GetReorganisedTileElementsWithoutGhosts();
+    hashBytes(elements.data(), elements.size() * sizeof(TileElement));
+    const auto& randState = ScenarioRandState();
+    hashBytes(&randState.s0, sizeof(randState.s0));
+    hashBytes(&randState.s1, sizeof(randState.s1));
+    const auto numFountains = GetEntityListCount(EntityType::JumpingFountain);
+    hashBytes(&numFountains, sizeof(numFountains));
+    return hash;
+}
+
+static exitcode_t HandleBenchMapSweeps(CommandLineArgEnumerator* argEnumerator)
+{
+    // Enough calls for both sweeps to cover the whole map once.
+    static constexpr int32_t Calls = 16;
+    static constexpr int32_t PositionsPerCall = 65536 / Calls;
+    static constexpr int32_t PathTilesPerCall = MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL / Calls + 1;
+
+    const utf8* rawPath;
+    if (!argEnumerator->TryPopString(&rawPath))
+    {
+        Console::Error::WriteLine("Expected a park file.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    auto path = Path::GetAbsolute(rawPath);
+    JobPool jobPool;
+    std::array<uint64_t, 2> hashes{};
+    Console::WriteLine("%-10s %14s %14s %18s", "sweep", "tiles ms", "path ms", "hash");
+    for (size_t i = 0; i < hashes.size(); i++)
+    {
+        // Both sweeps start from the same state so their results can be compared.
+        if (!context->LoadParkFromFile(path))
+        {
+            Console::Error::WriteLine("Unable to load %s", path.c_str());
+            return EXITCODE_FAIL;
+        }
+
+        auto* pool = i == 0 ? nullptr : &jobPool;
+        Timer tilesTimer;
+        for (int32_t call = 0; call < Calls; call++)
+        {
+            MapUpdateTiles(PositionsPerCall, pool);
+        }
+        const auto tilesElapsed = tilesTimer.GetElapsedTime().count() * 1000.0;
+
+        Timer pathTimer;
+        for (int32_t call = 0; call < Calls; call++)
+        {
+            MapUpdatePathWideFlags(PathTilesPerCall, pool);
+        }
+        const auto pathElapsed = pathTimer.GetElapsedTime().count() * 1000.0;
+
+        hashes[i] = HashMapSweepState();
+        Console::WriteLine(
+            "%-10s %14.2f %14.2f %18llx", pool == nullptr ? "serial" : "parallel", tilesElapsed, pathElapsed,
+            static_cast<unsigned long long>(hashes[i]));
+    }
+    Console::WriteLine("results %s", hashes[0] == hashes[1] ? "match" : "MISMATCH");
+
+    return hashes[0] == hashes[1] ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+#ifdef ENABLE_SCRIPTING
+static exitcode_t HandleBenchPluginEntityQuery(CommandLineArgEnumerator* argEnumerator)
+{
+    struct Query
+    {
+        const char* Name;
+        const char* Script;
+    };
+    // Both scripts compute the same sum so the results can be checked against each other.
+    static constexpr std::array<Query, 2> Queries{ {
+        { "getAllEntities",
+          "var g = map.getAllEntities('guest'), s = 0;"
+          "for (var i = 0; i < g.length; i++) s += g[i].x + g[i].happiness + g[i].energy; s" },
+        { "queryEntities",
+          "var q = map.queryEntities('guest', ['x', 'happiness', 'energy']), s = 0;"
+          "for (var i = 0; i < q.count; i++) s += q.x[i] + q.happiness[i] + q.energy[i]; s" },
+    } };
+
+    const utf8* rawPath;
+    if (!argEnumerator->TryPopString(&rawPath))
+    {
+        Console::Error::WriteLine("Expected a park file.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    auto path = Path::GetAbsolute(rawPath);
+    if (!context->LoadParkFromFile(path))
+    {
+        Console::Error::WriteLine("Unable to load %s", path.c_str());
+        return EXITCODE_FAIL;
+    }
+
+    auto* ctx = context->GetScriptEngine().GetContext();
+    Console::WriteLine("%-16s %10s %16s", "query", "ms", "result");
+    for (const auto& query : Queries)
+    {
+        double result = 0;
+        Timer timer;
+        for (int32_t i = 0; i < BenchIterations; i++)
+        {
+            if (duk_peval_string(ctx, query.Script) != 0)
+            {
+                Console::Error::WriteLine("%s failed: %s", query.Name, duk_safe_to_string(ctx, -1));
+                duk_pop(ctx);
+                return EXITCODE_FAIL;
+            }
+            result = duk_get_number(ctx, -1);
+            duk_pop(ctx);
+        }
+        Console::WriteLine(
+            "%-16s %10.2f %16.0f", query.Name, timer.GetElapsedTime().count() * 1000.0f / BenchIterations, result);
+    }
+
+    return EXITCODE_OK;
+}
+#endif
@@ -0,0 +1,267 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../Game.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../ReplayManager.h"
+#include "../core/Console.hpp"
+#include "../core/FileScanner.h"
+#include "../core/JobPool.h"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../core/Timer.hpp"
+#include "../platform/Platform.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static int32_t _jobs = 1;
+static bool _porcelain = false;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition ReplayVerifyOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_jobs,      'j', "jobs",      "number of replays to verify in parallel, each in its own process" },
+    { CMDLINE_TYPE_SWITCH,  &_porcelain, NAC, "porcelain", "print one machine readable result line per replay"                },
+    OptionTableEnd
+};
+
+static exitcode_t HandleReplayVerify(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::ReplayCommands[]{
+    // Main commands
+    DefineCommand("verify", "<replay|directory>...", ReplayVerifyOptions, HandleReplayVerify),
+
+    CommandTableEnd
+};
+// clang-format on
+
+static constexpr const char* PorcelainPrefix = "replay-result";
+
+enum class ReplayVerifyStatus
+{
+    Ok,
+    Diverged,
+    Error,
+};
+
+struct ReplayVerifyResult
+{
+    std::string Path;
+    ReplayVerifyStatus Status = ReplayVerifyStatus::Error;
+    uint32_t Ticks = 0;
+    uint32_t DivergenceTick = 0;
+    float Milliseconds = 0;
+};
+
+static const char* GetStatusName(ReplayVerifyStatus status)
+{
+    switch (status)
+    {
+        case ReplayVerifyStatus::Ok:
+            return "ok";
+        case ReplayVerifyStatus::Diverged:
+            return "diverged";
+        default:
+            return "error";
+    }
+}
+
+static std::vector<std::string> GetReplayPaths(CommandLineArgEnumerator* argEnumerator)
+{
+    std::vector<std::string> paths;
+    const utf8* rawPath;
+    while (argEnumerator->TryPopString(&rawPath))
+    {
+        auto path = Path::GetAbsolute(rawPath);
+        if (Path::DirectoryExists(path))
+        {
+            auto scanner = Path::ScanDirectory(Path::Combine(path, u8"*.parkrep"), true);
+            while (scanner->Next())
+            {
+                paths.push_back(scanner->GetPath());
+            }
+        }
+        else
+        {
+            paths.push_back(path);
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+/**
+ * Plays the replay back by calling UpdateLogic directly, skipping rendering, audio and frame pacing.
+ * Playback stops at the first checksum mismatch.
+ */
+static ReplayVerifyResult VerifyReplay(IContext& context, const std::string& path)
+{
+    ReplayVerifyResult result;
+    result.Path = path;
+
+    auto* replayManager = context.GetReplayManager();
+    auto* gameState = context.GetGameState();
+
+    Timer timer;
+    if (!replayManager->StartPlayback(path))
+    {
+        return result;
+    }
+
+    const auto startTick = gCurrentTicks;
+    result.Status = ReplayVerifyStatus::Ok;
+    while (replayManager->IsReplaying())
+    {
+        gameState->UpdateLogic();
+        if (replayManager->IsPlaybackStateMismatching())
+        {
+            // The checksum is compared at the start of the tick that just ran.
+            result.Status = ReplayVerifyStatus::Diverged;
+            result.DivergenceTick = gCurrentTicks - 1 - startTick;
+            replayManager->StopPlayback();
+            break;
+        }
+    }
+    result.Ticks = gCurrentTicks - startTick;
+    result.Milliseconds = timer.GetElapsedTime().count() * 1000.0f;
+    return result;
+}
+
+static ReplayVerifyResult VerifyReplayInChildProcess(const std::string& exePath, const std::string& path)
+{
+    ReplayVerifyResult result;
+    result.Path = path;
+
+    auto command = String::StdFormat("\"%s\" replay verify --porcelain \"%s\"", exePath.c_str(), path.c_str());
+
+    Timer timer;
+    std::string output;
+    Platform::Execute(command, &output);
+    result.Milliseconds = timer.GetElapsedTime().count() * 1000.0f;
+
+    auto line = output.rfind(PorcelainPrefix);
+    if (line != std::string::npos)
+    {
+        char status[16] = {};
+        if (std::sscanf(
+                output.c_str() + line + std::strlen(PorcelainPrefix), " %15s %u %u", status, &result.Ticks,
+                &result.DivergenceTick)
+            == 3)
+        {
+            if (String::Equals(status, GetStatusName(ReplayVerifyStatus::Ok)))
+                result.Status = ReplayVerifyStatus::Ok;
+            else if (String::Equals(status, GetStatusName(ReplayVerifyStatus::Diverged)))
+                result.Status = ReplayVerifyStatus::Diverged;
+        }
+    }
+    return result;
+}
+
+static void PrintResult(const ReplayVerifyResult& result)
+{
+    if (_porcelain)
+    {
+        Console::WriteLine(
+            "%s %s %u %u %.0f", PorcelainPrefix, GetStatusName(result.Status), result.Ticks, result.DivergenceTick,
+            result.Milliseconds);
+        return;
+    }
+
+    auto divergence = result.Status == ReplayVerifyStatus::Diverged ? std::to_string(result.DivergenceTick) : "-";
+    Console::WriteLine(
+        "%-48s %-8s %10u %10s %10.0f", Path::GetFileName(result.Path).c_str(), GetStatusName(result.Status), result.Ticks,
+        divergence.c_str(), result.Milliseconds);
+}
+
+static exitcode_t HandleReplayVerify(CommandLineArgEnumerator* argEnumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    auto paths = GetReplayPaths(argEnumerator);
+    if (paths.empty())
+    {
+        Console::Error::WriteLine("Expected one or more replay files or directories.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    // The game state is global so parallel verification needs a process per replay.
+    auto jobs = static_cast<size_t>(std::max(_jobs, 1));
+#ifdef _WIN32
+    if (jobs > 1)
+    {
+        Console::Error::WriteLine("Parallel verification is not supported on this platform, using a single process.");
+        jobs = 1;
+    }
+#endif
+
+    if (!_porcelain)
+    {
+        Console::WriteLine("%-48s %-8s %10s %10s %10s", "replay", "result", "ticks", "diverged", "ms");
+    }
+
+    Timer timer;
+    std::vector<ReplayVerifyResult> results(paths.size());
+    if (jobs > 1 && paths.size() > 1)
+    {
+        auto exePath = Platform::GetCurrentExecutablePath();
+
+        JobPool pool(jobs);
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            pool.AddTask(
+                [&results, &exePath, &paths, i]() { results[i] = VerifyReplayInChildProcess(exePath, paths[i]); },
+                [&results, i]() { PrintResult(results[i]); });
+        }
+        pool.Join();
+    }
+    else
+    {
+        std::unique_ptr<IContext> context(CreateContext());
+        if (!context->Initialise())
+        {
+            Console::Error::WriteLine("Context initialization failed.");
+            return EXITCODE_FAIL;
+        }
+
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            results[i] = VerifyReplay(*context, paths[i]);
+            PrintResult(results[i]);
+        }
+    }
+
+    if (_porcelain)
+    {
+        return EXITCODE_OK;
+    }
+
+    auto failed = std::count_if(
+        results.begin(), results.end(), [](const auto& r) { return r.Status != ReplayVerifyStatus::Ok; });
+    Console::WriteLine(
+        "Verified %zu replays in %.1f s, %zu failed.", results.size(), timer.GetElapsedTime().count(),
+        static_cast<size_t>(failed));
+
+    return failed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
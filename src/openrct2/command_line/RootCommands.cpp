@@ -21,6 +21,7 @@
 #include "../localisation/Language.h"
 #include "../network/network.h"
 #include "../object/ObjectRepository.h"
+#include "../object/SharedObjectCache.h"
 #include "../park/ParkFile.h"
 #include "../platform/Crash.h"
 #include "../platform/Platform.h"
@@ -95,6 +96,7 @@ static exitcode_t HandleCommandJoin(CommandLineArgEnumerator * enumerator);
 #endif
 static exitcode_t HandleCommandSetRCT2(CommandLineArgEnumerator * enumerator);
 static exitcode_t HandleCommandScanObjects(CommandLineArgEnumerator * enumerator);
+static exitcode_t HandleCommandBuildObjectCache(CommandLineArgEnumerator * enumerator);
 
 #if defined(_WIN32)
 
@@ -131,6 +133,7 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineCommand("set-rct2", "<path>",                 StandardOptions, HandleCommandSetRCT2),
     DefineCommand("convert",  "<source> <destination>", StandardOptions, CommandLine::HandleCommandConvert),
     DefineCommand("scan-objects", "<path>",             StandardOptions, HandleCommandScanObjects),
+    DefineCommand("build-object-cache", "",             StandardOptions, HandleCommandBuildObjectCache),
     DefineCommand("handle-uri", "openrct2://.../",      StandardOptions, CommandLine::HandleCommandUri),
 
 #if defined(_WIN32)
@@ -142,6 +145,8 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("sprite",          CommandLine::SpriteCommands           ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
     DefineSubCommand("parkinfo",        CommandLine::ParkInfoCommands         ),
+    DefineSubCommand("bench",           CommandLine::BenchCommands            ),
+    DefineSubCommand("replay",          CommandLine::ReplayCommands           ),
     CommandTableEnd
 };
 
@@ -398,6 +403,39 @@ static exitcode_t HandleCommandScanObjects([[maybe_unused]] CommandLineArgEnumer
     return EXITCODE_OK;
 }
 
+static exitcode_t HandleCommandBuildObjectCache([[maybe_unused]] CommandLineArgEnumerator* enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    gOpenRCT2Headless = true;
+
+    auto context = OpenRCT2::CreateContext();
+    auto env = context->GetPlatformEnvironment();
+    auto objectRepository = CreateObjectRepository(env);
+    objectRepository->LoadOrConstruct(gConfigGeneral.Language);
+
+    // Only set now, so the repository does not map the cache that is about to be replaced
+    gOpenRCT2NoGraphics = true;
+
+    auto cachePath = env->GetFilePath(OpenRCT2::PATHID::CACHE_OBJECTS_SHARED);
+    try
+    {
+        auto numObjects = SharedObjectCache::Build(*objectRepository, cachePath);
+        Console::WriteLine(
+            "Wrote %zu of %zu objects to '%s'", numObjects, objectRepository->GetNumObjects(), cachePath.c_str());
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to build shared object cache: %s", e.what());
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
 #if defined(_WIN32)
 static exitcode_t HandleCommandRegisterShell([[maybe_unused]] CommandLineArgEnumerator* enumerator)
 {
@@ -168,6 +168,9 @@ namespace Config
             model->PlayIntro = reader->GetBoolean("play_intro", false);
             model->SavePluginData = reader->GetBoolean("save_plugin_data", true);
             model->DebuggingTools = reader->GetBoolean("debugging_tools", false);
+            model->TickStallThreshold = reader->GetFloat("tick_stall_threshold", 0.0f);
+            model->AlignTileElements = reader->GetBoolean("align_tile_elements", false);
+            model->ParkBlockCompression = reader->GetBoolean("park_block_compression", false);
             model->ShowHeightAsUnits = reader->GetBoolean("show_height_as_units", false);
             model->TemperatureFormat = reader->GetEnum<TemperatureUnit>(
                 "temperature_format", Platform::GetLocaleTemperatureFormat(), Enum_Temperature);
@@ -265,6 +268,9 @@ namespace Config
         writer->WriteBoolean("play_intro", model->PlayIntro);
         writer->WriteBoolean("save_plugin_data", model->SavePluginData);
         writer->WriteBoolean("debugging_tools", model->DebuggingTools);
+        writer->WriteFloat("tick_stall_threshold", model->TickStallThreshold);
+        writer->WriteBoolean("align_tile_elements", model->AlignTileElements);
+        writer->WriteBoolean("park_block_compression", model->ParkBlockCompression);
         writer->WriteBoolean("show_height_as_units", model->ShowHeightAsUnits);
         writer->WriteEnum<TemperatureUnit>("temperature_format", model->TemperatureFormat, Enum_Temperature);
         writer->WriteInt32("window_height", model->WindowHeight);
@@ -569,6 +575,8 @@ namespace Config
             auto model = &gConfigPlugin;
             model->EnableHotReloading = reader->GetBoolean("enable_hot_reloading", false);
             model->AllowedHosts = reader->GetString("allowed_hosts", "");
+            model->TickBudget = reader->GetFloat("tick_budget", 0.0f);
+            model->ThrottleOverBudget = reader->GetBoolean("throttle_over_budget", false);
         }
     }
 
@@ -578,6 +586,8 @@ namespace Config
         writer->WriteSection("plugin");
         writer->WriteBoolean("enable_hot_reloading", model->EnableHotReloading);
         writer->WriteString("allowed_hosts", model->AllowedHosts);
+        writer->WriteFloat("tick_budget", model->TickBudget);
+        writer->WriteBoolean("throttle_over_budget", model->ThrottleOverBudget);
     }
 
     static bool SetDefaults()
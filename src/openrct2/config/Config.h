@@ -91,6 +91,9 @@ struct GeneralConfiguration
     int32_t WindowSnapProximity;
     bool SavePluginData;
     bool DebuggingTools;
+    float TickStallThreshold;
+    bool AlignTileElements;
+    bool ParkBlockCompression;
     int32_t AutosaveFrequency;
     int32_t AutosaveAmount;
     bool AutoStaffPlacement;
@@ -219,6 +222,8 @@ struct PluginConfiguration
 {
     bool EnableHotReloading;
     u8string AllowedHosts;
+    float TickBudget;
+    bool ThrottleOverBudget;
 };
 
 enum class Sort : int32_t
@@ -16,36 +16,49 @@
 #include "FileScanner.h"
 #include "FileStream.h"
 #include "JobPool.h"
-#include "Numerics.hpp"
 #include "Path.hpp"
 
+#include <atomic>
 #include <chrono>
-#include <list>
+#include <mutex>
+#include <optional>
 #include <string>
-#include <tuple>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+struct FileIndexStats
+{
+    size_t Files{};
+    // Files whose size and modification time match the index, their items are read from the index.
+    size_t Reused{};
+    size_t Added{};
+    size_t Changed{};
+    size_t Removed{};
+    float ScanSeconds{};
+    float BuildSeconds{};
+};
+
 template<typename TItem> class FileIndex
 {
 private:
-    struct DirectoryStats
+    struct ScannedFile
     {
-        uint32_t TotalFiles = 0;
-        uint64_t TotalFileSize = 0;
-        uint32_t FileDateModifiedChecksum = 0;
-        uint32_t PathChecksum = 0;
+        std::string Path;
+        uint64_t Size{};
+        uint64_t LastModified{};
     };
 
-    struct ScanResult
+    /**
+     * A file in the index with the item created from it. Files that did not produce an item are kept as well, so they
+     * are not loaded again while they are unchanged.
+     */
+    struct IndexEntry
     {
-        DirectoryStats const Stats;
-        std::vector<std::string> const Files;
-
-        ScanResult(DirectoryStats stats, std::vector<std::string>&& files) noexcept
-            : Stats(stats)
-            , Files(std::move(files))
-        {
-        }
+        std::string Path;
+        uint64_t Size{};
+        uint64_t LastModified{};
+        std::optional<TItem> Item;
     };
 
     struct FileIndexHeader
@@ -55,12 +68,11 @@ private:
         uint8_t VersionA = 0;
         uint8_t VersionB = 0;
         uint16_t LanguageId = 0;
-        DirectoryStats Stats;
-        uint32_t NumItems = 0;
+        uint32_t NumEntries = 0;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -96,32 +108,23 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries the directories and loads the index. Items of files that are unchanged since the index was written are
+     * loaded from the index, only new and changed files are loaded again.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
-        auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
-        if (std::get<0>(readIndexResult))
-        {
-            // Index was loaded
-            items = std::get<1>(readIndexResult);
-        }
-        else
-        {
-            // Index was not loaded
-            items = Build(language, scanResult);
-        }
-        return items;
+        auto startTime = std::chrono::high_resolution_clock::now();
+        auto files = Scan();
+        auto scanTime = std::chrono::high_resolution_clock::now();
+        return Update(language, files, ReadIndexFile(language), std::chrono::duration<float>(scanTime - startTime));
     }
 
     std::vector<TItem> Rebuild(int32_t language) const
     {
-        auto scanResult = Scan();
-        auto items = Build(language, scanResult);
-        return items;
+        auto startTime = std::chrono::high_resolution_clock::now();
+        auto files = Scan();
+        auto scanTime = std::chrono::high_resolution_clock::now();
+        return Update(language, files, std::nullopt, std::chrono::duration<float>(scanTime - startTime));
     }
 
 protected:
@@ -136,10 +139,9 @@ protected:
     virtual void Serialise(DataSerialiser& ds, const TItem& item) const abstract;
 
 private:
-    ScanResult Scan() const
+    std::vector<ScannedFile> Scan() const
     {
-        DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<ScannedFile> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -150,106 +152,155 @@ private:
             while (scanner->Next())
             {
                 const auto& fileInfo = scanner->GetFileInfo();
-                auto path = scanner->GetPath();
+                files.push_back({ scanner->GetPath(), fileInfo.Size, fileInfo.LastModified });
+            }
+        }
+        return files;
+    }
 
-                stats.TotalFiles++;
-                stats.TotalFileSize += fileInfo.Size;
-                stats.FileDateModifiedChecksum ^= static_cast<uint32_t>(fileInfo.LastModified >> 32)
-                    ^ static_cast<uint32_t>(fileInfo.LastModified & 0xFFFFFFFF);
-                stats.FileDateModifiedChecksum = Numerics::ror32(stats.FileDateModifiedChecksum, 5);
-                stats.PathChecksum += GetPathChecksum(path);
+    std::vector<TItem> Update(
+        int32_t language, const std::vector<ScannedFile>& files, std::optional<std::vector<IndexEntry>>&& index,
+        std::chrono::duration<float> scanDuration) const
+    {
+        FileIndexStats stats;
+        stats.Files = files.size();
+        stats.ScanSeconds = scanDuration.count();
+
+        // Files are matched to the index by path, the item is reused if the size and modification time are unchanged
+        std::vector<IndexEntry> indexed = index.has_value() ? std::move(index.value()) : std::vector<IndexEntry>();
+        std::unordered_map<std::string_view, IndexEntry*> indexedByPath;
+        indexedByPath.reserve(indexed.size());
+        for (auto& entry : indexed)
+        {
+            indexedByPath.emplace(entry.Path, &entry);
+        }
+
+        std::vector<IndexEntry> entries(files.size());
+        std::vector<size_t> changedEntries;
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            const auto& file = files[i];
+            auto& entry = entries[i];
 
-                files.push_back(std::move(path));
+            IndexEntry* indexedEntry = nullptr;
+            if (auto it = indexedByPath.find(file.Path); it != indexedByPath.end())
+            {
+                indexedEntry = it->second;
+                indexedByPath.erase(it);
             }
+
+            if (indexedEntry != nullptr && indexedEntry->Size == file.Size
+                && indexedEntry->LastModified == file.LastModified)
+            {
+                entry = std::move(*indexedEntry);
+                stats.Reused++;
+                continue;
+            }
+
+            entry.Path = file.Path;
+            entry.Size = file.Size;
+            entry.LastModified = file.LastModified;
+            changedEntries.push_back(i);
+            if (indexedEntry != nullptr)
+                stats.Changed++;
+            else
+                stats.Added++;
         }
-        return ScanResult(stats, std::move(files));
+        stats.Removed = indexedByPath.size();
+
+        if (!changedEntries.empty() || stats.Removed != 0 || !index.has_value())
+        {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            Build(language, entries, changedEntries);
+            WriteIndexFile(language, entries);
+            auto endTime = std::chrono::high_resolution_clock::now();
+            stats.BuildSeconds = std::chrono::duration<float>(endTime - startTime).count();
+
+            Console::WriteLine(
+                "Updated %s: %zu files, %zu reused, %zu added, %zu changed, %zu removed (scan %.2fs, build %.2fs)",
+                _name.c_str(), stats.Files, stats.Reused, stats.Added, stats.Changed, stats.Removed, stats.ScanSeconds,
+                stats.BuildSeconds);
+        }
+        else
+        {
+            LOG_VERBOSE(
+                "FileIndex:%s up to date: %zu files (scan %.2fs)", _name.c_str(), stats.Files, stats.ScanSeconds);
+        }
+
+        std::vector<TItem> items;
+        items.reserve(entries.size());
+        for (auto& entry : entries)
+        {
+            if (entry.Item.has_value())
+            {
+                items.push_back(std::move(entry.Item.value()));
+            }
+        }
+        return items;
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, std::vector<IndexEntry>& entries, const std::vector<size_t>& changedEntries, size_t rangeStart,
+        size_t rangeEnd, std::atomic<size_t>& processed, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            auto& entry = entries[changedEntries[i]];
 
             if (_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
             {
                 std::lock_guard<std::mutex> lock(printLock);
-                LOG_VERBOSE("FileIndex:Indexing '%s'", filePath.c_str());
+                LOG_VERBOSE("FileIndex:Indexing '%s'", entry.Path.c_str());
             }
 
-            if (auto item = Create(language, filePath); item.has_value())
-            {
-                items.push_back(std::move(item.value()));
-            }
+            entry.Item = Create(language, entry.Path);
 
             ++processed;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    void Build(int32_t language, std::vector<IndexEntry>& entries, const std::vector<size_t>& changedEntries) const
     {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
-
-        auto startTime = std::chrono::high_resolution_clock::now();
-
-        const size_t totalCount = scanResult.Files.size();
-        if (totalCount > 0)
+        const size_t totalCount = changedEntries.size();
+        if (totalCount == 0)
         {
-            JobPool jobPool;
-            std::mutex printLock; // For verbose prints.
-
-            std::list<std::vector<TItem>> containers;
-
-            size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
-
-            std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
+            return;
+        }
 
-            auto reportProgress = [&]() {
-                const size_t completed = processed;
-                Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
-            };
+        Console::WriteLine("Building %s (%zu of %zu items)", _name.c_str(), totalCount, entries.size());
 
-            for (size_t rangeStart = 0; rangeStart < totalCount; rangeStart += stepSize)
-            {
-                if (rangeStart + stepSize > totalCount)
-                {
-                    stepSize = totalCount - rangeStart;
-                }
+        JobPool jobPool;
+        std::mutex printLock; // For verbose prints.
 
-                auto& items = containers.emplace_back();
+        size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
-                jobPool.AddTask([&, rangeStart, stepSize]() {
-                    BuildRange(language, scanResult, rangeStart, rangeStart + stepSize, items, processed, printLock);
-                });
+        std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
 
-                reportProgress();
-            }
+        auto reportProgress = [&]() {
+            const size_t completed = processed;
+            Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
+        };
 
-            jobPool.Join(reportProgress);
-
-            for (const auto& itr : containers)
+        // Every task writes to its own entries, so they can be created in place
+        for (size_t rangeStart = 0; rangeStart < totalCount; rangeStart += stepSize)
+        {
+            if (rangeStart + stepSize > totalCount)
             {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
+                stepSize = totalCount - rangeStart;
             }
-        }
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
+            jobPool.AddTask([&, rangeStart, stepSize]() {
+                BuildRange(language, entries, changedEntries, rangeStart, rangeStart + stepSize, processed, printLock);
+            });
 
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration<float>(endTime - startTime);
-        Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
+            reportProgress();
+        }
 
-        return allItems;
+        jobPool.Join(reportProgress);
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    std::optional<std::vector<IndexEntry>> ReadIndexFile(int32_t language) const
     {
-        bool loadedItems = false;
-        std::vector<TItem> items;
         if (File::Exists(_indexPath))
         {
             try
@@ -257,24 +308,23 @@ private:
                 LOG_VERBOSE("FileIndex:Loading index: '%s'", _indexPath.c_str());
                 auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_OPEN);
 
-                // Read header, check if we need to re-scan
+                // Read header, the whole index is rebuilt if it was written by another version or for another language
                 auto header = fs.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
-                    items.reserve(header.NumItems);
+                    std::vector<IndexEntry> entries(header.NumEntries);
                     DataSerialiser ds(false, fs);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
+                    for (auto& entry : entries)
                     {
-                        TItem item;
-                        Serialise(ds, item);
-                        items.emplace_back(std::move(item));
+                        bool hasItem = false;
+                        ds << entry.Path << entry.Size << entry.LastModified << hasItem;
+                        if (hasItem)
+                        {
+                            Serialise(ds, entry.Item.emplace());
+                        }
                     }
-                    loadedItems = true;
+                    return entries;
                 }
                 else
                 {
@@ -287,10 +337,10 @@ private:
                 Console::Error::WriteLine("%s", e.what());
             }
         }
-        return std::make_tuple(loadedItems, std::move(items));
+        return std::nullopt;
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<TItem>& items) const
+    void WriteIndexFile(int32_t language, const std::vector<IndexEntry>& entries) const
     {
         try
         {
@@ -304,15 +354,19 @@ private:
             header.VersionA = FILE_INDEX_VERSION;
             header.VersionB = _version;
             header.LanguageId = language;
-            header.Stats = stats;
-            header.NumItems = static_cast<uint32_t>(items.size());
+            header.NumEntries = static_cast<uint32_t>(entries.size());
             fs.WriteValue(header);
 
             DataSerialiser ds(true, fs);
-            // Write items
-            for (const auto& item : items)
+            // Write entries
+            for (const auto& entry : entries)
             {
-                Serialise(ds, item);
+                const bool hasItem = entry.Item.has_value();
+                ds << entry.Path << entry.Size << entry.LastModified << hasItem;
+                if (hasItem)
+                {
+                    Serialise(ds, entry.Item.value());
+                }
             }
         }
         catch (const std::exception& e)
@@ -321,19 +375,4 @@ private:
             Console::Error::WriteLine("%s", e.what());
         }
     }
-
-    static uint32_t GetPathChecksum(const std::string& path)
-    {
-        uint32_t hash = 0xD8430DED;
-        for (const utf8* ch = path.c_str(); *ch != '\0'; ch++)
-        {
-            hash += (*ch);
-            hash += (hash << 10);
-            hash ^= (hash >> 6);
-        }
-        hash += (hash << 3);
-        hash ^= (hash >> 11);
-        hash += (hash << 15);
-        return hash;
-    }
 };
@@ -0,0 +1,269 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace OpenRCT2::FrameArena
+{
+    // Allocations larger than this get a block of their own so they do not waste the rest of a block.
+    static constexpr size_t LargeAllocationSize = BlockSize / 4;
+
+    static std::atomic<uint64_t> _heapAllocations{};
+    static std::atomic<uint64_t> _arenaBytes{};
+    static std::atomic<uint32_t> _arenaBlocks{};
+    static std::atomic<uint32_t> _frame{};
+
+    static uint64_t _heapAllocationsAtFrameEnd{};
+    static FrameStats _lastFrameStats;
+
+    struct Block
+    {
+        std::unique_ptr<uint8_t[]> Data;
+        // Allocations from this block that have not been released yet, they may be released by any thread.
+        std::atomic<uint32_t> LiveAllocations{};
+
+        explicit Block(size_t size)
+            : Data(new uint8_t[size])
+        {
+            _arenaBlocks.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool IsInUse() const
+        {
+            return LiveAllocations.load(std::memory_order_acquire) != 0;
+        }
+    };
+
+    // Every allocation is preceded by a pointer to the block it came from.
+    static constexpr size_t HeaderSize = sizeof(Block*);
+
+    struct ThreadArena
+    {
+        std::vector<Block*> FreeBlocks;
+        // Blocks handed out from since they were last free, including the current one.
+        std::vector<Block*> UsedBlocks;
+        std::vector<Block*> LargeBlocks;
+        Block* Current{};
+        size_t Offset{};
+        uint32_t Frame{};
+
+        ~ThreadArena()
+        {
+            // Blocks that still have allocations alive, which another thread may release later, are left behind.
+            for (auto* block : FreeBlocks)
+                delete block;
+            for (auto* block : UsedBlocks)
+            {
+                if (!block->IsInUse())
+                    delete block;
+            }
+            for (auto* block : LargeBlocks)
+            {
+                if (!block->IsInUse())
+                    delete block;
+            }
+        }
+
+        // Blocks without live allocations are reused, the others are kept until all of their allocations are released.
+        void Rewind()
+        {
+            auto isInUse = [](const Block* block) { return block->IsInUse(); };
+            auto it = std::stable_partition(UsedBlocks.begin(), UsedBlocks.end(), isInUse);
+            FreeBlocks.insert(FreeBlocks.end(), it, UsedBlocks.end());
+            UsedBlocks.erase(it, UsedBlocks.end());
+
+            it = std::stable_partition(LargeBlocks.begin(), LargeBlocks.end(), isInUse);
+            std::for_each(it, LargeBlocks.end(), [](const Block* block) { delete block; });
+            LargeBlocks.erase(it, LargeBlocks.end());
+
+            Current = nullptr;
+            Offset = 0;
+        }
+
+        void NextBlock()
+        {
+            if (FreeBlocks.empty())
+            {
+                Current = new Block(BlockSize);
+            }
+            else
+            {
+                Current = FreeBlocks.back();
+                FreeBlocks.pop_back();
+            }
+            UsedBlocks.push_back(Current);
+            Offset = 0;
+        }
+    };
+
+    static ThreadArena& GetThreadArena()
+    {
+        thread_local ThreadArena arena;
+        return arena;
+    }
+
+    static size_t AlignDataOffset(size_t offset, size_t alignment)
+    {
+        return (offset + HeaderSize + alignment - 1) & ~(alignment - 1);
+    }
+
+    static void* TakeFromBlock(Block& block, size_t offset)
+    {
+        auto* data = block.Data.get() + offset;
+        auto* owner = &block;
+        std::memcpy(data - HeaderSize, &owner, HeaderSize);
+        block.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+        return data;
+    }
+
+    void* Allocate(size_t size, size_t alignment)
+    {
+        assert(alignment <= alignof(std::max_align_t));
+
+        auto& arena = GetThreadArena();
+        const auto frame = _frame.load(std::memory_order_relaxed);
+        if (arena.Frame != frame)
+        {
+            arena.Rewind();
+            arena.Frame = frame;
+        }
+        _arenaBytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (size > LargeAllocationSize)
+        {
+            const auto offset = AlignDataOffset(0, alignment);
+            arena.LargeBlocks.push_back(new Block(offset + size));
+            return TakeFromBlock(*arena.LargeBlocks.back(), offset);
+        }
+
+        if (arena.Current == nullptr || AlignDataOffset(arena.Offset, alignment) + size > BlockSize)
+        {
+            arena.NextBlock();
+        }
+        const auto offset = AlignDataOffset(arena.Offset, alignment);
+        arena.Offset = offset + size;
+        return TakeFromBlock(*arena.Current, offset);
+    }
+
+    void Release(void* ptr)
+    {
+        if (ptr == nullptr)
+            return;
+
+        // The block is only reused by its arena once every allocation from it has been released.
+        Block* owner;
+        std::memcpy(&owner, static_cast<uint8_t*>(ptr) - HeaderSize, HeaderSize);
+        owner->LiveAllocations.fetch_sub(1, std::memory_order_release);
+    }
+
+    void EndFrame()
+    {
+        const auto heapAllocations = _heapAllocations.load(std::memory_order_relaxed);
+        _lastFrameStats.HeapAllocations = heapAllocations - _heapAllocationsAtFrameEnd;
+        _lastFrameStats.ArenaBytes = _arenaBytes.exchange(0, std::memory_order_relaxed);
+        _lastFrameStats.ArenaBlocks = _arenaBlocks.exchange(0, std::memory_order_relaxed);
+        _heapAllocationsAtFrameEnd = heapAllocations;
+
+        _frame.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const FrameStats& GetLastFrameStats()
+    {
+        return _lastFrameStats;
+    }
+
+    uint64_t GetHeapAllocationCount()
+    {
+        return _heapAllocations.load(std::memory_order_relaxed);
+    }
+
+#ifdef ENABLE_ALLOCATION_COUNTING
+    static void* AllocateFromHeap(size_t size) noexcept
+    {
+        _heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        if (size == 0)
+            size = 1;
+
+        for (;;)
+        {
+            if (auto* ptr = std::malloc(size); ptr != nullptr)
+                return ptr;
+
+            auto handler = std::get_new_handler();
+            if (handler == nullptr)
+                return nullptr;
+            handler();
+        }
+    }
+#endif
+} // namespace OpenRCT2::FrameArena
+
+#ifdef ENABLE_ALLOCATION_COUNTING
+// The global allocation functions are replaced so the number of heap allocations per frame can be counted.
+void* operator new(size_t size)
+{
+    auto* ptr = OpenRCT2::FrameArena::AllocateFromHeap(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return OpenRCT2::FrameArena::AllocateFromHeap(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return OpenRCT2::FrameArena::AllocateFromHeap(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+#endif
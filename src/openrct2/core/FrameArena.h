@@ -0,0 +1,85 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OpenRCT2::FrameArena
+{
+    // Size of the blocks the arena takes memory from, larger allocations get their own block.
+    static constexpr size_t BlockSize = 64 * 1024;
+
+#ifdef ENABLE_ALLOCATION_COUNTING
+    // Whether the global allocation functions count heap allocations, which costs every allocation an atomic increment.
+    static constexpr bool CountsHeapAllocations = true;
+#else
+    static constexpr bool CountsHeapAllocations = false;
+#endif
+
+    struct FrameStats
+    {
+        // Heap allocations made by any thread between the end of the previous frame and the end of this one, only
+        // counted when CountsHeapAllocations is set.
+        uint64_t HeapAllocations{};
+        // Bytes handed out by the arenas of all threads during the frame.
+        uint64_t ArenaBytes{};
+        // Blocks the arenas had to allocate from the heap, zero once they have grown to the size of a frame.
+        uint32_t ArenaBlocks{};
+    };
+
+    /**
+     * Returns memory from the arena of the calling thread. The memory stays valid until it is released, which may
+     * happen on any thread. Once a frame has ended, an arena reuses the blocks that no longer have allocations alive,
+     * so memory held across a frame boundary only keeps its own block from being reused.
+     */
+    void* Allocate(size_t size, size_t alignment);
+    void Release(void* ptr);
+
+    // Called once per frame at the end of Context::RunFrame, which also runs in headless games.
+    void EndFrame();
+    const FrameStats& GetLastFrameStats();
+    uint64_t GetHeapAllocationCount();
+
+    template<typename T> class Allocator
+    {
+    public:
+        using value_type = T;
+
+        Allocator() noexcept = default;
+        template<typename U> Allocator(const Allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* ptr, size_t)
+        {
+            Release(ptr);
+        }
+
+        template<typename U> bool operator==(const Allocator<U>&) const noexcept
+        {
+            return true;
+        }
+        template<typename U> bool operator!=(const Allocator<U>&) const noexcept
+        {
+            return false;
+        }
+    };
+
+    using String = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
+    template<typename T> using Vector = std::vector<T, Allocator<T>>;
+} // namespace OpenRCT2::FrameArena
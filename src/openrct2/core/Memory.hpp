@@ -14,6 +14,7 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <new>
 #include <typeinfo>
 
 /**
@@ -86,4 +87,40 @@ namespace Memory
         }
         Free(ptr);
     }
+
+    // Allocator for containers whose storage has to start at an alignment larger than that of the element type.
+    template<typename T, size_t TAlignment> class AlignedAllocator
+    {
+    public:
+        using value_type = T;
+
+        template<typename U> struct rebind
+        {
+            using other = AlignedAllocator<U, TAlignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+        template<typename U> AlignedAllocator(const AlignedAllocator<U, TAlignment>&) noexcept
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(TAlignment)));
+        }
+
+        void deallocate(T* ptr, size_t)
+        {
+            ::operator delete(ptr, std::align_val_t(TAlignment));
+        }
+
+        template<typename U> bool operator==(const AlignedAllocator<U, TAlignment>&) const noexcept
+        {
+            return true;
+        }
+        template<typename U> bool operator!=(const AlignedAllocator<U, TAlignment>&) const noexcept
+        {
+            return false;
+        }
+    };
 } // namespace Memory
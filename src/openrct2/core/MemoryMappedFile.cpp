@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "IStream.hpp"
+#include "MemoryMappedFile.h"
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(u8string_view path)
+{
+    auto pathW = String::ToWideChar(path);
+    auto file = CreateFileW(
+        pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw IOException("Unable to open " + u8string(path));
+    }
+    _fileHandle = file;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        throw IOException("Unable to map " + u8string(path));
+    }
+
+    auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    auto* view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view == nullptr)
+    {
+        if (mapping != nullptr)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        throw IOException("Unable to map " + u8string(path));
+    }
+    _mappingHandle = mapping;
+    _data = static_cast<const uint8_t*>(view);
+    _length = static_cast<size_t>(size.QuadPart);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    UnmapViewOfFile(_data);
+    CloseHandle(_mappingHandle);
+    CloseHandle(_fileHandle);
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(u8string_view path)
+{
+    _fd = open(u8string(path).c_str(), O_RDONLY);
+    if (_fd == -1)
+    {
+        throw IOException("Unable to open " + u8string(path));
+    }
+
+    struct stat statInfo = {};
+    if (fstat(_fd, &statInfo) != 0 || statInfo.st_size == 0)
+    {
+        close(_fd);
+        throw IOException("Unable to map " + u8string(path));
+    }
+
+    auto* data = mmap(nullptr, static_cast<size_t>(statInfo.st_size), PROT_READ, MAP_SHARED, _fd, 0);
+    if (data == MAP_FAILED)
+    {
+        close(_fd);
+        throw IOException("Unable to map " + u8string(path));
+    }
+    _data = static_cast<const uint8_t*>(data);
+    _length = static_cast<size_t>(statInfo.st_size);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    munmap(const_cast<uint8_t*>(_data), _length);
+    close(_fd);
+}
+
+#endif
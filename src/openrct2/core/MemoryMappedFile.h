@@ -0,0 +1,49 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "String.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * A file mapped read-only into memory. The pages are shared with every other process that maps the same file.
+ */
+class MemoryMappedFile
+{
+private:
+    const uint8_t* _data{};
+    size_t _length{};
+#ifdef _WIN32
+    void* _fileHandle{};
+    void* _mappingHandle{};
+#else
+    int _fd = -1;
+#endif
+
+public:
+    // Throws IOException if the file can not be opened or mapped.
+    explicit MemoryMappedFile(u8string_view path);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    const uint8_t* GetData() const
+    {
+        return _data;
+    }
+
+    size_t GetLength() const
+    {
+        return _length;
+    }
+};
@@ -9,16 +9,19 @@
 
 #pragma once
 
+#include "../util/Util.h"
 #include "../world/Location.hpp"
 #include "Crypt.h"
 #include "FileStream.h"
 #include "Identifier.hpp"
+#include "Memory.hpp"
 #include "MemoryStream.h"
 
 #include <algorithm>
 #include <array>
 #include <cstdint>
 #include <fstream>
+#include <optional>
 #include <sstream>
 #include <stack>
 #include <type_traits>
@@ -37,6 +40,11 @@ namespace OpenRCT2
 
         static constexpr uint32_t COMPRESSION_NONE = 0;
         static constexpr uint32_t COMPRESSION_GZIP = 1;
+        // Independently deflated blocks of the chunk data, see ZlibCompressBlocks
+        static constexpr uint32_t COMPRESSION_ZLIB_BLOCKS = 2;
+
+        static constexpr size_t ZLIB_BLOCK_SIZE = 1024 * 1024;
+        static constexpr int32_t ZLIB_BLOCK_LEVEL = 1;
 
     private:
 #pragma pack(push, 1)
@@ -62,6 +70,76 @@ namespace OpenRCT2
         };
 #pragma pack(pop)
 
+    public:
+        /**
+         * Serialised chunks that have not been compressed and written to a stream yet.
+         */
+        class PendingWrite
+        {
+            friend class OrcaStream;
+
+        private:
+            Header _header{};
+            std::vector<ChunkEntry> _chunks;
+            MemoryStream _buffer;
+
+        public:
+            void SetCompression(uint32_t compression)
+            {
+                _header.Compression = compression;
+            }
+
+            void WriteTo(IStream& stream)
+            {
+                const void* uncompressedData = _buffer.GetData();
+                const uint64_t uncompressedSize = _buffer.GetLength();
+
+                _header.UncompressedSize = uncompressedSize;
+                _header.CompressedSize = uncompressedSize;
+                _header.FNV1a = Crypt::FNV1a(uncompressedData, uncompressedSize);
+
+                // Compress data
+                std::optional<std::vector<uint8_t>> compressedBytes;
+                if (_header.Compression == COMPRESSION_GZIP)
+                {
+                    compressedBytes = Gzip(uncompressedData, uncompressedSize);
+                }
+                else if (_header.Compression == COMPRESSION_ZLIB_BLOCKS)
+                {
+                    compressedBytes = ZlibCompressBlocks(
+                        uncompressedData, static_cast<size_t>(uncompressedSize), ZLIB_BLOCK_SIZE, ZLIB_BLOCK_LEVEL);
+                }
+
+                if (compressedBytes)
+                {
+                    _header.CompressedSize = compressedBytes->size();
+                }
+                else
+                {
+                    // Compression failed
+                    _header.Compression = COMPRESSION_NONE;
+                }
+
+                // Write header and chunk table
+                stream.WriteValue(_header);
+                for (const auto& chunk : _chunks)
+                {
+                    stream.WriteValue(chunk);
+                }
+
+                // Write chunk data
+                if (compressedBytes)
+                {
+                    stream.Write(compressedBytes->data(), compressedBytes->size());
+                }
+                else
+                {
+                    stream.Write(uncompressedData, uncompressedSize);
+                }
+            }
+        };
+
+    private:
         IStream* _stream;
         Mode _mode;
         Header _header;
@@ -85,29 +163,38 @@ namespace OpenRCT2
                     _chunks.push_back(entry);
                 }
 
-                // Read compressed data into buffer (read in blocks)
-                _buffer = MemoryStream{};
-                uint8_t temp[2048];
-                uint64_t bytesLeft = _header.CompressedSize;
-                do
+                // Read the chunk data straight into a buffer of the final size, inflating
+                // it as it is read when compressed
+                const auto uncompressedSize = static_cast<size_t>(_header.UncompressedSize);
+                if (_header.Compression == COMPRESSION_ZLIB_BLOCKS)
                 {
-                    auto readLen = std::min(size_t(bytesLeft), sizeof(temp));
-                    _stream->Read(temp, readLen);
-                    _buffer.Write(temp, readLen);
-                    bytesLeft -= readLen;
-                } while (bytesLeft > 0);
-
-                // Uncompress
-                if (_header.Compression == COMPRESSION_GZIP)
+                    auto* data = Memory::Allocate<uint8_t>(uncompressedSize);
+                    _buffer = MemoryStream(data, uncompressedSize, MEMORY_ACCESS::READ | MEMORY_ACCESS::OWNER);
+                    ZlibDecompressBlocks(*_stream, _header.CompressedSize, data, uncompressedSize);
+                }
+                else if (_header.Compression == COMPRESSION_GZIP)
                 {
-                    auto uncompressedData = Ungzip(_buffer.GetData(), _buffer.GetLength());
-                    if (_header.UncompressedSize != uncompressedData.size())
+                    _buffer = MemoryStream(uncompressedSize);
+                    Ungzip(*_stream, _header.CompressedSize, _buffer);
+                    if (_header.UncompressedSize != _buffer.GetLength())
                     {
                         // Warning?
                     }
-                    _buffer.Clear();
-                    _buffer.Write(uncompressedData.data(), uncompressedData.size());
                 }
+                else
+                {
+                    _buffer = MemoryStream(uncompressedSize);
+                    uint8_t temp[2048];
+                    uint64_t bytesLeft = _header.CompressedSize;
+                    do
+                    {
+                        auto readLen = std::min(size_t(bytesLeft), sizeof(temp));
+                        _stream->Read(temp, readLen);
+                        _buffer.Write(temp, readLen);
+                        bytesLeft -= readLen;
+                    } while (bytesLeft > 0);
+                }
+                _buffer.SetPosition(0);
             }
             else
             {
@@ -118,55 +205,45 @@ namespace OpenRCT2
             }
         }
 
+        /**
+         * Creates a stream for writing whose chunks are only taken with Detach.
+         */
+        OrcaStream()
+            : _stream(nullptr)
+            , _mode(Mode::WRITING)
+        {
+            _header = {};
+            _header.Compression = COMPRESSION_GZIP;
+        }
+
         OrcaStream(const OrcaStream&) = delete;
 
         ~OrcaStream()
         {
-            if (_mode == Mode::WRITING)
+            if (_mode == Mode::WRITING && _stream != nullptr)
             {
-                const void* uncompressedData = _buffer.GetData();
-                const uint64_t uncompressedSize = _buffer.GetLength();
-
-                _header.NumChunks = static_cast<uint32_t>(_chunks.size());
-                _header.UncompressedSize = uncompressedSize;
-                _header.CompressedSize = uncompressedSize;
-                _header.FNV1a = Crypt::FNV1a(uncompressedData, uncompressedSize);
-
-                // Compress data
-                std::optional<std::vector<uint8_t>> compressedBytes;
-                if (_header.Compression == COMPRESSION_GZIP)
-                {
-                    compressedBytes = Gzip(uncompressedData, uncompressedSize);
-                    if (compressedBytes)
-                    {
-                        _header.CompressedSize = compressedBytes->size();
-                    }
-                    else
-                    {
-                        // Compression failed
-                        _header.Compression = COMPRESSION_NONE;
-                    }
-                }
-
-                // Write header and chunk table
-                _stream->WriteValue(_header);
-                for (const auto& chunk : _chunks)
-                {
-                    _stream->WriteValue(chunk);
-                }
-
-                // Write chunk data
-                if (compressedBytes)
-                {
-                    _stream->Write(compressedBytes->data(), compressedBytes->size());
-                }
-                else
-                {
-                    _stream->Write(uncompressedData, uncompressedSize);
-                }
+                Detach().WriteTo(*_stream);
             }
         }
 
+        /**
+         * Takes the chunks written so far. The returned data no longer refers to the game state or to
+         * the output stream, so it can be compressed and written out on another thread. Nothing is
+         * written to the stream when this OrcaStream is destroyed.
+         */
+        PendingWrite Detach()
+        {
+            PendingWrite result;
+            result._header = _header;
+            result._header.NumChunks = static_cast<uint32_t>(_chunks.size());
+            result._chunks = std::move(_chunks);
+            result._buffer = std::move(_buffer);
+            _chunks = {};
+            _buffer = MemoryStream{};
+            _stream = nullptr;
+            return result;
+        }
+
         Mode GetMode() const
         {
             return _mode;
@@ -206,10 +283,40 @@ namespace OpenRCT2
             return true;
         }
 
+        /**
+         * Reads a chunk through a private view of the uncompressed data rather than the shared
+         * buffer position, so that the chunk can be decoded on another thread while other chunks
+         * are read with ReadWriteChunk.
+         */
+        template<typename TFunc> bool ReadChunkDetached(const uint32_t chunkId, TFunc f) const
+        {
+            if (_mode != Mode::READING)
+            {
+                return false;
+            }
+
+            const auto result = FindChunk(chunkId);
+            if (result == _chunks.end() || result->Offset > _buffer.GetLength())
+            {
+                return false;
+            }
+
+            const auto* data = static_cast<const uint8_t*>(_buffer.GetData());
+            MemoryStream view(data + result->Offset, static_cast<size_t>(_buffer.GetLength() - result->Offset));
+            ChunkStream stream(view, Mode::READING);
+            f(stream);
+            return true;
+        }
+
     private:
+        std::vector<ChunkEntry>::const_iterator FindChunk(const uint32_t id) const
+        {
+            return std::find_if(_chunks.begin(), _chunks.end(), [id](const ChunkEntry& e) { return e.Id == id; });
+        }
+
         bool SeekChunk(const uint32_t id)
         {
-            const auto result = std::find_if(_chunks.begin(), _chunks.end(), [id](const ChunkEntry& e) { return e.Id == id; });
+            const auto result = FindChunk(id);
             if (result != _chunks.end())
             {
                 const auto offset = result->Offset;
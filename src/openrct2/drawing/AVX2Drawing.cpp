@@ -42,6 +42,128 @@ void MaskAvx2(
     }
 }
 
+// A 256 entry lookup split into 16 tables of 16 entries, each one indexed with pshufb. Adding 0x70 with saturation
+// sets the high bit of every index outside the current table, which makes pshufb return 0 for it. The tables are
+// broadcast to both lanes as vpshufb only shuffles within a lane.
+struct LookupTables256
+{
+    __m256i Tables[16];
+
+    explicit LookupTables256(const uint8_t* map)
+    {
+        for (int32_t k = 0; k < 16; k++)
+        {
+            Tables[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(map + k * 16)));
+        }
+    }
+
+    __m256i Lookup(__m256i indices) const
+    {
+        const __m256i bias = _mm256_set1_epi8(0x70);
+        const __m256i step = _mm256_set1_epi8(0x10);
+        __m256i result = _mm256_setzero_si256();
+        for (int32_t k = 0; k < 16; k++)
+        {
+            result = _mm256_or_si256(result, _mm256_shuffle_epi8(Tables[k], _mm256_adds_epu8(indices, bias)));
+            indices = _mm256_sub_epi8(indices, step);
+        }
+        return result;
+    }
+};
+
+static void RLECopyAvx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    int32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i colour = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i blended = _mm256_blendv_epi8(colour, dest, _mm256_cmpeq_epi8(colour, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), blended);
+    }
+    GetRLEBlitKernelsSse4_1().Copy(src + i, dst + i, count - i);
+}
+
+static void RLERemapAvx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map)
+{
+    int32_t i = 0;
+    if (count >= 32)
+    {
+        const LookupTables256 tables(map);
+        const __m256i zero = _mm256_setzero_si256();
+        for (; i + 32 <= count; i += 32)
+        {
+            const __m256i colour = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+            const __m256i pixels = tables.Lookup(colour);
+            const __m256i skip = _mm256_or_si256(_mm256_cmpeq_epi8(colour, zero), _mm256_cmpeq_epi8(pixels, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(pixels, dest, skip));
+        }
+    }
+    GetRLEBlitKernelsSse4_1().Remap(src + i, dst + i, count - i, map);
+}
+
+static void RLERemapDstAvx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map)
+{
+    int32_t i = 0;
+    if (count >= 32)
+    {
+        const LookupTables256 tables(map);
+        const __m256i zero = _mm256_setzero_si256();
+        for (; i + 32 <= count; i += 32)
+        {
+            const __m256i colour = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+            const __m256i pixels = tables.Lookup(dest);
+            const __m256i skip = _mm256_or_si256(_mm256_cmpeq_epi8(colour, zero), _mm256_cmpeq_epi8(pixels, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(pixels, dest, skip));
+        }
+    }
+    GetRLEBlitKernelsSse4_1().RemapDst(src + i, dst + i, count - i, map);
+}
+
+static void RLESampleAvx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, int32_t stride)
+{
+    // Packing works within each lane, so the result is permuted back into order afterwards. The last vector would
+    // read past the (count - 1) * stride + 1 pixels of the source so it is left to the narrower loops.
+    int32_t i = 0;
+    if (stride == 2)
+    {
+        const __m256i lowBytes = _mm256_set1_epi16(0x00FF);
+        for (; i + 33 <= count; i += 32)
+        {
+            auto in = reinterpret_cast<const __m256i*>(src + i * 2);
+            const __m256i a = _mm256_and_si256(_mm256_loadu_si256(in), lowBytes);
+            const __m256i b = _mm256_and_si256(_mm256_loadu_si256(in + 1), lowBytes);
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+        }
+    }
+    else if (stride == 4)
+    {
+        const __m256i lowBytes = _mm256_set1_epi32(0x000000FF);
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        for (; i + 33 <= count; i += 32)
+        {
+            auto in = reinterpret_cast<const __m256i*>(src + i * 4);
+            const __m256i a = _mm256_and_si256(_mm256_loadu_si256(in), lowBytes);
+            const __m256i b = _mm256_and_si256(_mm256_loadu_si256(in + 1), lowBytes);
+            const __m256i c = _mm256_and_si256(_mm256_loadu_si256(in + 2), lowBytes);
+            const __m256i d = _mm256_and_si256(_mm256_loadu_si256(in + 3), lowBytes);
+            const __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(a, b), _mm256_packus_epi32(c, d));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permutevar8x32_epi32(packed, order));
+        }
+    }
+    GetRLEBlitKernelsSse4_1().Sample(src + i * stride, dst + i, count - i, stride);
+}
+
+const RLEBlitKernels& GetRLEBlitKernelsAvx2()
+{
+    static constexpr RLEBlitKernels kernels = { "avx2", RLECopyAvx2, RLERemapAvx2, RLERemapDstAvx2, RLESampleAvx2 };
+    return kernels;
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +177,10 @@ void MaskAvx2(
     Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+const RLEBlitKernels& GetRLEBlitKernelsAvx2()
+{
+    Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
+    return GetRLEBlitKernelsScalar();
+}
+
 #endif // __AVX2__
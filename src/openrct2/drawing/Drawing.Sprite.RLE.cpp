@@ -12,6 +12,55 @@
 #include <algorithm>
 #include <cstring>
 
+static void RLECopyScalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] != 0)
+            dst[i] = src[i];
+    }
+}
+
+static void RLERemapScalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] != 0)
+        {
+            auto pixel = map[src[i]];
+            if (pixel != 0)
+                dst[i] = pixel;
+        }
+    }
+}
+
+static void RLERemapDstScalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (src[i] != 0)
+        {
+            auto pixel = map[dst[i]];
+            if (pixel != 0)
+                dst[i] = pixel;
+        }
+    }
+}
+
+static void RLESampleScalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, int32_t stride)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        dst[i] = src[i * stride];
+    }
+}
+
+const RLEBlitKernels& GetRLEBlitKernelsScalar()
+{
+    static constexpr RLEBlitKernels kernels = { "scalar", RLECopyScalar, RLERemapScalar, RLERemapDstScalar, RLESampleScalar };
+    return kernels;
+}
+
 template<DrawBlendOp TBlendOp, size_t TZoom>
 static void FASTCALL DrawRLESpriteMagnify(DrawPixelInfo& dpi, const DrawSpriteArgs& args)
 {
@@ -94,6 +143,10 @@ static void FASTCALL DrawRLESpriteMinify(DrawPixelInfo& dpi, const DrawSpriteArg
     auto height = args.Height;
     auto zoom = 1 << TZoom;
     auto dstLineWidth = (static_cast<size_t>(dpi.width) >> TZoom) + dpi.pitch;
+    const auto& kernels = GetRLEBlitKernels();
+    const auto* lookupTable = args.PalMap.GetLookupTable();
+    constexpr bool remaps = (TBlendOp & (BLEND_SRC | BLEND_DST)) != 0;
+    constexpr bool blendsPair = (TBlendOp & BLEND_SRC) != 0 && (TBlendOp & BLEND_DST) != 0;
 
     // Move up to the first line of the image if source_y_start is negative. Why does this even occur?
     if (srcY < 0)
@@ -163,8 +216,38 @@ static void FASTCALL DrawRLESpriteMinify(DrawPixelInfo& dpi, const DrawSpriteArg
                     std::memcpy(dst, src, numPixels);
                 }
             }
+            else if (!blendsPair && (lookupTable != nullptr || !remaps))
+            {
+                if (numPixels <= 0)
+                    continue;
+
+                // Runs are at most 127 pixels, zoomed out runs are gathered into a contiguous buffer first
+                auto samples = src;
+                auto count = numPixels;
+                uint8_t sampleBuffer[128];
+                if constexpr (TZoom > 0)
+                {
+                    count = (numPixels + zoom - 1) >> TZoom;
+                    kernels.Sample(src, sampleBuffer, count, zoom);
+                    samples = sampleBuffer;
+                }
+
+                if constexpr ((TBlendOp & BLEND_SRC) != 0)
+                {
+                    kernels.Remap(samples, dst, count, lookupTable);
+                }
+                else if constexpr ((TBlendOp & BLEND_DST) != 0)
+                {
+                    kernels.RemapDst(samples, dst, count, lookupTable);
+                }
+                else
+                {
+                    kernels.Copy(samples, dst, count);
+                }
+            }
             else
             {
+                // Blending looks up a pair of pixels, that and maps shorter than a palette stay per pixel
                 auto& paletteMap = args.PalMap;
                 while (numPixels > 0)
                 {
@@ -21,6 +21,7 @@
 #include "../ui/UiContext.h"
 #include "../util/Util.h"
 #include "ScrollingText.h"
+#include "SpriteCache.h"
 
 #include <algorithm>
 #include <memory>
@@ -243,6 +244,7 @@ bool GfxLoadG1(const IPlatformEnvironment& env)
 
 void GfxUnloadG1()
 {
+    Drawing::SpriteCache::Clear();
     _g1.data.reset();
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
@@ -250,6 +252,7 @@ void GfxUnloadG1()
 
 void GfxUnloadG2()
 {
+    Drawing::SpriteCache::Clear();
     _g2.data.reset();
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
@@ -257,6 +260,7 @@ void GfxUnloadG2()
 
 void GfxUnloadCsg()
 {
+    Drawing::SpriteCache::Clear();
     _csg.data.reset();
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
@@ -444,16 +448,47 @@ static std::optional<PaletteMap> FASTCALL GfxDrawSpriteGetPalette(ImageId imageI
     return paletteMap;
 }
 
-void FASTCALL GfxDrawSpriteSoftware(DrawPixelInfo& dpi, const ImageId imageId, const ScreenCoordsXY& spriteCoords)
+/**
+ * Draws a sprite with the palette of its image id, which lets the sprite cache hold the sprite already decoded and
+ * remapped. The palette is only built when the sprite is not drawn from the cache.
+ */
+static void FASTCALL GfxDrawSpriteWithImagePalette(
+    DrawPixelInfo& dpi, const ImageId imageId, const G1Element& g1, int32_t srcX, int32_t srcY, int32_t width,
+    int32_t height, uint8_t* dst)
 {
-    if (imageId.HasValue())
+    if (Drawing::SpriteCache::IsCacheable(imageId, g1, dpi.zoom_level))
     {
-        auto palette = GfxDrawSpriteGetPalette(imageId);
-        if (!palette)
+        const auto key = Drawing::SpriteCache::CreateKey(imageId, dpi.zoom_level, srcX, srcY);
+        auto raster = Drawing::SpriteCache::Find(key);
+        if (raster == nullptr)
         {
-            palette = PaletteMap::GetDefault();
+            auto palette = imageId.HasPrimary() ? GfxDrawSpriteGetPalette(imageId) : std::nullopt;
+            raster = Drawing::SpriteCache::Insert(key, g1, palette ? &palette.value() : nullptr);
+        }
+        if (raster != nullptr)
+        {
+            Drawing::SpriteCache::Draw(*raster, dpi, srcX, srcY, width, height, dst);
+            return;
         }
-        GfxDrawSpritePaletteSetSoftware(dpi, imageId, spriteCoords, *palette);
+    }
+
+    auto palette = GfxDrawSpriteGetPalette(imageId);
+    if (!palette)
+    {
+        palette = PaletteMap::GetDefault();
+    }
+    DrawSpriteArgs args(imageId, *palette, g1, srcX, srcY, width, height, dst);
+    GfxSpriteToBuffer(dpi, args);
+}
+
+static void FASTCALL GfxDrawSpriteClipped(
+    DrawPixelInfo& dpi, const ImageId imageId, const ScreenCoordsXY& coords, const PaletteMap* paletteMap);
+
+void FASTCALL GfxDrawSpriteSoftware(DrawPixelInfo& dpi, const ImageId imageId, const ScreenCoordsXY& spriteCoords)
+{
+    if (imageId.HasValue())
+    {
+        GfxDrawSpriteClipped(dpi, imageId, spriteCoords, nullptr);
     }
 }
 
@@ -468,6 +503,13 @@ void FASTCALL GfxDrawSpriteSoftware(DrawPixelInfo& dpi, const ImageId imageId, c
  */
 void FASTCALL GfxDrawSpritePaletteSetSoftware(
     DrawPixelInfo& dpi, const ImageId imageId, const ScreenCoordsXY& coords, const PaletteMap& paletteMap)
+{
+    GfxDrawSpriteClipped(dpi, imageId, coords, &paletteMap);
+}
+
+// Draws the sprite with the given palette map, or with the palette of the image id if it is nullptr.
+static void FASTCALL GfxDrawSpriteClipped(
+    DrawPixelInfo& dpi, const ImageId imageId, const ScreenCoordsXY& coords, const PaletteMap* paletteMap)
 {
     int32_t x = coords.x;
     int32_t y = coords.y;
@@ -490,7 +532,7 @@ void FASTCALL GfxDrawSpritePaletteSetSoftware(
         zoomed_dpi.zoom_level = dpi.zoom_level - 1;
 
         const auto spriteCoords = ScreenCoordsXY{ x >> 1, y >> 1 };
-        GfxDrawSpritePaletteSetSoftware(
+        GfxDrawSpriteClipped(
             zoomed_dpi, imageId.WithIndex(imageId.GetIndex() - g1->zoomed_offset), spriteCoords, paletteMap);
         return;
     }
@@ -616,7 +658,13 @@ void FASTCALL GfxDrawSpritePaletteSetSoftware(
     // Move the pointer to the start point of the destination
     dest_pointer += (zoom_level.ApplyInversedTo(dpi.width) + dpi.pitch) * dest_start_y + dest_start_x;
 
-    DrawSpriteArgs args(imageId, paletteMap, *g1, source_start_x, source_start_y, width, height, dest_pointer);
+    if (paletteMap == nullptr)
+    {
+        GfxDrawSpriteWithImagePalette(dpi, imageId, *g1, source_start_x, source_start_y, width, height, dest_pointer);
+        return;
+    }
+
+    DrawSpriteArgs args(imageId, *paletteMap, *g1, source_start_x, source_start_y, width, height, dest_pointer);
     GfxSpriteToBuffer(dpi, args);
 }
 
@@ -775,6 +823,7 @@ void GfxSetG1Element(ImageIndex imageId, const G1Element* g1)
 
     if (g1 != nullptr)
     {
+        Drawing::SpriteCache::InvalidateImage(imageId);
         if (isTemp)
         {
             _g1Temp = *g1;
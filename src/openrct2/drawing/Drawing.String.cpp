@@ -48,7 +48,7 @@ static int32_t TTFGetStringWidth(std::string_view text, FontStyle fontStyle, boo
  */
 int32_t GfxGetStringWidthNewLined(std::string_view text, FontStyle fontStyle)
 {
-    u8string buffer;
+    FrameArena::String buffer;
 
     std::optional<int32_t> maxWidth;
     FmtString fmt(text);
@@ -173,10 +173,11 @@ int32_t GfxClipString(utf8* text, int32_t width, FontStyle fontStyle)
  * num_lines (edi) - out
  * font_height (ebx) - out
  */
-int32_t GfxWrapString(u8string_view text, int32_t width, FontStyle fontStyle, u8string* outWrappedText, int32_t* outNumLines)
+template<typename TString>
+static int32_t GfxWrapStringToBuffer(
+    u8string_view text, int32_t width, FontStyle fontStyle, TString& buffer, int32_t* outNumLines)
 {
     constexpr size_t NULL_INDEX = std::numeric_limits<size_t>::max();
-    u8string buffer;
 
     size_t currentLineIndex = 0;
     size_t splitIndex = NULL_INDEX;
@@ -259,10 +260,6 @@ int32_t GfxWrapString(u8string_view text, int32_t width, FontStyle fontStyle, u8
         maxWidth = std::max(maxWidth, lineWidth);
     }
 
-    if (outWrappedText != nullptr)
-    {
-        *outWrappedText = std::move(buffer);
-    }
     if (outNumLines != nullptr)
     {
         *outNumLines = static_cast<int32_t>(numLines);
@@ -270,6 +267,27 @@ int32_t GfxWrapString(u8string_view text, int32_t width, FontStyle fontStyle, u8
     return maxWidth;
 }
 
+int32_t GfxWrapString(u8string_view text, int32_t width, FontStyle fontStyle, u8string* outWrappedText, int32_t* outNumLines)
+{
+    // The text may point into outWrappedText so it can only be replaced once wrapping has finished.
+    u8string buffer;
+    auto maxWidth = GfxWrapStringToBuffer(text, width, fontStyle, buffer, outNumLines);
+    if (outWrappedText != nullptr)
+    {
+        *outWrappedText = std::move(buffer);
+    }
+    return maxWidth;
+}
+
+int32_t GfxWrapString(
+    u8string_view text, int32_t width, FontStyle fontStyle, FrameArena::String& outWrappedText, int32_t* outNumLines)
+{
+    FrameArena::String buffer;
+    auto maxWidth = GfxWrapStringToBuffer(text, width, fontStyle, buffer, outNumLines);
+    outWrappedText = std::move(buffer);
+    return maxWidth;
+}
+
 /**
  * Draws text that is left aligned and vertically centred.
  */
@@ -441,8 +459,8 @@ void DrawNewsTicker(
 
     GfxDrawString(dpi, screenCoords, "", { colour });
 
-    u8string wrappedString;
-    GfxWrapString(FormatStringID(format, args), width, FontStyle::Small, &wrappedString, &numLines);
+    FrameArena::String wrappedString;
+    GfxWrapString(FormatStringID(format, args), width, FontStyle::Small, wrappedString, &numLines);
     lineHeight = FontGetLineHeight(FontStyle::Small);
 
     int32_t numCharactersDrawn = 0;
@@ -737,6 +737,37 @@ void MaskFn(
     MaskFunc(width, height, maskSrc, colourSrc, dst, maskWrap, colourWrap, dstWrap);
 }
 
+static const RLEBlitKernels& SelectRLEBlitKernels()
+{
+    if (AVX2Available())
+    {
+        LOG_VERBOSE("registering AVX2 RLE blit kernels");
+        return GetRLEBlitKernelsAvx2();
+    }
+    else if (SSE41Available())
+    {
+        LOG_VERBOSE("registering SSE4.1 RLE blit kernels");
+        return GetRLEBlitKernelsSse4_1();
+    }
+    else
+    {
+        LOG_VERBOSE("registering scalar RLE blit kernels");
+        return GetRLEBlitKernelsScalar();
+    }
+}
+
+static const RLEBlitKernels* _rleBlitKernels = &SelectRLEBlitKernels();
+
+const RLEBlitKernels& GetRLEBlitKernels()
+{
+    return *_rleBlitKernels;
+}
+
+void SetRLEBlitKernels(const RLEBlitKernels& kernels)
+{
+    _rleBlitKernels = &kernels;
+}
+
 void GfxFilterPixel(DrawPixelInfo& dpi, const ScreenCoordsXY& coords, FilterPaletteID palette)
 {
     GfxFilterRect(dpi, { coords, coords }, palette);
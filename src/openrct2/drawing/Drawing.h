@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../common.h"
+#include "../core/FrameArena.h"
 #include "../core/String.hpp"
 #include "../interface/Colour.h"
 #include "../interface/ZoomLevel.h"
@@ -378,6 +379,12 @@ public:
     uint8_t operator[](size_t index) const;
     uint8_t Blend(uint8_t src, uint8_t dst) const;
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
+
+    // The first map as a 256 entry lookup table, nullptr if the map is too short to be indexed by any pixel.
+    const uint8_t* GetLookupTable() const
+    {
+        return _dataLength >= 256 ? _data : nullptr;
+    }
 };
 
 struct DrawSpriteArgs
@@ -567,6 +574,8 @@ void GfxDrawStringWithYOffsets(
     bool forceSpriteFont, FontStyle fontStyle);
 
 int32_t GfxWrapString(u8string_view text, int32_t width, FontStyle fontStyle, u8string* outWrappedText, int32_t* outNumLines);
+int32_t GfxWrapString(
+    u8string_view text, int32_t width, FontStyle fontStyle, OpenRCT2::FrameArena::String& outWrappedText, int32_t* outNumLines);
 int32_t GfxGetStringWidth(std::string_view text, FontStyle fontStyle);
 int32_t GfxGetStringWidthNewLined(std::string_view text, FontStyle fontStyle);
 int32_t GfxGetStringWidthNoFormatting(std::string_view text, FontStyle fontStyle);
@@ -602,6 +611,31 @@ void MaskFn(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+/**
+ * Kernels for drawing a single run of an RLE sprite. Destination pixels are left untouched where the source pixel is 0
+ * or where the palette map gives 0, the same as BlitPixel with BLEND_TRANSPARENT.
+ */
+struct RLEBlitKernels
+{
+    const char* Name;
+    // dst = src
+    void (*Copy)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count);
+    // dst = map[src]
+    void (*Remap)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map);
+    // dst = map[dst]
+    void (*RemapDst)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map);
+    // Takes every stride-th pixel of src for zoomed out drawing, src must hold (count - 1) * stride + 1 pixels.
+    void (*Sample)(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, int32_t stride);
+};
+
+const RLEBlitKernels& GetRLEBlitKernelsScalar();
+const RLEBlitKernels& GetRLEBlitKernelsSse4_1();
+const RLEBlitKernels& GetRLEBlitKernelsAvx2();
+
+// The kernels used by GfxRleSpriteToBuffer, the fastest ones the CPU supports unless changed for benchmarking.
+const RLEBlitKernels& GetRLEBlitKernels();
+void SetRLEBlitKernels(const RLEBlitKernels& kernels);
+
 std::optional<uint32_t> GetPaletteG1Index(colour_t paletteId);
 std::optional<PaletteMap> GetPaletteMapForColour(colour_t paletteId);
 void UpdatePalette(const uint8_t* colours, int32_t start_index, int32_t num_colours);
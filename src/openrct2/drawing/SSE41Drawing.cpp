@@ -56,6 +56,126 @@ void MaskSse4_1(
     }
 }
 
+// A 256 entry lookup split into 16 tables of 16 entries, each one indexed with pshufb. Adding 0x70 with saturation
+// sets the high bit of every index outside the current table, which makes pshufb return 0 for it.
+struct LookupTables128
+{
+    __m128i Tables[16];
+
+    explicit LookupTables128(const uint8_t* map)
+    {
+        for (int32_t k = 0; k < 16; k++)
+        {
+            Tables[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(map + k * 16));
+        }
+    }
+
+    __m128i Lookup(__m128i indices) const
+    {
+        const __m128i bias = _mm_set1_epi8(0x70);
+        const __m128i step = _mm_set1_epi8(0x10);
+        __m128i result = _mm_setzero_si128();
+        for (int32_t k = 0; k < 16; k++)
+        {
+            result = _mm_or_si128(result, _mm_shuffle_epi8(Tables[k], _mm_adds_epu8(indices, bias)));
+            indices = _mm_sub_epi8(indices, step);
+        }
+        return result;
+    }
+};
+
+static void RLECopySse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i colour = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i blended = _mm_blendv_epi8(colour, dest, _mm_cmpeq_epi8(colour, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), blended);
+    }
+    GetRLEBlitKernelsScalar().Copy(src + i, dst + i, count - i);
+}
+
+static void RLERemapSse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map)
+{
+    int32_t i = 0;
+    if (count >= 16)
+    {
+        const LookupTables128 tables(map);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i colour = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            const __m128i pixels = tables.Lookup(colour);
+            const __m128i skip = _mm_or_si128(_mm_cmpeq_epi8(colour, zero), _mm_cmpeq_epi8(pixels, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(pixels, dest, skip));
+        }
+    }
+    GetRLEBlitKernelsScalar().Remap(src + i, dst + i, count - i, map);
+}
+
+static void RLERemapDstSse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const uint8_t* RESTRICT map)
+{
+    int32_t i = 0;
+    if (count >= 16)
+    {
+        const LookupTables128 tables(map);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i colour = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            const __m128i pixels = tables.Lookup(dest);
+            const __m128i skip = _mm_or_si128(_mm_cmpeq_epi8(colour, zero), _mm_cmpeq_epi8(pixels, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(pixels, dest, skip));
+        }
+    }
+    GetRLEBlitKernelsScalar().RemapDst(src + i, dst + i, count - i, map);
+}
+
+static void RLESampleSse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, int32_t stride)
+{
+    // The low byte of every 16 or 32 bit element is kept and packed down, the last vector would read past the
+    // (count - 1) * stride + 1 pixels of the source so it is left to the scalar loop.
+    int32_t i = 0;
+    if (stride == 2)
+    {
+        const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+        for (; i + 17 <= count; i += 16)
+        {
+            auto in = reinterpret_cast<const __m128i*>(src + i * 2);
+            const __m128i a = _mm_and_si128(_mm_loadu_si128(in), lowBytes);
+            const __m128i b = _mm_and_si128(_mm_loadu_si128(in + 1), lowBytes);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, b));
+        }
+    }
+    else if (stride == 4)
+    {
+        const __m128i lowBytes = _mm_set1_epi32(0x000000FF);
+        for (; i + 17 <= count; i += 16)
+        {
+            auto in = reinterpret_cast<const __m128i*>(src + i * 4);
+            const __m128i a = _mm_and_si128(_mm_loadu_si128(in), lowBytes);
+            const __m128i b = _mm_and_si128(_mm_loadu_si128(in + 1), lowBytes);
+            const __m128i c = _mm_and_si128(_mm_loadu_si128(in + 2), lowBytes);
+            const __m128i d = _mm_and_si128(_mm_loadu_si128(in + 3), lowBytes);
+            const __m128i packed = _mm_packus_epi16(_mm_packus_epi32(a, b), _mm_packus_epi32(c, d));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+    }
+    GetRLEBlitKernelsScalar().Sample(src + i * stride, dst + i, count - i, stride);
+}
+
+const RLEBlitKernels& GetRLEBlitKernelsSse4_1()
+{
+    static constexpr RLEBlitKernels kernels = { "sse4.1", RLECopySse4_1, RLERemapSse4_1, RLERemapDstSse4_1,
+                                                RLESampleSse4_1 };
+    return kernels;
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +189,10 @@ void MaskSse4_1(
     Guard::Fail("SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+const RLEBlitKernels& GetRLEBlitKernelsSse4_1()
+{
+    Guard::Fail("SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return GetRLEBlitKernelsScalar();
+}
+
 #endif // __SSE4_1__
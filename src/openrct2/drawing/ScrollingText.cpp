@@ -22,30 +22,155 @@
 #include "TTF.h"
 
 #include <algorithm>
+#include <array>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 using namespace OpenRCT2;
 
-struct DrawScrollText
+// Number of rows a column of scrolling text covers.
+static constexpr int32_t ScrollingTextRows = 8;
+
+// Identifies the text shown by a scrolling text sprite, regardless of how far it has scrolled.
+struct ScrollTextString
 {
     StringId string_id;
     uint8_t string_args[32];
     colour_t colour;
+    bool upper_case;
+    bool true_type;
+
+    bool operator==(const ScrollTextString& other) const
+    {
+        return string_id == other.string_id && colour == other.colour && upper_case == other.upper_case
+            && true_type == other.true_type && std::memcmp(string_args, other.string_args, sizeof(string_args)) == 0;
+    }
+};
+
+struct ScrollTextKey
+{
+    ScrollTextString text;
     uint16_t position;
     uint16_t mode;
-    uint32_t id;
+
+    bool operator==(const ScrollTextKey& other) const
+    {
+        return text == other.text && position == other.position && mode == other.mode;
+    }
+};
+
+struct ScrollTextHash
+{
+    template<typename T> static uint64_t Combine(uint64_t hash, const T* data, size_t len)
+    {
+        // FNV-1a
+        auto bytes = reinterpret_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; i++)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    size_t operator()(const ScrollTextString& text) const
+    {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+        hash = Combine(hash, &text.string_id, sizeof(text.string_id));
+        hash = Combine(hash, text.string_args, sizeof(text.string_args));
+        hash = Combine(hash, &text.colour, sizeof(text.colour));
+        hash = Combine(hash, &text.upper_case, sizeof(text.upper_case));
+        hash = Combine(hash, &text.true_type, sizeof(text.true_type));
+        return static_cast<size_t>(hash);
+    }
+
+    size_t operator()(const ScrollTextKey& key) const
+    {
+        uint64_t hash = (*this)(key.text);
+        hash = Combine(hash, &key.position, sizeof(key.position));
+        hash = Combine(hash, &key.mode, sizeof(key.mode));
+        return static_cast<size_t>(hash);
+    }
+};
+
+/**
+ * A string rasterised once at its full length, ScrollingTextRows palette indices per column with 0 being
+ * transparent. The sprite for each scroll position is copied out of the strip at an offset.
+ */
+struct ScrollTextStrip
+{
+    std::vector<uint8_t> pixels;
+    // How many times the columns are shown before the text ends, 0 to repeat them forever.
+    int32_t repeats;
+
+    uint8_t* AddColumn()
+    {
+        pixels.resize(pixels.size() + ScrollingTextRows);
+        return &pixels[pixels.size() - ScrollingTextRows];
+    }
+};
+
+struct DrawScrollText
+{
+    ScrollTextKey key;
+    bool in_use;
     uint8_t bitmap[64 * 40];
 };
 
+// Least recently used order of the scrolling text sprites so the oldest one can be reused without a search.
+class ScrollTextLru
+{
+private:
+    std::array<int32_t, MaxScrollingTextEntries> _prev;
+    std::array<int32_t, MaxScrollingTextEntries> _next;
+    int32_t _newest = 0;
+    int32_t _oldest = MaxScrollingTextEntries - 1;
+
+public:
+    ScrollTextLru()
+    {
+        for (int32_t i = 0; i < MaxScrollingTextEntries; i++)
+        {
+            _prev[i] = i - 1;
+            _next[i] = i + 1 < MaxScrollingTextEntries ? i + 1 : -1;
+        }
+    }
+
+    int32_t GetOldest() const
+    {
+        return _oldest;
+    }
+
+    void Touch(int32_t index)
+    {
+        if (index == _newest)
+            return;
+
+        _next[_prev[index]] = _next[index];
+        if (index == _oldest)
+            _oldest = _prev[index];
+        else
+            _prev[_next[index]] = _prev[index];
+
+        _prev[index] = -1;
+        _next[index] = _newest;
+        _prev[_newest] = index;
+        _newest = index;
+    }
+};
+
+// Strips are cheap to rebuild, so the whole cache is dropped once it holds this many.
+static constexpr size_t MaxScrollingTextStrips = MaxScrollingTextEntries;
+
 static DrawScrollText _drawScrollTextList[OpenRCT2::MaxScrollingTextEntries];
+static std::unordered_map<ScrollTextKey, int32_t, ScrollTextHash> _drawScrollTextIndices;
+static std::unordered_map<ScrollTextString, ScrollTextStrip, ScrollTextHash> _scrollTextStrips;
+static ScrollTextLru _scrollTextLru;
 static uint8_t _characterBitmaps[FONT_SPRITE_GLYPH_COUNT + SPR_G2_GLYPH_COUNT][8];
-static uint32_t _drawSCrollNextIndex = 0;
 static std::mutex _scrollingTextMutex;
 
-static void ScrollingTextSetBitmapForSprite(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour);
-static void ScrollingTextSetBitmapForTTF(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour);
+static void ScrollingTextRasteriseSprite(std::string_view text, colour_t colour, ScrollTextStrip& strip);
+static void ScrollingTextRasteriseTTF(std::string_view text, colour_t colour, ScrollTextStrip& strip);
 
 static void ScrollingTextInitialiseCharacterBitmaps(uint32_t glyphStart, uint16_t offset, uint16_t count, bool isAntiAliased)
 {
@@ -120,41 +245,65 @@ static uint8_t* FontSpriteGetCodepointBitmap(int32_t codepoint)
     return _characterBitmaps[offset];
 }
 
-static int32_t ScrollingTextGetMatchingOrOldest(
-    StringId stringId, Formatter& ft, uint16_t scroll, uint16_t scrollingMode, colour_t colour)
+static void ScrollingTextFormat(utf8* dst, size_t size, const ScrollTextString& text)
 {
-    uint32_t oldestId = 0xFFFFFFFF;
-    int32_t scrollIndex = -1;
-    for (size_t i = 0; i < std::size(_drawScrollTextList); i++)
+    if (text.upper_case)
     {
-        DrawScrollText* scrollText = &_drawScrollTextList[i];
-        if (oldestId >= scrollText->id)
-        {
-            oldestId = scrollText->id;
-            scrollIndex = static_cast<int32_t>(i);
-        }
-
-        // If exact match return the matching index
-        if (scrollText->string_id == stringId
-            && std::memcmp(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args)) == 0
-            && scrollText->colour == colour && scrollText->position == scroll && scrollText->mode == scrollingMode)
-        {
-            scrollText->id = _drawSCrollNextIndex;
-            return static_cast<int32_t>(i + SPR_SCROLLING_TEXT_START);
-        }
+        FormatStringToUpper(dst, size, text.string_id, text.string_args);
+    }
+    else
+    {
+        FormatStringLegacy(dst, size, text.string_id, text.string_args);
     }
-    return scrollIndex;
 }
 
-static void ScrollingTextFormat(utf8* dst, size_t size, DrawScrollText* scrollText)
+static const ScrollTextStrip& ScrollingTextGetStrip(const ScrollTextString& text)
 {
-    if (gConfigGeneral.UpperCaseBanners)
+    auto it = _scrollTextStrips.find(text);
+    if (it != _scrollTextStrips.end())
+        return it->second;
+
+    if (_scrollTextStrips.size() >= MaxScrollingTextStrips)
+        _scrollTextStrips.clear();
+
+    utf8 scrollString[256];
+    ScrollingTextFormat(scrollString, sizeof(scrollString), text);
+
+    ScrollTextStrip strip{};
+    if (text.true_type)
     {
-        FormatStringToUpper(dst, size, scrollText->string_id, scrollText->string_args);
+        ScrollingTextRasteriseTTF(scrollString, text.colour, strip);
     }
     else
     {
-        FormatStringLegacy(dst, size, scrollText->string_id, scrollText->string_args);
+        ScrollingTextRasteriseSprite(scrollString, text.colour, strip);
+    }
+    return _scrollTextStrips.emplace(text, std::move(strip)).first->second;
+}
+
+static void ScrollingTextDrawStrip(
+    const ScrollTextStrip& strip, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets)
+{
+    const size_t numColumns = strip.pixels.size() / ScrollingTextRows;
+    if (numColumns == 0)
+        return;
+
+    const size_t lastColumn = strip.repeats > 0 ? numColumns * strip.repeats : SIZE_MAX;
+    for (size_t column = scroll; *scrollPositionOffsets != -1; column++, scrollPositionOffsets++)
+    {
+        if (column >= lastColumn)
+            return;
+
+        const auto* src = &strip.pixels[(column % numColumns) * ScrollingTextRows];
+        auto* dst = &bitmap[*scrollPositionOffsets];
+        for (int32_t y = 0; y < ScrollingTextRows; y++)
+        {
+            if (src[y] != 0)
+                *dst = src[y];
+
+            // Jump to next row
+            dst += 64;
+        }
     }
 }
 
@@ -1426,11 +1575,14 @@ static constexpr const int16_t* _scrollPositions[MAX_SCROLLING_TEXT_MODES] = {
 
 void ScrollingTextInvalidate()
 {
+    std::scoped_lock<std::mutex> lock(_scrollingTextMutex);
+
     for (auto& scrollText : _drawScrollTextList)
     {
-        scrollText.string_id = 0;
-        std::memset(scrollText.string_args, 0, sizeof(scrollText.string_args));
+        scrollText.in_use = false;
     }
+    _drawScrollTextIndices.clear();
+    _scrollTextStrips.clear();
 }
 
 ImageId ScrollingTextSetup(
@@ -1443,110 +1595,109 @@ ImageId ScrollingTextSetup(
     if (session.DPI.zoom_level > ZoomLevel{ 0 })
         return ImageId(SPR_SCROLLING_TEXT_DEFAULT);
 
-    _drawSCrollNextIndex++;
     ft.Rewind();
-    int32_t scrollIndex = ScrollingTextGetMatchingOrOldest(stringId, ft, scroll, scrollingMode, colour);
-    if (scrollIndex >= SPR_SCROLLING_TEXT_START)
-        return ImageId(scrollIndex);
-
-    // Setup scrolling text
-    auto scrollText = &_drawScrollTextList[scrollIndex];
-    scrollText->string_id = stringId;
-    std::memcpy(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args));
-    scrollText->colour = colour;
-    scrollText->position = scroll;
-    scrollText->mode = scrollingMode;
-    scrollText->id = _drawSCrollNextIndex;
-
-    // Create the string to draw
-    utf8 scrollString[256];
-    ScrollingTextFormat(scrollString, 256, scrollText);
-
-    const int16_t* scrollingModePositions = _scrollPositions[scrollingMode];
+    ScrollTextKey key{};
+    key.text.string_id = stringId;
+    std::memcpy(key.text.string_args, ft.Buf(), sizeof(key.text.string_args));
+    key.text.colour = colour;
+    key.text.upper_case = gConfigGeneral.UpperCaseBanners;
+    key.text.true_type = LocalisationService_UseTrueTypeFont();
+    key.position = scroll;
+    key.mode = scrollingMode;
 
-    std::fill_n(scrollText->bitmap, 320 * 8, 0x00);
-    if (LocalisationService_UseTrueTypeFont())
+    auto it = _drawScrollTextIndices.find(key);
+    if (it != _drawScrollTextIndices.end())
     {
-        ScrollingTextSetBitmapForTTF(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
+        _scrollTextLru.Touch(it->second);
+        return ImageId(SPR_SCROLLING_TEXT_START + it->second);
     }
-    else
+
+    // Setup scrolling text
+    const auto scrollIndex = _scrollTextLru.GetOldest();
+    _scrollTextLru.Touch(scrollIndex);
+
+    auto& scrollText = _drawScrollTextList[scrollIndex];
+    if (scrollText.in_use)
     {
-        ScrollingTextSetBitmapForSprite(scrollString, scroll, scrollText->bitmap, scrollingModePositions, colour);
+        _drawScrollTextIndices.erase(scrollText.key);
     }
+    scrollText.key = key;
+    scrollText.in_use = true;
+    _drawScrollTextIndices.emplace(key, scrollIndex);
+
+    std::fill_n(scrollText.bitmap, 320 * 8, 0x00);
+    ScrollingTextDrawStrip(ScrollingTextGetStrip(key.text), scroll, scrollText.bitmap, _scrollPositions[scrollingMode]);
 
     uint32_t imageId = SPR_SCROLLING_TEXT_START + scrollIndex;
     DrawingEngineInvalidateImage(imageId);
     return ImageId(imageId);
 }
 
-static void ScrollingTextSetBitmapForSprite(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour)
+static void ScrollingTextRasteriseSpritePass(FmtString& fmt, colour_t& characterColour, ScrollTextStrip& strip)
 {
-    auto characterColour = colour;
-    auto fmt = FmtString(text);
-
-    // Repeat string a maximum of four times (eliminates possibility of infinite loop)
-    for (auto i = 0; i < 4; i++)
+    for (const auto& token : fmt)
     {
-        for (const auto& token : fmt)
+        if (token.IsLiteral())
         {
-            if (token.IsLiteral())
+            CodepointView codepoints(token.text);
+            for (auto codepoint : codepoints)
             {
-                CodepointView codepoints(token.text);
-                for (auto codepoint : codepoints)
+                auto characterWidth = FontSpriteGetCodepointWidth(FontStyle::Tiny, codepoint);
+                auto characterBitmap = FontSpriteGetCodepointBitmap(codepoint);
+                for (; characterWidth != 0; characterWidth--, characterBitmap++)
                 {
-                    auto characterWidth = FontSpriteGetCodepointWidth(FontStyle::Tiny, codepoint);
-                    auto characterBitmap = FontSpriteGetCodepointBitmap(codepoint);
-                    for (; characterWidth != 0; characterWidth--, characterBitmap++)
+                    auto column = strip.AddColumn();
+                    int32_t y = 0;
+                    for (uint8_t char_bitmap = *characterBitmap; char_bitmap != 0; char_bitmap >>= 1, y++)
                     {
-                        // Skip any non-displayed columns
-                        if (scroll != 0)
-                        {
-                            scroll--;
-                            continue;
-                        }
-
-                        int16_t scrollPosition = *scrollPositionOffsets;
-                        if (scrollPosition == -1)
-                            return;
-
-                        if (scrollPosition > -1)
-                        {
-                            auto dst = &bitmap[scrollPosition];
-                            for (uint8_t char_bitmap = *characterBitmap; char_bitmap != 0; char_bitmap >>= 1)
-                            {
-                                if (char_bitmap & 1)
-                                    *dst = characterColour;
-
-                                // Jump to next row
-                                dst += 64;
-                            }
-                        }
-                        scrollPositionOffsets++;
+                        if (char_bitmap & 1)
+                            column[y] = characterColour;
                     }
                 }
             }
-            else if (FormatTokenIsColour(token.kind))
+        }
+        else if (FormatTokenIsColour(token.kind))
+        {
+            auto g1 = GfxGetG1Element(SPR_TEXT_PALETTE);
+            if (g1 != nullptr)
             {
-                auto g1 = GfxGetG1Element(SPR_TEXT_PALETTE);
-                if (g1 != nullptr)
-                {
-                    auto colourIndex = FormatTokenGetTextColourIndex(token.kind);
-                    characterColour = g1->offset[colourIndex * 4];
-                }
+                auto colourIndex = FormatTokenGetTextColourIndex(token.kind);
+                characterColour = g1->offset[colourIndex * 4];
             }
         }
     }
 }
 
-static void ScrollingTextSetBitmapForTTF(
-    std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour)
+static void ScrollingTextRasteriseSprite(std::string_view text, colour_t colour, ScrollTextStrip& strip)
+{
+    auto characterColour = colour;
+    auto fmt = FmtString(text);
+
+    // Repeat string a maximum of four times (eliminates possibility of infinite loop)
+    static constexpr int32_t MaxRepeats = 4;
+
+    // The colour carries over into the next repeat, so the repeats only look the same when it ends where it started.
+    ScrollingTextRasteriseSpritePass(fmt, characterColour, strip);
+    if (characterColour == colour)
+    {
+        strip.repeats = MaxRepeats;
+        return;
+    }
+
+    for (auto i = 1; i < MaxRepeats; i++)
+    {
+        ScrollingTextRasteriseSpritePass(fmt, characterColour, strip);
+    }
+    strip.repeats = 1;
+}
+
+static void ScrollingTextRasteriseTTF(std::string_view text, colour_t colour, ScrollTextStrip& strip)
 {
 #ifndef NO_TTF
     auto fontDesc = TTFGetFontFromSpriteBase(FontStyle::Tiny);
     if (fontDesc->font == nullptr)
     {
-        ScrollingTextSetBitmapForSprite(text, scroll, bitmap, scrollPositionOffsets, colour);
+        ScrollingTextRasteriseSprite(text, colour, strip);
         return;
     }
 
@@ -1587,48 +1738,29 @@ static void ScrollingTextSetBitmapForTTF(
     // Line height offset
     int32_t min_vpos = -fontDesc->offset_y;
     int32_t max_vpos = std::min(surface->h - 2, min_vpos + 7);
+    int32_t rows = std::clamp(max_vpos - min_vpos, 0, ScrollingTextRows);
 
     bool use_hinting = gConfigFonts.EnableHinting && fontDesc->hinting_threshold > 0;
 
-    for (int32_t x = 0;; x++)
+    // The text wraps around to its start for as long as there are positions left to fill.
+    strip.repeats = 0;
+    for (int32_t x = 0; x < width; x++)
     {
-        if (x >= width)
-            x = 0;
-
-        // Skip any non-displayed columns
-        if (scroll == 0)
+        auto column = strip.AddColumn();
+        for (int32_t row = 0; row < rows; row++)
         {
-            int16_t scrollPosition = *scrollPositionOffsets;
-            if (scrollPosition == -1)
-                return;
-
-            if (scrollPosition > -1)
+            uint8_t src_pixel = src[(min_vpos + row) * pitch + x];
+            if ((!use_hinting && src_pixel != 0) || src_pixel > 140)
             {
-                uint8_t* dst = &bitmap[scrollPosition];
-
-                for (int32_t y = min_vpos; y < max_vpos; y++)
-                {
-                    uint8_t src_pixel = src[y * pitch + x];
-                    if ((!use_hinting && src_pixel != 0) || src_pixel > 140)
-                    {
-                        // Centre of the glyph: use full colour.
-                        *dst = colour;
-                    }
-                    else if (use_hinting && src_pixel > fontDesc->hinting_threshold)
-                    {
-                        // Simulate font hinting by shading the background colour instead.
-                        *dst = BlendColours(colour, *dst);
-                    }
-
-                    // Jump to next row
-                    dst += 64;
-                }
+                // Centre of the glyph: use full colour.
+                column[row] = colour;
+            }
+            else if (use_hinting && src_pixel > fontDesc->hinting_threshold)
+            {
+                // Simulate font hinting by shading the background colour instead. Scroll positions never overlap so the
+                // background is always transparent.
+                column[row] = BlendColours(colour, 0);
             }
-            scrollPositionOffsets++;
-        }
-        else
-        {
-            scroll--;
         }
     }
 #endif // NO_TTF
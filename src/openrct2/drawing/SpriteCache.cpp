@@ -0,0 +1,339 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SpriteCache.h"
+
+#include "../profiling/MemoryStats.h"
+#include "Drawing.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace OpenRCT2::Drawing::SpriteCache
+{
+    // Sprites are spread over the shards by image index, so threads drawing different sprites rarely wait on each other
+    // and invalidating an image only has to look at one shard.
+    static constexpr size_t NumShards = 16;
+    // A single sprite may take at most this part of a shard, larger ones are drawn without the cache.
+    static constexpr size_t MaxSpriteShardFraction = 4;
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            const uint64_t image = key.Index | (static_cast<uint64_t>(key.Primary) << 32)
+                | (static_cast<uint64_t>(key.Secondary) << 40) | (static_cast<uint64_t>(key.Tertiary) << 48)
+                | (static_cast<uint64_t>(key.Remap) << 56);
+            const uint64_t placement = static_cast<uint8_t>(key.Zoom) | (key.PhaseX << 8) | (key.PhaseY << 16);
+            return std::hash<uint64_t>()(image ^ (placement * 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<const Raster> Value;
+        std::list<Key>::iterator LruPosition;
+    };
+
+    struct Shard
+    {
+        std::mutex Mutex;
+        std::unordered_map<Key, Entry, KeyHash> Entries;
+        // Number of entries per image, so invalidating an image that is not cached does not search the shard.
+        std::unordered_map<ImageIndex, uint32_t> Images;
+        // Most recently used first.
+        std::list<Key> Lru;
+        size_t Bytes{};
+    };
+
+    static std::array<Shard, NumShards> _shards;
+    static std::atomic<size_t> _memoryLimit{ DefaultMemoryLimit };
+    static std::atomic<uint64_t> _hits{};
+    static std::atomic<uint64_t> _misses{};
+    static std::atomic<uint64_t> _evictions{};
+    static std::atomic<uint64_t> _invalidations{};
+
+    size_t Raster::GetSize() const
+    {
+        return sizeof(Raster) + Pixels.size() + Spans.size() * sizeof(uint16_t);
+    }
+
+    static Shard& GetShard(ImageIndex image)
+    {
+        return _shards[image % NumShards];
+    }
+
+    static size_t GetShardLimit()
+    {
+        return _memoryLimit.load(std::memory_order_relaxed) / NumShards;
+    }
+
+    static void RemoveEntry(Shard& shard, std::unordered_map<Key, Entry, KeyHash>::iterator it)
+    {
+        const auto size = it->second.Value->GetSize();
+        shard.Bytes -= size;
+        MemoryStats::Add(MemoryStats::Subsystem::Sprites, -static_cast<int64_t>(size));
+
+        auto images = shard.Images.find(it->first.Index);
+        if (--images->second == 0)
+        {
+            shard.Images.erase(images);
+        }
+        shard.Lru.erase(it->second.LruPosition);
+        shard.Entries.erase(it);
+    }
+
+    static void EvictToLimit(Shard& shard, size_t limit)
+    {
+        while (shard.Bytes > limit && !shard.Lru.empty())
+        {
+            RemoveEntry(shard, shard.Entries.find(shard.Lru.back()));
+            _evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static std::shared_ptr<Raster> Decode(
+        const Key& key, const G1Element& g1, const PaletteMap* paletteMap, int32_t width, int32_t height)
+    {
+        auto raster = std::make_shared<Raster>();
+        raster->Width = width;
+        raster->Height = height;
+        raster->Pixels.resize(static_cast<size_t>(width) * height);
+        raster->Spans.resize(static_cast<size_t>(height) * 2);
+
+        const int32_t zoom = 1 << key.Zoom;
+        for (int32_t row = 0; row < height; row++)
+        {
+            const int32_t y = key.PhaseY + (row << key.Zoom);
+            const uint16_t lineOffset = g1.offset[y * 2] | (g1.offset[y * 2 + 1] << 8);
+            auto* dst = raster->Pixels.data() + static_cast<size_t>(row) * width;
+            int32_t left = width;
+            int32_t right = 0;
+
+            auto nextRun = g1.offset + lineOffset;
+            auto isEndOfLine = false;
+            while (!isEndOfLine)
+            {
+                auto src = nextRun;
+                int32_t dataSize = *src++;
+                int32_t firstPixelX = *src++;
+                isEndOfLine = (dataSize & 0x80) != 0;
+                dataSize &= 0x7F;
+                nextRun = src + dataSize;
+
+                // Skip to the first pixel of the run that lies on the sampling grid
+                const int32_t x = firstPixelX - key.PhaseX;
+                const int32_t skip = x < 0 ? -x : (zoom - (x & (zoom - 1))) & (zoom - 1);
+                for (int32_t i = skip; i < dataSize; i += zoom)
+                {
+                    const int32_t column = (x + i) >> key.Zoom;
+                    auto pixel = paletteMap != nullptr ? (*paletteMap)[src[i]] : src[i];
+                    if (pixel != 0 && column < width)
+                    {
+                        dst[column] = pixel;
+                        left = std::min(left, column);
+                        right = std::max(right, column + 1);
+                    }
+                }
+            }
+
+            raster->Spans[row * 2] = static_cast<uint16_t>(std::min(left, right));
+            raster->Spans[row * 2 + 1] = static_cast<uint16_t>(right);
+        }
+        return raster;
+    }
+
+    bool IsCacheable(ImageId imageId, const G1Element& g1, ZoomLevel zoom)
+    {
+        if (!(g1.flags & G1_FLAG_RLE_COMPRESSION) || imageId.IsBlended() || zoom < ZoomLevel{ 0 })
+            return false;
+        if (zoom == ZoomLevel{ 0 } && !imageId.HasPrimary())
+            return false;
+        return _memoryLimit.load(std::memory_order_relaxed) != 0;
+    }
+
+    Key CreateKey(ImageId imageId, ZoomLevel zoom, int32_t srcX, int32_t srcY)
+    {
+        const auto zoomShift = static_cast<int8_t>(zoom);
+        const int32_t phaseMask = (1 << zoomShift) - 1;
+
+        Key key;
+        key.Index = imageId.GetIndex();
+        key.Zoom = zoomShift;
+        key.PhaseX = static_cast<uint8_t>(srcX & phaseMask);
+        key.PhaseY = static_cast<uint8_t>(srcY & phaseMask);
+        if (imageId.HasPrimary())
+        {
+            key.Primary = imageId.GetPrimary();
+            key.Remap |= 1;
+        }
+        if (imageId.HasSecondary())
+        {
+            key.Secondary = imageId.GetSecondary();
+            key.Remap |= 2;
+        }
+        if (imageId.HasTertiary())
+        {
+            key.Tertiary = imageId.GetTertiary();
+            key.Remap |= 4;
+        }
+        return key;
+    }
+
+    std::shared_ptr<const Raster> Find(const Key& key)
+    {
+        auto& shard = GetShard(key.Index);
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+
+        auto it = shard.Entries.find(key);
+        if (it == shard.Entries.end())
+        {
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        shard.Lru.splice(shard.Lru.begin(), shard.Lru, it->second.LruPosition);
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return it->second.Value;
+    }
+
+    std::shared_ptr<const Raster> Insert(const Key& key, const G1Element& g1, const PaletteMap* paletteMap)
+    {
+        const int32_t zoom = 1 << key.Zoom;
+        const int32_t width = std::max(0, g1.width - key.PhaseX + zoom - 1) >> key.Zoom;
+        const int32_t height = std::max(0, g1.height - key.PhaseY + zoom - 1) >> key.Zoom;
+        const auto size = sizeof(Raster) + static_cast<size_t>(width) * height + static_cast<size_t>(height) * 4;
+        if (size > GetShardLimit() / MaxSpriteShardFraction)
+        {
+            return nullptr;
+        }
+
+        // Decoded before taking the lock, if another thread adds the same sprite in the meantime its raster is kept
+        auto raster = Decode(key, g1, paletteMap, width, height);
+
+        auto& shard = GetShard(key.Index);
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+
+        auto [it, inserted] = shard.Entries.try_emplace(key);
+        if (!inserted)
+        {
+            return it->second.Value;
+        }
+
+        shard.Lru.push_front(key);
+        it->second.Value = raster;
+        it->second.LruPosition = shard.Lru.begin();
+        shard.Images[key.Index]++;
+        shard.Bytes += raster->GetSize();
+        MemoryStats::Add(MemoryStats::Subsystem::Sprites, static_cast<int64_t>(raster->GetSize()));
+
+        EvictToLimit(shard, GetShardLimit());
+        return raster;
+    }
+
+    void Draw(
+        const Raster& raster, const DrawPixelInfo& dpi, int32_t srcX, int32_t srcY, int32_t width, int32_t height,
+        uint8_t* dst)
+    {
+        const auto zoomShift = static_cast<int8_t>(dpi.zoom_level);
+        const int32_t zoom = 1 << zoomShift;
+        const auto dstLineWidth = (static_cast<size_t>(dpi.width) >> zoomShift) + dpi.pitch;
+        const auto& kernels = GetRLEBlitKernels();
+
+        // The raster column and row of the first destination pixel, -1 when the source starts just before the sprite
+        const int32_t firstColumn = (srcX - (srcX & (zoom - 1))) / zoom;
+        const int32_t firstRow = (srcY - (srcY & (zoom - 1))) / zoom;
+        const int32_t numColumns = (width + zoom - 1) >> zoomShift;
+        const int32_t numRows = std::min((height + zoom - 1) >> zoomShift, raster.Height - firstRow);
+
+        for (int32_t row = std::max(0, -firstRow); row < numRows; row++)
+        {
+            const int32_t rasterRow = firstRow + row;
+            const int32_t begin = std::max<int32_t>(raster.Spans[rasterRow * 2], firstColumn);
+            const int32_t end = std::min<int32_t>(raster.Spans[rasterRow * 2 + 1], firstColumn + numColumns);
+            if (begin < end)
+            {
+                const auto* src = raster.Pixels.data() + static_cast<size_t>(rasterRow) * raster.Width + begin;
+                kernels.Copy(src, dst + row * dstLineWidth + (begin - firstColumn), end - begin);
+            }
+        }
+    }
+
+    void InvalidateImage(ImageIndex image)
+    {
+        auto& shard = GetShard(image);
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+        if (shard.Images.find(image) == shard.Images.end())
+        {
+            return;
+        }
+
+        for (auto it = shard.Entries.begin(); it != shard.Entries.end();)
+        {
+            auto next = std::next(it);
+            if (it->first.Index == image)
+            {
+                RemoveEntry(shard, it);
+                _invalidations.fetch_add(1, std::memory_order_relaxed);
+            }
+            it = next;
+        }
+    }
+
+    void Clear()
+    {
+        for (auto& shard : _shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.Mutex);
+            while (!shard.Entries.empty())
+            {
+                RemoveEntry(shard, shard.Entries.begin());
+            }
+        }
+    }
+
+    void SetMemoryLimit(size_t bytes)
+    {
+        _memoryLimit.store(bytes, std::memory_order_relaxed);
+        for (auto& shard : _shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.Mutex);
+            EvictToLimit(shard, GetShardLimit());
+        }
+    }
+
+    Stats GetStats()
+    {
+        Stats stats;
+        stats.Hits = _hits.load(std::memory_order_relaxed);
+        stats.Misses = _misses.load(std::memory_order_relaxed);
+        stats.Evictions = _evictions.load(std::memory_order_relaxed);
+        stats.Invalidations = _invalidations.load(std::memory_order_relaxed);
+        stats.MemoryLimit = _memoryLimit.load(std::memory_order_relaxed);
+        for (auto& shard : _shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.Mutex);
+            stats.Entries += shard.Entries.size();
+            stats.Bytes += shard.Bytes;
+        }
+        return stats;
+    }
+
+    void ResetStats()
+    {
+        _hits.store(0, std::memory_order_relaxed);
+        _misses.store(0, std::memory_order_relaxed);
+        _evictions.store(0, std::memory_order_relaxed);
+        _invalidations.store(0, std::memory_order_relaxed);
+    }
+} // namespace OpenRCT2::Drawing::SpriteCache
@@ -0,0 +1,98 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../interface/ZoomLevel.h"
+#include "ImageId.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct DrawPixelInfo;
+struct G1Element;
+struct PaletteMap;
+
+/**
+ * Cache of RLE sprites that have already been decoded for a zoom level and remapped with the colours of their image id,
+ * so drawing them is a copy of the visible rows. Zoomed out sprites sample every n-th pixel, which pixels depends on
+ * where the sprite lands relative to the zoom grid, so that phase is part of the key as well.
+ */
+namespace OpenRCT2::Drawing::SpriteCache
+{
+    static constexpr size_t DefaultMemoryLimit = 32 * 1024 * 1024;
+
+    struct Key
+    {
+        ImageIndex Index{};
+        uint8_t Primary{};
+        uint8_t Secondary{};
+        uint8_t Tertiary{};
+        uint8_t Remap{};
+        int8_t Zoom{};
+        uint8_t PhaseX{};
+        uint8_t PhaseY{};
+
+        bool operator==(const Key& other) const
+        {
+            return Index == other.Index && Primary == other.Primary && Secondary == other.Secondary
+                && Tertiary == other.Tertiary && Remap == other.Remap && Zoom == other.Zoom && PhaseX == other.PhaseX
+                && PhaseY == other.PhaseY;
+        }
+    };
+
+    struct Raster
+    {
+        int32_t Width{};
+        int32_t Height{};
+        // Palette indices, 0 is transparent.
+        std::vector<uint8_t> Pixels;
+        // The opaque columns of every row as a pair of first and one past the last column.
+        std::vector<uint16_t> Spans;
+
+        size_t GetSize() const;
+    };
+
+    struct Stats
+    {
+        uint64_t Hits{};
+        uint64_t Misses{};
+        uint64_t Evictions{};
+        uint64_t Invalidations{};
+        size_t Entries{};
+        size_t Bytes{};
+        size_t MemoryLimit{};
+    };
+
+    /**
+     * Whether a sprite drawn with the given image id and zoom level benefits from the cache. Blended images depend on
+     * the destination and unzoomed sprites without a remap are already a straight copy of each run.
+     */
+    bool IsCacheable(ImageId imageId, const G1Element& g1, ZoomLevel zoom);
+    Key CreateKey(ImageId imageId, ZoomLevel zoom, int32_t srcX, int32_t srcY);
+
+    std::shared_ptr<const Raster> Find(const Key& key);
+    // Returns nullptr if the sprite is too large for the cache, which is checked before decoding it.
+    std::shared_ptr<const Raster> Insert(const Key& key, const G1Element& g1, const PaletteMap* paletteMap);
+
+    // Draws the part of the raster that GfxRleSpriteToBuffer would draw for the same arguments.
+    void Draw(
+        const Raster& raster, const DrawPixelInfo& dpi, int32_t srcX, int32_t srcY, int32_t width, int32_t height,
+        uint8_t* dst);
+
+    void InvalidateImage(ImageIndex image);
+    void Clear();
+
+    // Evicts sprites until the cache fits, a limit of 0 disables the cache.
+    void SetMemoryLimit(size_t bytes);
+    Stats GetStats();
+    void ResetStats();
+} // namespace OpenRCT2::Drawing::SpriteCache
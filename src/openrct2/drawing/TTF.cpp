@@ -24,6 +24,7 @@
 #    include "../localisation/Localisation.h"
 #    include "../localisation/LocalisationService.h"
 #    include "../platform/Platform.h"
+#    include "../profiling/MemoryStats.h"
 #    include "TTF.h"
 
 static bool _ttfInitialised = false;
@@ -192,10 +193,16 @@ static uint32_t TTFSurfaceCacheHash(TTF_Font* font, std::string_view text)
     return hash;
 }
 
+static int64_t TTFSurfaceCacheEntrySize(const ttf_cache_entry* entry)
+{
+    return static_cast<int64_t>(sizeof(TTFSurface) + entry->surface->pitch * entry->surface->h + entry->text.size());
+}
+
 static void TTFSurfaceCacheDispose(ttf_cache_entry* entry)
 {
     if (entry->surface != nullptr)
     {
+        OpenRCT2::MemoryStats::Add(OpenRCT2::MemoryStats::Subsystem::TTF, -TTFSurfaceCacheEntrySize(entry));
         TTFFreeSurface(entry->surface);
         entry->text.clear();
         entry->surface = nullptr;
@@ -270,6 +277,7 @@ TTFSurface* TTFSurfaceCacheGetOrAdd(TTF_Font* font, std::string_view text)
     entry->font = font;
     entry->text = text;
     entry->lastUseTick = gCurrentDrawCount;
+    OpenRCT2::MemoryStats::Add(OpenRCT2::MemoryStats::Subsystem::TTF, TTFSurfaceCacheEntrySize(entry));
     return entry->surface;
 }
 
@@ -278,6 +286,7 @@ static void TTFGetWidthCacheDispose(ttf_getwidth_cache_entry* entry)
     if (entry->text.empty())
         return;
 
+    OpenRCT2::MemoryStats::Add(OpenRCT2::MemoryStats::Subsystem::TTF, -static_cast<int64_t>(entry->text.size()));
     entry->text.clear();
     entry->width = 0;
     entry->font = nullptr;
@@ -340,6 +349,7 @@ uint32_t TTFGetWidthCacheGetOrAdd(TTF_Font* font, std::string_view text)
     entry->font = font;
     entry->text = text;
     entry->lastUseTick = gCurrentDrawCount;
+    OpenRCT2::MemoryStats::Add(OpenRCT2::MemoryStats::Subsystem::TTF, static_cast<int64_t>(entry->text.size()));
     return entry->width;
 }
 
@@ -17,7 +17,7 @@
 class StaticLayout
 {
 private:
-    u8string Buffer;
+    OpenRCT2::FrameArena::String Buffer;
     TextPaint Paint;
     int32_t LineCount = 0;
     int32_t LineHeight;
@@ -27,7 +27,7 @@ public:
     StaticLayout(u8string_view source, const TextPaint& paint, int32_t width)
         : Paint(paint)
     {
-        MaxWidth = GfxWrapString(source, width, paint.FontStyle, &Buffer, &LineCount);
+        MaxWidth = GfxWrapString(source, width, paint.FontStyle, Buffer, &LineCount);
         LineCount += 1;
         LineHeight = FontGetLineHeight(paint.FontStyle);
     }
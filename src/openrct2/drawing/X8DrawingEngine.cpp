@@ -24,6 +24,7 @@
 #include "IDrawingContext.h"
 #include "IDrawingEngine.h"
 #include "LightFX.h"
+#include "SpriteCache.h"
 #include "Weather.h"
 
 #include <algorithm>
@@ -33,6 +34,48 @@ using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
 using namespace OpenRCT2::Ui;
 
+void OpenRCT2::Drawing::ExtractDirtyRects(DirtyGrid& grid, std::vector<DirtyRect>& rects)
+{
+    rects.clear();
+
+    const auto columns = grid.BlockColumns;
+    uint8_t* blocks = grid.Blocks;
+    for (uint32_t y = 0; y < grid.BlockRows; y++)
+    {
+        for (uint32_t x = 0; x < columns; x++)
+        {
+            if (blocks[y * columns + x] == 0)
+            {
+                continue;
+            }
+
+            uint32_t right = x + 1;
+            while (right < columns && blocks[y * columns + right] != 0)
+            {
+                right++;
+            }
+
+            uint32_t bottom = y + 1;
+            while (bottom < grid.BlockRows)
+            {
+                const auto* row = &blocks[bottom * columns];
+                if (std::any_of(row + x, row + right, [](uint8_t block) { return block == 0; }))
+                {
+                    break;
+                }
+                bottom++;
+            }
+
+            for (uint32_t yy = y; yy < bottom; yy++)
+            {
+                std::fill(&blocks[yy * columns + x], &blocks[yy * columns + right], 0);
+            }
+            rects.push_back({ x, y, right - x, bottom - y });
+            x = right - 1;
+        }
+    }
+}
+
 X8WeatherDrawer::X8WeatherDrawer()
 {
     _weatherPixels = new WeatherPixel[_weatherPixelsCapacity];
@@ -277,9 +320,9 @@ DRAWING_ENGINE_FLAGS X8DrawingEngine::GetFlags()
     return static_cast<DRAWING_ENGINE_FLAGS>(DEF_DIRTY_OPTIMISATIONS | DEF_PARALLEL_DRAWING);
 }
 
-void X8DrawingEngine::InvalidateImage([[maybe_unused]] uint32_t image)
+void X8DrawingEngine::InvalidateImage(uint32_t image)
 {
-    // Not applicable for this engine
+    SpriteCache::InvalidateImage(image);
 }
 
 DrawPixelInfo* X8DrawingEngine::GetDPI()
@@ -364,78 +407,17 @@ void X8DrawingEngine::ConfigureDirtyGrid()
 
 void X8DrawingEngine::DrawAllDirtyBlocks()
 {
-    // TODO: For optimal performance it is currently limited to a single column.
-    // The optimal approach would be to extract all dirty regions as rectangles not including
-    // parts that are not marked dirty and have the grid more fine grained.
-    // A situation like following:
-    //
-    //   0 1 2 3 4 5 6 7 8 9
-    //   1 - - - - - - - - -
-    //   2 - x x x x - - - -
-    //   3 - x x - - - - - -
-    //   4 - - - - - - - - -
-    //   5 - - - - - - - - -
-    //   6 - - - - - - - - -
-    //   7 - - - - - - - - -
-    //   8 - - - - - - - - -
-    //   9 - - - - - - - - -
-    //
-    // Would currently redraw {2,2} to {3,5} where {3,4} and {3,5} are not dirty. Choosing to do this
-    // per column eliminates this issue but limits it to rendering just a single column at a time.
-
-    for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
-    {
-        for (uint32_t y = 0; y < _dirtyGrid.BlockRows; y++)
-        {
-            uint32_t yOffset = y * _dirtyGrid.BlockColumns;
-            if (_dirtyGrid.Blocks[yOffset + x] == 0)
-            {
-                continue;
-            }
-
-            // See comment above as to why this is 1.
-            const uint32_t columns = 1;
-
-            // Check rows
-            auto rows = GetNumDirtyRows(x, y, columns);
-            DrawDirtyBlocks(x, y, columns, rows);
-        }
-    }
-}
-
-uint32_t X8DrawingEngine::GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns)
-{
-    uint32_t yy = y;
-
-    for (yy = y; yy < _dirtyGrid.BlockRows; yy++)
+    // Each rectangle is a separate traversal of the window stack, so dirty blocks are merged into as few
+    // rectangles as possible without including any block that is not dirty.
+    ExtractDirtyRects(_dirtyGrid, _dirtyRects);
+    for (const auto& rect : _dirtyRects)
     {
-        uint32_t yyOffset = yy * _dirtyGrid.BlockColumns;
-        for (uint32_t xx = x; xx < x + columns; xx++)
-        {
-            if (_dirtyGrid.Blocks[yyOffset + xx] == 0)
-            {
-                return yy - y;
-            }
-        }
+        DrawDirtyBlocks(rect.X, rect.Y, rect.Columns, rect.Rows);
     }
-    return yy - y;
 }
 
 void X8DrawingEngine::DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows)
 {
-    uint32_t dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint8_t* screenDirtyBlocks = _dirtyGrid.Blocks;
-
-    // Unset dirty blocks
-    for (uint32_t top = y; top < y + rows; top++)
-    {
-        uint32_t topOffset = top * dirtyBlockColumns;
-        for (uint32_t left = x; left < x + columns; left++)
-        {
-            screenDirtyBlocks[topOffset + left] = 0;
-        }
-    }
-
     // Determine region in pixels
     uint32_t left = std::max<uint32_t>(0, x * _dirtyGrid.BlockWidth);
     uint32_t top = std::max<uint32_t>(0, y * _dirtyGrid.BlockHeight);
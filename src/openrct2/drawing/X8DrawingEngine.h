@@ -14,6 +14,7 @@
 #include "IDrawingEngine.h"
 
 #include <memory>
+#include <vector>
 
 namespace OpenRCT2
 {
@@ -37,6 +38,22 @@ namespace OpenRCT2
             uint8_t* Blocks;
         };
 
+        // A rectangle of dirty blocks, in blocks rather than pixels.
+        struct DirtyRect
+        {
+            uint32_t X;
+            uint32_t Y;
+            uint32_t Columns;
+            uint32_t Rows;
+        };
+
+        /**
+         * Splits the dirty blocks of the grid into non-overlapping rectangles that contain only dirty blocks, and
+         * clears them. Each rectangle is made as wide as the run of dirty blocks it starts on and then extended
+         * down for as long as the rows below are dirty across the same width.
+         */
+        void ExtractDirtyRects(DirtyGrid& grid, std::vector<DirtyRect>& rects);
+
         class X8WeatherDrawer final : public IWeatherDrawer
         {
         private:
@@ -75,6 +92,7 @@ namespace OpenRCT2
             uint8_t* _bits = nullptr;
 
             DirtyGrid _dirtyGrid = {};
+            std::vector<DirtyRect> _dirtyRects;
 
             DrawPixelInfo _bitsDPI = {};
 
@@ -121,7 +139,6 @@ namespace OpenRCT2
         private:
             void ConfigureDirtyGrid();
             void DrawAllDirtyBlocks();
-            uint32_t GetNumDirtyRows(const uint32_t x, const uint32_t y, const uint32_t columns);
             void DrawDirtyBlocks(uint32_t x, uint32_t y, uint32_t columns, uint32_t rows);
         };
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
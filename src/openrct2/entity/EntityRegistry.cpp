@@ -10,6 +10,7 @@
 #include "EntityRegistry.h"
 
 #include "../Game.h"
+#include "../GameStateHash.h"
 #include "../core/Algorithm.hpp"
 #include "../core/ChecksumStream.h"
 #include "../core/Crypt.h"
@@ -318,6 +319,7 @@ static void PrepareNewEntity(EntityBase* base, const EntityType type)
     EntityReset(base);
 
     base->Type = type;
+    OpenRCT2::GameStateHash::Get().MarkEntityDirty(base->Id);
     AddToEntityList(base);
 
     base->x = LOCATION_NULL;
@@ -447,6 +449,8 @@ static void EntitySpatialMove(EntityBase* entity, const CoordsXY& newLoc)
 
 void EntityBase::MoveTo(const CoordsXYZ& newLocation)
 {
+    OpenRCT2::GameStateHash::Get().MarkEntityDirty(Id);
+
     if (x != LOCATION_NULL)
     {
         // Invalidate old position.
@@ -510,6 +514,8 @@ static void FreeEntity(EntityBase& entity)
  */
 void EntityRemove(EntityBase* entity)
 {
+    OpenRCT2::GameStateHash::Get().MarkEntityDirty(entity->Id);
+
     FreeEntity(*entity);
 
     EntityTweener::Get().RemoveEntity(entity);
@@ -11,6 +11,7 @@
 
 #include "../config/Config.h"
 #include "../core/String.hpp"
+#include "../drawing/Drawing.h"
 #include "../drawing/TTF.h"
 #include "../localisation/Language.h"
 #include "../localisation/LocalisationService.h"
@@ -147,6 +148,9 @@ static bool LoadCustomConfigFont(LocalisationService& localisationService)
 
 void TryLoadFonts(LocalisationService& localisationService)
 {
+    // Scrolling text strips are rendered with the current font
+    ScrollingTextInvalidate();
+
 #ifndef NO_TTF
     auto currentLanguage = localisationService.GetCurrentLanguage();
     TTFontFamily const* fontFamily = LanguagesDescriptors[currentLanguage].font_family;
@@ -28,12 +28,14 @@
 #include "../actions/StaffSetCostumeAction.h"
 #include "../config/Config.h"
 #include "../core/Console.hpp"
+#include "../core/FrameArena.h"
 #include "../core/Guard.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/Font.h"
 #include "../drawing/Image.h"
+#include "../drawing/SpriteCache.h"
 #include "../entity/EntityList.h"
 #include "../entity/EntityRegistry.h"
 #include "../entity/Staff.h"
@@ -51,10 +53,13 @@
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
 #include "../platform/Platform.h"
+#include "../profiling/MemoryStats.h"
 #include "../profiling/Profiling.h"
+#include "../profiling/TickStats.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
 #include "../ride/Vehicle.h"
+#include "../scripting/ScriptEngine.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
 #include "../world/Climate.h"
@@ -1177,6 +1182,7 @@ static int32_t ConsoleCommandSet(InteractiveConsole& console, const arguments_t&
             ConfigSaveDefault();
             console.Execute("get enable_hinting");
             TTFToggleHinting();
+            ScrollingTextInvalidate();
         }
 #endif
         else if (invalidArgs)
@@ -1702,6 +1708,38 @@ static int32_t ConsoleCommandReplayStop(InteractiveConsole& console, const argum
     return 0;
 }
 
+static int32_t ConsoleCommandReplaySeek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (NetworkGetMode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
+
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (!replayManager->IsReplaying())
+    {
+        console.WriteFormatLine("Replay currently not playing");
+        return 0;
+    }
+
+    uint32_t tick = atol(argv[0].c_str());
+    if (replayManager->SeekPlayback(tick))
+    {
+        console.WriteFormatLine("Replay seeked to tick %u", tick);
+        return 1;
+    }
+
+    console.WriteFormatLine("Unable to seek replay");
+    return 0;
+}
+
 static int32_t ConsoleCommandReplayNormalise(InteractiveConsole& console, const arguments_t& argv)
 {
     if (NetworkGetMode() != NETWORK_MODE_NONE)
@@ -1908,6 +1946,144 @@ static int32_t ConsoleCommandProfilerExportCSV(
     return 0;
 }
 
+static int32_t ConsoleCommandProfilerTrace(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() < 1)
+    {
+        console.WriteLineError("Missing argument: <ticks>");
+        return 1;
+    }
+
+    const auto numTicks = static_cast<uint32_t>(std::max(atol(argv[0].c_str()), 1L));
+    OpenRCT2::Profiling::StartTrace(gCurrentTicks, gCurrentTicks + numTicks - 1);
+    console.WriteFormatLine("Tracing ticks %u to %u", gCurrentTicks, gCurrentTicks + numTicks - 1);
+    return 0;
+}
+
+static int32_t ConsoleCommandProfilerExportTrace(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() < 1)
+    {
+        console.WriteLineError("Missing argument: <file path>");
+        return 1;
+    }
+
+    OpenRCT2::Profiling::StopTrace();
+
+    const auto& traceFilePath = argv[0];
+    if (!OpenRCT2::Profiling::ExportTrace(traceFilePath))
+    {
+        console.WriteFormatLine("Unable to export trace file to %s", traceFilePath.c_str());
+        return 1;
+    }
+
+    console.WriteFormatLine("Wrote trace file: \"%s\"", traceFilePath.c_str());
+    return 0;
+}
+
+static int32_t ConsoleCommandTickStats(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() >= 1 && argv[0] == "reset")
+    {
+        OpenRCT2::TickStats::Reset();
+        console.WriteLine("Tick stats reset");
+        return 0;
+    }
+
+    if (argv.size() >= 1 && argv[0] == "export")
+    {
+        if (argv.size() < 2)
+        {
+            console.WriteLineError("Missing argument: <file path>");
+            return 1;
+        }
+
+        const auto& statsFilePath = argv[1];
+        if (!OpenRCT2::TickStats::ExportStats(statsFilePath))
+        {
+            console.WriteFormatLine("Unable to export tick stats to %s", statsFilePath.c_str());
+            return 1;
+        }
+
+        console.WriteFormatLine("Wrote tick stats: \"%s\"", statsFilePath.c_str());
+        return 0;
+    }
+
+    console.WriteLine(OpenRCT2::TickStats::GetReport());
+    return 0;
+}
+
+static int32_t ConsoleCommandFrameAllocations(
+    InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    const auto& stats = OpenRCT2::FrameArena::GetLastFrameStats();
+    if constexpr (OpenRCT2::FrameArena::CountsHeapAllocations)
+    {
+        console.WriteFormatLine("Heap allocations: %llu", static_cast<unsigned long long>(stats.HeapAllocations));
+    }
+    else
+    {
+        console.WriteLine("Heap allocations: not counted, build with ENABLE_ALLOCATION_COUNTING");
+    }
+    console.WriteFormatLine("Frame arena bytes: %llu", static_cast<unsigned long long>(stats.ArenaBytes));
+    console.WriteFormatLine("Frame arena blocks allocated: %u", stats.ArenaBlocks);
+    return 0;
+}
+
+static int32_t ConsoleCommandMemoryStats(InteractiveConsole& console, const arguments_t& argv)
+{
+    const bool reset = argv.size() >= 1 && argv[0] == "reset";
+    if (reset)
+    {
+        OpenRCT2::MemoryStats::ResetPeaks();
+    }
+
+    console.WriteFormatLine("%-24s %12s %12s", "subsystem", "current KiB", "peak KiB");
+    for (size_t i = 0; i < OpenRCT2::MemoryStats::NumSubsystems; i++)
+    {
+        const auto subsystem = static_cast<OpenRCT2::MemoryStats::Subsystem>(i);
+        const auto usage = OpenRCT2::MemoryStats::GetUsage(subsystem);
+        console.WriteFormatLine(
+            "%-24s %12.1f %12.1f", OpenRCT2::MemoryStats::GetSubsystemName(subsystem), usage.CurrentBytes / 1024.0,
+            usage.PeakBytes / 1024.0);
+    }
+
+#ifdef ENABLE_SCRIPTING
+    console.WriteFormatLine("%-24s %12s %12s", "plugin heap", "current KiB", "peak KiB");
+    for (auto* usage : OpenRCT2::GetContext()->GetScriptEngine().GetHeapUsages())
+    {
+        if (reset)
+        {
+            usage->PeakBytes = usage->CurrentBytes;
+        }
+        console.WriteFormatLine(
+            "%-24s %12.1f %12.1f", usage->Name.c_str(), usage->CurrentBytes / 1024.0, usage->PeakBytes / 1024.0);
+    }
+#endif
+    return 0;
+}
+
+static int32_t ConsoleCommandSpriteCacheStats(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() >= 1 && argv[0] == "reset")
+    {
+        OpenRCT2::Drawing::SpriteCache::ResetStats();
+    }
+
+    const auto stats = OpenRCT2::Drawing::SpriteCache::GetStats();
+    const auto lookups = stats.Hits + stats.Misses;
+    console.WriteFormatLine(
+        "Sprites: %zu, %.1f of %.1f MiB", stats.Entries, stats.Bytes / (1024.0 * 1024.0),
+        stats.MemoryLimit / (1024.0 * 1024.0));
+    console.WriteFormatLine(
+        "Hits: %llu, misses: %llu, hit rate: %.1f%%", static_cast<unsigned long long>(stats.Hits),
+        static_cast<unsigned long long>(stats.Misses), lookups != 0 ? stats.Hits * 100.0 / lookups : 0.0);
+    console.WriteFormatLine(
+        "Evictions: %llu, invalidations: %llu", static_cast<unsigned long long>(stats.Evictions),
+        static_cast<unsigned long long>(stats.Invalidations));
+    return 0;
+}
+
 static int32_t ConsoleCommandProfilerStop(
     [[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
@@ -2026,6 +2202,7 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "replay_stoprecord", ConsoleCommandReplayStopRecord, "Stops recording a new replay.", "replay_stoprecord" },
     { "replay_start", ConsoleCommandReplayStart, "Starts a replay", "replay_start <name>" },
     { "replay_stop", ConsoleCommandReplayStop, "Stops the replay", "replay_stop" },
+    { "replay_seek", ConsoleCommandReplaySeek, "Jumps to a tick of the current replay", "replay_seek <tick>" },
     { "replay_normalise", ConsoleCommandReplayNormalise, "Normalises the replay to remove all gaps",
       "replay_normalise <input file> <output file>" },
     { "mp_desync", ConsoleCommandMpDesync, "Forces a multiplayer desync",
@@ -2035,6 +2212,18 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "profiler_stop", ConsoleCommandProfilerStop, "Stops the profiler.", "profiler_stop [<output file>]" },
     { "profiler_exportcsv", ConsoleCommandProfilerExportCSV, "Exports the current profiler data.",
       "profiler_exportcsv <output file>" },
+    { "profiler_trace", ConsoleCommandProfilerTrace, "Records a timeline of all profiled functions for the next ticks.",
+      "profiler_trace <ticks>" },
+    { "profiler_exporttrace", ConsoleCommandProfilerExportTrace, "Exports the recorded timeline as a Chrome trace.",
+      "profiler_exporttrace <output file>" },
+    { "tick_stats", ConsoleCommandTickStats, "Shows the tick time histogram, or resets or exports it.",
+      "tick_stats [reset|export <output file>]" },
+    { "frame_allocations", ConsoleCommandFrameAllocations, "Shows the heap and frame arena allocations of the last frame.",
+      "frame_allocations" },
+    { "memory_stats", ConsoleCommandMemoryStats, "Shows the memory used per subsystem and plugin, reset clears the peaks.",
+      "memory_stats [reset]" },
+    { "sprite_cache_stats", ConsoleCommandSpriteCacheStats, "Shows the size and hit rate of the sprite cache.",
+      "sprite_cache_stats [reset]" },
 };
 
 static int32_t ConsoleCommandWindows(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
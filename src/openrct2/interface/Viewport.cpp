@@ -241,6 +241,23 @@ void ViewportsInvalidate(const ScreenRect& screenRect, ZoomLevel maxZoom)
     }
 }
 
+void ViewportsGetViewBounds(std::vector<ScreenRect>& bounds, ZoomLevel maxZoom)
+{
+    bounds.clear();
+    if (gOpenRCT2Headless)
+        return;
+
+    for (const auto& vp : _viewports)
+    {
+        if (vp.visibility == VisibilityCache::Covered)
+            continue;
+        if (maxZoom != ZoomLevel{ -1 } && vp.zoom > maxZoom)
+            continue;
+
+        bounds.emplace_back(vp.viewPos, vp.viewPos + ScreenCoordsXY{ vp.view_width, vp.view_height });
+    }
+}
+
 /**
  *
  *  rct2: 0x00689174
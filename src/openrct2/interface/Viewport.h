@@ -133,6 +133,8 @@ std::optional<ScreenCoordsXY> centre_2d_coordinates(const CoordsXYZ& loc, Viewpo
 void ViewportCreate(WindowBase* w, const ScreenCoordsXY& screenCoords, int32_t width, int32_t height, const Focus& focus);
 void ViewportRemove(Viewport* viewport);
 void ViewportsInvalidate(const ScreenRect& screenRect, ZoomLevel maxZoom = ZoomLevel{ -1 });
+// Gets the view of every viewport that ViewportsInvalidate could draw to, in the same coordinates as its screen rect.
+void ViewportsGetViewBounds(std::vector<ScreenRect>& bounds, ZoomLevel maxZoom = ZoomLevel{ -1 });
 void ViewportUpdatePosition(WindowBase* window);
 void ViewportUpdateFollowSprite(WindowBase* window);
 void ViewportUpdateSmartFollowEntity(WindowBase* window);
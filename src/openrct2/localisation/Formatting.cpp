@@ -9,14 +9,17 @@
 
 #include "Formatting.h"
 
+#include "../Context.h"
 #include "../config/Config.h"
 #include "../util/Util.h"
 #include "Formatter.h"
 #include "Localisation.h"
+#include "LocalisationService.h"
 #include "StringIds.h"
 
 #include <cmath>
 #include <cstdint>
+#include <unordered_map>
 
 namespace OpenRCT2
 {
@@ -633,6 +636,34 @@ namespace OpenRCT2
         return FmtString(fmtc);
     }
 
+    const FmtTemplate& GetFmtTemplateById(StringId id)
+    {
+        struct TemplateCache
+        {
+            uint32_t Version{};
+            std::unordered_map<StringId, FmtTemplate> Templates;
+        };
+        thread_local TemplateCache cache;
+
+        const auto& localisationService = GetContext()->GetLocalisationService();
+        const auto version = localisationService.GetStringsVersion();
+        if (cache.Version != version)
+        {
+            cache.Templates.clear();
+            cache.Version = version;
+        }
+
+        auto [it, inserted] = cache.Templates.try_emplace(id);
+        if (inserted)
+        {
+            for (const auto& token : FmtString(localisationService.GetString(id)))
+            {
+                it->second.Tokens.push_back(token);
+            }
+        }
+        return it->second;
+    }
+
     FormatBuffer& GetThreadFormatStream()
     {
         thread_local FormatBuffer ss;
@@ -753,21 +784,24 @@ namespace OpenRCT2
         return value;
     }
 
-    static void BuildAnyArgListFromLegacyArgBuffer(const FmtString& fmt, std::vector<FormatArg_t>& anyArgs, const void*& args)
+    // Deeper nesting than this can only come from a string referencing itself through its arguments.
+    static constexpr int32_t MaxLegacyFormatDepth = 16;
+
+    static void FormatStringLegacy(FormatBuffer& ss, const FmtTemplate& fmt, const void*& args, int32_t depth)
     {
-        for (const auto& t : fmt)
+        for (const auto& token : fmt.Tokens)
         {
-            switch (t.kind)
+            switch (token.kind)
             {
                 case FormatToken::Comma32:
                 case FormatToken::Int32:
                 case FormatToken::Comma2dp32:
                 case FormatToken::Sprite:
-                    anyArgs.push_back(ReadFromArgs<int32_t>(args));
+                    FormatArgument(ss, token.kind, ReadFromArgs<int32_t>(args));
                     break;
                 case FormatToken::Currency2dp:
                 case FormatToken::Currency:
-                    anyArgs.push_back(ReadFromArgs<int64_t>(args));
+                    FormatArgument(ss, token.kind, ReadFromArgs<int64_t>(args));
                     break;
                 case FormatToken::UInt16:
                 case FormatToken::MonthYear:
@@ -775,26 +809,29 @@ namespace OpenRCT2
                 case FormatToken::Velocity:
                 case FormatToken::DurationShort:
                 case FormatToken::DurationLong:
-                    anyArgs.push_back(ReadFromArgs<uint16_t>(args));
+                    FormatArgument(ss, token.kind, ReadFromArgs<uint16_t>(args));
                     break;
                 case FormatToken::Comma16:
                 case FormatToken::Length:
                 case FormatToken::Comma1dp16:
-                    anyArgs.push_back(ReadFromArgs<int16_t>(args));
+                    FormatArgument(ss, token.kind, static_cast<int32_t>(ReadFromArgs<int16_t>(args)));
                     break;
                 case FormatToken::StringById:
                 {
                     auto stringId = ReadFromArgs<StringId>(args);
-                    anyArgs.push_back(stringId);
-                    BuildAnyArgListFromLegacyArgBuffer(GetFmtStringById(stringId), anyArgs, args);
+                    if (IsRealNameStringId(stringId))
+                    {
+                        FormatRealName(ss, stringId);
+                    }
+                    else if (depth < MaxLegacyFormatDepth)
+                    {
+                        FormatStringLegacy(ss, GetFmtTemplateById(stringId), args, depth + 1);
+                    }
                     break;
                 }
                 case FormatToken::String:
-                {
-                    auto sz = ReadFromArgs<const char*>(args);
-                    anyArgs.push_back(sz);
+                    FormatArgument(ss, token.kind, ReadFromArgs<const char*>(args));
                     break;
-                }
                 case FormatToken::Pop16:
                     args = reinterpret_cast<const char*>(reinterpret_cast<uintptr_t>(args) + 2);
                     break;
@@ -802,6 +839,7 @@ namespace OpenRCT2
                     args = reinterpret_cast<const char*>(reinterpret_cast<uintptr_t>(args) - 2);
                     break;
                 default:
+                    ss << token.text;
                     break;
             }
         }
@@ -809,26 +847,18 @@ namespace OpenRCT2
 
     size_t FormatStringLegacy(char* buffer, size_t bufferLen, StringId id, const void* args)
     {
-        thread_local std::vector<FormatArg_t> anyArgs;
-        anyArgs.clear();
-        auto fmt = GetFmtStringById(id);
-        BuildAnyArgListFromLegacyArgBuffer(fmt, anyArgs, args);
-        return FormatStringAny(buffer, bufferLen, fmt, anyArgs);
+        auto& ss = GetThreadFormatStream();
+        FormatStringLegacy(ss, GetFmtTemplateById(id), args, 0);
+        return CopyStringStreamToBuffer(buffer, bufferLen, ss);
     }
 
     static void FormatMonthYear(FormatBuffer& ss, int32_t month, int32_t year)
     {
-        thread_local std::vector<FormatArg_t> tempArgs;
-        tempArgs.clear();
-
-        auto fmt = GetFmtStringById(STR_DATE_FORMAT_MY);
         Formatter ft;
         ft.Add<uint16_t>(month);
         ft.Add<uint16_t>(year);
         const void* legacyArgs = ft.Data();
-        BuildAnyArgListFromLegacyArgBuffer(fmt, tempArgs, legacyArgs);
-        size_t argIndex = 0;
-        FormatStringAny(ss, fmt, tempArgs, argIndex);
+        FormatStringLegacy(ss, GetFmtTemplateById(STR_DATE_FORMAT_MY), legacyArgs, 0);
     }
 
 } // namespace OpenRCT2
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../common.h"
+#include "../core/FixedVector.h"
 #include "FormatCodes.h"
 #include "Language.h"
 
@@ -171,12 +172,13 @@ namespace OpenRCT2
         {
         private:
             std::string_view str;
-            size_t index;
+            size_t index{};
             Token current;
 
             void update();
 
         public:
+            iterator() = default;
             iterator(std::string_view s, size_t i);
             bool operator==(iterator& rhs);
             bool operator!=(iterator& rhs);
@@ -198,19 +200,34 @@ namespace OpenRCT2
         std::string WithoutFormatTokens() const;
     };
 
+    /**
+     * A format string that has already been split into tokens. Templates are built once per string id and kept
+     * until the language or object strings change, so hot paths do not need to parse the same string every frame.
+     * The tokens refer to the string owned by the localisation service.
+     */
+    struct FmtTemplate
+    {
+        std::vector<FmtString::Token> Tokens;
+    };
+
+    // Nested format strings are followed without touching the heap, one level per StringById argument.
+    static constexpr size_t FmtStringStackSize = 16;
+    using FmtStringStack = FixedVector<FmtString::iterator, FmtStringStackSize>;
+
     template<typename T> void FormatArgument(FormatBuffer& ss, FormatToken token, T arg);
 
     bool IsRealNameStringId(StringId id);
     void FormatRealName(FormatBuffer& ss, StringId id);
     FmtString GetFmtStringById(StringId id);
+    const FmtTemplate& GetFmtTemplateById(StringId id);
     FormatBuffer& GetThreadFormatStream();
     size_t CopyStringStreamToBuffer(char* buffer, size_t bufferLen, FormatBuffer& ss);
 
-    inline void FormatString(FormatBuffer& ss, std::stack<FmtString::iterator>& stack)
+    inline void FormatString(FormatBuffer& ss, FmtStringStack& stack)
     {
         while (!stack.empty())
         {
-            auto& it = stack.top();
+            auto& it = stack.back();
             while (!it.eol())
             {
                 const auto& token = *it;
@@ -220,16 +237,16 @@ namespace OpenRCT2
                 }
                 it++;
             }
-            stack.pop();
+            stack.pop_back();
         }
     }
 
     template<typename TArg0, typename... TArgs>
-    static void FormatString(FormatBuffer& ss, std::stack<FmtString::iterator>& stack, TArg0 arg0, TArgs&&... argN)
+    static void FormatString(FormatBuffer& ss, FmtStringStack& stack, TArg0 arg0, TArgs&&... argN)
     {
         while (!stack.empty())
         {
-            auto& it = stack.top();
+            auto& it = stack.back();
             while (!it.eol())
             {
                 auto token = *it++;
@@ -246,7 +263,7 @@ namespace OpenRCT2
 
                         auto subfmt = GetFmtStringById(stringId);
                         auto subit = subfmt.begin();
-                        stack.push(subit);
+                        stack.push_back(subit);
                         return FormatString(ss, stack, argN...);
                     }
                 }
@@ -258,14 +275,14 @@ namespace OpenRCT2
 
                 ss << token.text;
             }
-            stack.pop();
+            stack.pop_back();
         }
     }
 
     template<typename... TArgs> static void FormatString(FormatBuffer& ss, const FmtString& fmt, TArgs&&... argN)
     {
-        std::stack<FmtString::iterator> stack;
-        stack.push(fmt.begin());
+        FmtStringStack stack;
+        stack.push_back(fmt.begin());
         FormatString(ss, stack, argN...);
     }
 
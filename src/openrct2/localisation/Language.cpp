@@ -10,6 +10,7 @@
 #include "../Context.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
+#include "../drawing/Drawing.h"
 #include "../interface/FontFamilies.h"
 #include "../interface/Fonts.h"
 #include "../object/ObjectManager.h"
@@ -83,6 +84,7 @@ bool LanguageOpen(int32_t id)
         localisationService.OpenLanguage(id);
         // Objects and their localised strings need to be refreshed
         objectManager.ResetObjects();
+        ScrollingTextInvalidate();
         return true;
     }
     catch (const std::exception&)
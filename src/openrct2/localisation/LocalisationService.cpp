@@ -19,6 +19,7 @@
 #include "LanguagePack.h"
 #include "StringIds.h"
 
+#include <atomic>
 #include <stdexcept>
 
 using namespace OpenRCT2;
@@ -27,6 +28,9 @@ using namespace OpenRCT2::Localisation;
 static constexpr uint16_t BASE_OBJECT_STRING_ID = 0x2000;
 static constexpr uint16_t MAX_OBJECT_CACHED_STRINGS = 0x5000 - BASE_OBJECT_STRING_ID;
 
+// Shared by all instances so a new service never reports a version that was used by one that has been destroyed.
+static std::atomic<uint32_t> _stringsVersion{};
+
 LocalisationService::LocalisationService(const std::shared_ptr<IPlatformEnvironment>& env)
     : _env(env)
 {
@@ -37,7 +41,10 @@ LocalisationService::LocalisationService(const std::shared_ptr<IPlatformEnvironm
 }
 
 // Define implementation here to avoid including LanguagePack.h in header
-LocalisationService::~LocalisationService() = default;
+LocalisationService::~LocalisationService()
+{
+    _stringsVersion++;
+}
 
 const char* LocalisationService::GetString(StringId id) const
 {
@@ -134,6 +141,7 @@ void LocalisationService::OpenLanguage(int32_t id)
             throw std::runtime_error("Unable to open the English language file!");
         }
     }
+    _stringsVersion++;
 }
 
 void LocalisationService::CloseLanguages()
@@ -141,6 +149,7 @@ void LocalisationService::CloseLanguages()
     _languageOrder.clear();
     _loadedLanguages.clear();
     _currentLanguage = LANGUAGE_UNDEFINED;
+    _stringsVersion++;
 }
 
 std::tuple<StringId, StringId, StringId> LocalisationService::GetLocalisedScenarioStrings(
@@ -169,6 +178,7 @@ StringId LocalisationService::AllocateObjectString(const std::string& target)
         _objectStrings.resize(index + 1);
     }
     _objectStrings[index] = target;
+    _stringsVersion++;
 
     return stringId;
 }
@@ -181,11 +191,17 @@ void LocalisationService::FreeObjectString(StringId stringId)
         if (index < _objectStrings.size())
         {
             _objectStrings[index] = {};
+            _stringsVersion++;
         }
         _availableObjectStringIds.push(stringId);
     }
 }
 
+uint32_t LocalisationService::GetStringsVersion() const
+{
+    return _stringsVersion.load();
+}
+
 const std::vector<int32_t>& LocalisationService::GetLanguageOrder() const
 {
     return _languageOrder;
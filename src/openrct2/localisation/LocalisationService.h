@@ -58,6 +58,8 @@ namespace OpenRCT2::Localisation
         ~LocalisationService();
 
         const char* GetString(StringId id) const;
+        // Changes whenever a string previously returned by GetString may have been changed or freed.
+        uint32_t GetStringsVersion() const;
         std::tuple<StringId, StringId, StringId> GetLocalisedScenarioStrings(const std::string& scenarioFilename) const;
         std::string GetLanguagePath(uint32_t languageId) const;
 
@@ -11,6 +11,7 @@
 
 #include "../Context.h"
 #include "../Game.h"
+#include "../GameStateHash.h"
 #include "../GameStateSnapshots.h"
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
@@ -37,16 +38,20 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <stdexcept>
 
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
 
-#define NETWORK_STREAM_VERSION "12"
+#define NETWORK_STREAM_VERSION "16"
 
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
+// Block index of a state hash request that asks for all block hashes of a category instead of the leaves of one block.
+static constexpr uint32_t StateHashAllBlocks = std::numeric_limits<uint32_t>::max();
+
 static Peep* _pickup_peep = nullptr;
 static int32_t _pickup_peep_old_x = LOCATION_NULL;
 
@@ -137,6 +142,7 @@ NetworkBase::NetworkBase(OpenRCT2::IContext& context)
     client_command_handlers[NetworkCommand::ScriptsHeader] = &NetworkBase::Client_Handle_SCRIPTS_HEADER;
     client_command_handlers[NetworkCommand::ScriptsData] = &NetworkBase::Client_Handle_SCRIPTS_DATA;
     client_command_handlers[NetworkCommand::GameState] = &NetworkBase::Client_Handle_GAMESTATE;
+    client_command_handlers[NetworkCommand::StateHash] = &NetworkBase::Client_Handle_STATEHASH;
 
     server_command_handlers[NetworkCommand::Auth] = &NetworkBase::ServerHandleAuth;
     server_command_handlers[NetworkCommand::Chat] = &NetworkBase::ServerHandleChat;
@@ -147,6 +153,7 @@ NetworkBase::NetworkBase(OpenRCT2::IContext& context)
     server_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::ServerHandleMapRequest;
     server_command_handlers[NetworkCommand::RequestGameState] = &NetworkBase::ServerHandleRequestGamestate;
     server_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::ServerHandleHeartbeat;
+    server_command_handlers[NetworkCommand::RequestStateHash] = &NetworkBase::ServerHandleRequestStateHash;
 
     _chat_log_fs << std::unitbuf;
     _server_log_fs << std::unitbuf;
@@ -202,6 +209,7 @@ void NetworkBase::Close()
         player_list.clear();
         group_list.clear();
         _serverTickData.clear();
+        _stateHashReply.reset();
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
 
@@ -756,6 +764,27 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
     const ServerTickData storedTick = itTickData->second;
     _serverTickData.erase(itTickData);
 
+    // Leaves hashed before the map was received only match the server once all of them were re-hashed.
+    // Compared first so the differing category is known for the follow-up request whatever else differs.
+    _stateHashMismatch.reset();
+    if (storedTick.hasStateHash && tick >= _stateHashCheckTick)
+    {
+        const auto clientStateHash = GameStateHash::Get().GetCategoryHashes();
+        for (size_t i = 0; i < clientStateHash.size(); i++)
+        {
+            if (clientStateHash[i] != storedTick.stateHash[i])
+            {
+                const auto category = static_cast<GameStateHash::Category>(i);
+                LOG_INFO(
+                    "State hash mismatch in %s, client = %016llX, server = %016llX", GameStateHash::GetCategoryName(category),
+                    static_cast<unsigned long long>(clientStateHash[i]),
+                    static_cast<unsigned long long>(storedTick.stateHash[i]));
+                if (!_stateHashMismatch.has_value())
+                    _stateHashMismatch = category;
+            }
+        }
+    }
+
     if (storedTick.srand0 != srand0)
     {
         LOG_INFO("Srand0 mismatch, client = %08X, server = %08X", srand0, storedTick.srand0);
@@ -773,7 +802,56 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
         }
     }
 
-    return true;
+    return !_stateHashMismatch.has_value();
+}
+
+void NetworkBase::CheckStateHashReply()
+{
+    // The server's hashes can only be compared once the client has caught up with the tick they were taken at.
+    if (!_stateHashReply.has_value() || _stateHashReply->tick > gCurrentTicks)
+        return;
+
+    const auto reply = std::move(*_stateHashReply);
+    _stateHashReply.reset();
+    if (reply.tick < gCurrentTicks)
+    {
+        LOG_INFO("State hashes for tick %u arrived too late to be compared", reply.tick);
+        return;
+    }
+
+    const auto category = static_cast<GameStateHash::Category>(reply.category);
+    const auto* categoryName = GameStateHash::GetCategoryName(category);
+    const auto& stateHash = GameStateHash::Get();
+    if (reply.block == StateHashAllBlocks)
+    {
+        const auto& blocks = stateHash.GetBlocks(category);
+        for (size_t i = 0; i < reply.hashes.size(); i++)
+        {
+            if (i >= blocks.size() || blocks[i] != reply.hashes[i])
+            {
+                LOG_INFO("State hash mismatch in %s block %u at tick %u", categoryName, static_cast<uint32_t>(i), reply.tick);
+                Client_Send_RequestStateHash(reply.category, static_cast<uint32_t>(i));
+                return;
+            }
+        }
+        LOG_INFO("No %s block differs at tick %u", categoryName, reply.tick);
+    }
+    else
+    {
+        const auto& leaves = stateHash.GetLeaves(category);
+        const auto begin = static_cast<size_t>(reply.block) * GameStateHash::BlockSize;
+        for (size_t i = 0; i < reply.hashes.size(); i++)
+        {
+            if (begin + i >= leaves.size() || leaves[begin + i] != reply.hashes[i])
+            {
+                LOG_INFO(
+                    "State hash mismatch in %s at tick %u, first differing leaf is %s", categoryName, reply.tick,
+                    GameStateHash::GetLeafName(category, begin + i).c_str());
+                return;
+            }
+        }
+        LOG_INFO("No %s leaf in block %u differs at tick %u", categoryName, reply.block, reply.tick);
+    }
 }
 
 bool NetworkBase::IsDesynchronised() const noexcept
@@ -783,6 +861,14 @@ bool NetworkBase::IsDesynchronised() const noexcept
 
 bool NetworkBase::CheckDesynchronizaton()
 {
+    if (GetMode() == NETWORK_MODE_CLIENT)
+    {
+        // The state hash must be brought up to date every tick the same way the server does it, this continues
+        // after a desync so the follow-up hashes from the server can still be compared.
+        GameStateHash::Get().Update();
+        CheckStateHashReply();
+    }
+
     // Check synchronisation
     if (GetMode() == NETWORK_MODE_CLIENT && _serverState.state != NetworkServerStatus::Desynced
         && !CheckSRAND(gCurrentTicks, ScenarioRandState().s0))
@@ -801,6 +887,11 @@ bool NetworkBase::CheckDesynchronizaton()
         {
             Close();
         }
+        else if (_stateHashMismatch.has_value())
+        {
+            // Narrow the mismatch down to the first differing block and then leaf.
+            Client_Send_RequestStateHash(EnumValue(*_stateHashMismatch), StateHashAllBlocks);
+        }
 
         return true;
     }
@@ -1193,6 +1284,15 @@ void NetworkBase::Client_Send_RequestGameState(uint32_t tick)
     _serverConnection->QueuePacket(std::move(packet));
 }
 
+void NetworkBase::Client_Send_RequestStateHash(uint8_t category, uint32_t block)
+{
+    LOG_VERBOSE("Requesting state hashes from server for category %u, block %u", category, block);
+
+    NetworkPacket packet(NetworkCommand::RequestStateHash);
+    packet << category << block;
+    _serverConnection->QueuePacket(std::move(packet));
+}
+
 void NetworkBase::Client_Send_TOKEN()
 {
     LOG_VERBOSE("requesting token");
@@ -1527,6 +1627,8 @@ void NetworkBase::ServerSendTick()
         checksum_counter = 0;
         flags |= NETWORK_TICK_FLAG_CHECKSUMS;
     }
+    // The state hash only re-hashes what changed so it is cheap enough to send every tick.
+    flags |= NETWORK_TICK_FLAG_STATE_HASH;
     // Send flags always, so we can understand packet structure on the other end,
     // and allow for some expansion.
     packet << flags;
@@ -1535,8 +1637,48 @@ void NetworkBase::ServerSendTick()
         EntitiesChecksum checksum = GetAllEntitiesChecksum();
         packet.WriteString(checksum.ToString());
     }
+    if (flags & NETWORK_TICK_FLAG_STATE_HASH)
+    {
+        auto& stateHash = GameStateHash::Get();
+        stateHash.Update();
+        for (auto hash : stateHash.GetCategoryHashes())
+        {
+            packet << hash;
+        }
+    }
 
     SendPacketToClients(packet);
+
+    // Follow-up hashes are taken at the same point as the tick's hashes so clients can compare them at that tick.
+    for (auto& connection : client_connection_list)
+    {
+        if (connection->StateHashRequested)
+        {
+            ServerSendStateHash(*connection);
+        }
+    }
+}
+
+void NetworkBase::ServerSendStateHash(NetworkConnection& connection)
+{
+    connection.StateHashRequested = false;
+
+    const auto category = static_cast<GameStateHash::Category>(connection.StateHashCategory);
+    const auto& stateHash = GameStateHash::Get();
+    const auto block = connection.StateHashBlock;
+    const auto& hashes = block == StateHashAllBlocks ? stateHash.GetBlocks(category) : stateHash.GetLeaves(category);
+    const auto begin = block == StateHashAllBlocks ? 0 : static_cast<size_t>(block) * GameStateHash::BlockSize;
+    if (begin >= hashes.size())
+        return;
+
+    const auto count = block == StateHashAllBlocks ? hashes.size() : std::min(GameStateHash::BlockSize, hashes.size() - begin);
+    NetworkPacket packet(NetworkCommand::StateHash);
+    packet << gCurrentTicks << connection.StateHashCategory << block << static_cast<uint32_t>(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        packet << hashes[begin + i];
+    }
+    connection.QueuePacket(std::move(packet));
 }
 
 void NetworkBase::ServerSendPlayerInfo(int32_t playerId)
@@ -2229,6 +2371,20 @@ void NetworkBase::ServerHandleRequestGamestate(NetworkConnection& connection, Ne
     }
 }
 
+void NetworkBase::ServerHandleRequestStateHash(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint8_t category{};
+    uint32_t block{};
+    packet >> category >> block;
+    if (category >= GameStateHash::NumCategories)
+        return;
+
+    // Only the latest request is kept, it is answered along with the next tick.
+    connection.StateHashRequested = true;
+    connection.StateHashCategory = category;
+    connection.StateHashBlock = block;
+}
+
 void NetworkBase::ServerHandleHeartbeat(NetworkConnection& connection, NetworkPacket& packet)
 {
     LOG_VERBOSE("Client %s heartbeat", connection.Socket->GetHostName());
@@ -2523,6 +2679,22 @@ void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, Network
     }
 }
 
+void NetworkBase::Client_Handle_STATEHASH([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    StateHashReply reply;
+    uint32_t count{};
+    packet >> reply.tick >> reply.category >> reply.block >> count;
+    if (reply.category >= GameStateHash::NumCategories || count > packet.Header.Size / sizeof(uint64_t))
+        return;
+
+    reply.hashes.resize(count);
+    for (auto& hash : reply.hashes)
+    {
+        packet >> hash;
+    }
+    _stateHashReply = std::move(reply);
+}
+
 void NetworkBase::ServerHandleMapRequest(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t size;
@@ -2710,6 +2882,7 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
         GameActions::SuspendQueue();
 
         _serverTickData.clear();
+        _stateHashReply.reset();
         _clientMapLoaded = false;
     }
     if (size > chunk_buffer.size())
@@ -2751,6 +2924,7 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
             // WindowNetworkStatusOpen("Loaded new map from network");
             _serverState.state = NetworkServerStatus::Ok;
             _clientMapLoaded = true;
+            _stateHashCheckTick = gCurrentTicks + GameStateHash::ScrubTicks;
             gFirstTimeSaving = true;
 
             // Notify user he is now online and which shortcut key enables chat
@@ -3023,6 +3197,14 @@ void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connect
             tickData.spriteHash = text;
         }
     }
+    if (flags & NETWORK_TICK_FLAG_STATE_HASH)
+    {
+        tickData.hasStateHash = true;
+        for (auto& hash : tickData.stateHash)
+        {
+            packet >> hash;
+        }
+    }
 
     // Don't let the history grow too much.
     while (_serverTickData.size() >= 100)
@@ -3031,7 +3213,8 @@ void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connect
     }
 
     _serverState.tick = serverTick;
-    _serverTickData.emplace(serverTick, tickData);
+    // A paused server keeps sending the same tick, the last one reflects the state the tick will start with.
+    _serverTickData.insert_or_assign(serverTick, tickData);
 }
 
 void NetworkBase::Client_Handle_PLAYERINFO([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../GameStateHash.h"
 #include "../System.hpp"
 #include "../actions/GameAction.h"
 #include "../object/Object.h"
@@ -10,8 +11,10 @@
 #include "NetworkTypes.h"
 #include "NetworkUser.h"
 
+#include <array>
 #include <fstream>
 #include <memory>
+#include <optional>
 
 #ifndef DISABLE_NETWORK
 
@@ -101,10 +104,12 @@ public: // Server
     void ServerSendEventPlayerDisconnected(const char* playerName, const char* reason);
     void ServerSendObjectsList(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects) const;
     void ServerSendScripts(NetworkConnection& connection);
+    void ServerSendStateHash(NetworkConnection& connection);
 
     // Handlers
     void ServerHandleRequestGamestate(NetworkConnection& connection, NetworkPacket& packet);
     void ServerHandleHeartbeat(NetworkConnection& connection, NetworkPacket& packet);
+    void ServerHandleRequestStateHash(NetworkConnection& connection, NetworkPacket& packet);
     void ServerHandleAuth(NetworkConnection& connection, NetworkPacket& packet);
     void ServerClientJoined(std::string_view name, const std::string& keyhash, NetworkConnection& connection);
     void ServerHandleChat(NetworkConnection& connection, NetworkPacket& packet);
@@ -126,6 +131,7 @@ public: // Client
     void SendPacketToClients(const NetworkPacket& packet, bool front = false, bool gameCmd = false) const;
     bool CheckSRAND(uint32_t tick, uint32_t srand0);
     bool CheckDesynchronizaton();
+    void CheckStateHashReply();
     void RequestStateSnapshot();
     bool IsDesynchronised() const noexcept;
     NetworkServerState GetServerState() const noexcept;
@@ -135,6 +141,7 @@ public: // Client
 
     // Packet dispatchers.
     void Client_Send_RequestGameState(uint32_t tick);
+    void Client_Send_RequestStateHash(uint8_t category, uint32_t block);
     void Client_Send_TOKEN();
     void Client_Send_AUTH(
         const std::string& name, const std::string& password, const std::string& pubkey, const std::vector<uint8_t>& signature);
@@ -165,6 +172,7 @@ public: // Client
     void Client_Handle_SCRIPTS_HEADER(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_SCRIPTS_DATA(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_STATEHASH(NetworkConnection& connection, NetworkPacket& packet);
 
     std::vector<uint8_t> _challenge;
     std::map<uint32_t, GameAction::Callback_t> _gameActionCallbacks;
@@ -216,6 +224,17 @@ private: // Client Data
         uint32_t srand0;
         uint32_t tick;
         std::string spriteHash;
+        bool hasStateHash = false;
+        std::array<uint64_t, OpenRCT2::GameStateHash::NumCategories> stateHash{};
+    };
+
+    // Block or leaf hashes of one category, sent by the server after a state hash mismatch.
+    struct StateHashReply
+    {
+        uint32_t tick{};
+        uint8_t category{};
+        uint32_t block{};
+        std::vector<uint64_t> hashes;
     };
 
     struct ServerScriptsData
@@ -247,6 +266,9 @@ private: // Client Data
     SocketStatus _lastConnectStatus = SocketStatus::Closed;
     bool _requireReconnect = false;
     bool _clientMapLoaded = false;
+    uint32_t _stateHashCheckTick = 0;
+    std::optional<OpenRCT2::GameStateHash::Category> _stateHashMismatch;
+    std::optional<StateHashReply> _stateHashReply;
     ServerScriptsData _serverScriptsData{};
 };
 
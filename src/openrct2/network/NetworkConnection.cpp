@@ -131,6 +131,7 @@ void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
     if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
     {
         packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
+        _outboundSize.Set(_outboundSize.Get() + sizeof(NetworkPacket) + packet.Data.size());
         if (front)
         {
             // If the first packet was already partially sent add new packet to second position
@@ -166,6 +167,7 @@ void NetworkConnection::SendQueuedPackets()
 {
     while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
     {
+        _outboundSize.Set(_outboundSize.Get() - sizeof(NetworkPacket) - _outboundPackets.front().Data.size());
         _outboundPackets.pop_front();
     }
 }
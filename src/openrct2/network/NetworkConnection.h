@@ -11,6 +11,7 @@
 
 #ifndef DISABLE_NETWORK
 #    include "../common.h"
+#    include "../profiling/MemoryStats.h"
 #    include "NetworkKey.h"
 #    include "NetworkPacket.h"
 #    include "NetworkTypes.h"
@@ -37,6 +38,10 @@ public:
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
     bool ShouldDisconnect = false;
+    // Follow-up state hash request of a desynchronised client, answered along with the next tick.
+    bool StateHashRequested = false;
+    uint8_t StateHashCategory = 0;
+    uint32_t StateHashBlock = 0;
 
     NetworkConnection() noexcept;
 
@@ -63,6 +68,7 @@ public:
 
 private:
     std::deque<NetworkPacket> _outboundPackets;
+    OpenRCT2::MemoryStats::TrackedSize _outboundSize{ OpenRCT2::MemoryStats::Subsystem::Network };
     uint32_t _lastPacketTime = 0;
     std::string _lastDisconnectReason;
 
@@ -23,6 +23,7 @@ enum
 enum
 {
     NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
+    NETWORK_TICK_FLAG_STATE_HASH = 1 << 1,
 };
 
 enum
@@ -84,6 +85,8 @@ enum class NetworkCommand : uint32_t
     ScriptsHeader,
     ScriptsData,
     Heartbeat,
+    RequestStateHash,
+    StateHash,
     Max,
     Invalid = static_cast<uint32_t>(-1),
 };
@@ -156,6 +156,11 @@ void Object::PopulateTablesFromJson(IReadObjectContext* context, json_t& root)
     _usesFallbackImages = _imageTable.ReadJson(context, root);
 }
 
+void Object::ReadJsonStrings(json_t& root)
+{
+    _stringTable.ReadJson(root);
+}
+
 std::string Object::GetString(ObjectStringID index) const
 {
     return GetStringTable().GetString(index);
@@ -286,6 +286,12 @@ public:
     virtual void ReadJson(IReadObjectContext* /*context*/, json_t& /*root*/)
     {
     }
+    /**
+     * Reads only the strings of the object, which is all the object index needs from objects that do not add
+     * anything of their own to their repository item.
+     * @note root is deliberately left non-const: json_t behaviour changes when const
+     */
+    void ReadJsonStrings(json_t& root);
     virtual void ReadLegacy(IReadObjectContext* context, OpenRCT2::IStream* stream);
     virtual void Load() abstract;
     virtual void Unload() abstract;
@@ -108,6 +108,32 @@ public:
     }
 };
 
+/**
+ * Retrieves files from a .parkobj, the archive is only opened when a file is actually read from it.
+ */
+class DeferredZipDataRetriever : public IFileDataRetriever
+{
+private:
+    const std::string _path;
+
+public:
+    DeferredZipDataRetriever(std::string_view path)
+        : _path(path)
+    {
+    }
+
+    std::vector<uint8_t> GetData(std::string_view path) const override
+    {
+        auto archive = Zip::Open(_path, ZIP_ACCESS::READ);
+        return archive->GetFileData(path);
+    }
+
+    ObjectAsset GetAsset(std::string_view path) const override
+    {
+        return ObjectAsset(_path, path);
+    }
+};
+
 class ReadObjectContext : public IReadObjectContext
 {
 private:
@@ -216,7 +242,8 @@ namespace ObjectFactory
      * @note jRoot is deliberately left non-const: json_t behaviour changes when const
      */
     static std::unique_ptr<Object> CreateObjectFromJson(
-        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever, bool loadImageTable);
+        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever, bool loadImageTable,
+        bool metadataOnly = false);
 
     static ObjectSourceGame ParseSourceGame(const std::string& s)
     {
@@ -449,6 +476,138 @@ namespace ObjectFactory
         return nullptr;
     }
 
+    /**
+     * Parses an object JSON for the object index. Only the top level keys the index reads are kept and only the name is
+     * kept from the strings, everything else such as the images is skipped by the parser without building it.
+     */
+    static json_t ParseObjectMetadata(const std::vector<uint8_t>& data)
+    {
+        static constexpr std::string_view MetadataKeys[] = {
+            "id",
+            "objectType",
+            "version",
+            "originalId",
+            "authors",
+            "strings",
+            "sourceGame",
+            "properties",
+            "isCompatibilityObject",
+        };
+
+        std::string topLevelKey;
+        return json_t::parse(
+            data.begin(), data.end(), [&topLevelKey](int32_t depth, json_t::parse_event_t event, json_t& parsed) {
+                if (event != json_t::parse_event_t::key)
+                    return true;
+
+                if (depth == 1)
+                {
+                    topLevelKey = parsed.get<std::string>();
+                    return std::find(std::begin(MetadataKeys), std::end(MetadataKeys), topLevelKey)
+                        != std::end(MetadataKeys);
+                }
+                if (depth == 2 && topLevelKey == "strings")
+                {
+                    return parsed.get<std::string>() == "name";
+                }
+                return true;
+            });
+    }
+
+    std::unique_ptr<Object> CreateObjectMetadataFromZipFile(IObjectRepository& objectRepository, std::string_view path)
+    {
+        try
+        {
+            auto archive = Zip::Open(path, ZIP_ACCESS::READ);
+            auto jsonBytes = archive->GetFileData("object.json");
+            if (jsonBytes.empty())
+            {
+                throw std::runtime_error("Unable to open object.json.");
+            }
+
+            json_t jRoot = ParseObjectMetadata(jsonBytes);
+            if (jRoot.is_object())
+            {
+                auto fileDataRetriever = ZipDataRetriever(path, *archive);
+                return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, false, true);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to open or read '%s': %s", std::string(path).c_str(), e.what());
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<Object> CreateObjectMetadataFromJsonFile(IObjectRepository& objectRepository, const std::string& path)
+    {
+        LOG_VERBOSE("CreateObjectMetadataFromJsonFile(\"%s\")", path.c_str());
+
+        try
+        {
+            json_t jRoot = ParseObjectMetadata(File::ReadAllBytes(path));
+            auto fileDataRetriever = FileSystemDataRetriever(Path::GetDirectory(path));
+            return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, false, true);
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to open or read '%s': %s", path.c_str(), e.what());
+        }
+        return nullptr;
+    }
+
+    std::vector<uint8_t> ReadObjectDefinition(std::string_view path)
+    {
+        std::vector<uint8_t> jsonBytes;
+        if (String::IEquals(Path::GetExtension(path), ".parkobj"))
+        {
+            auto archive = Zip::Open(path, ZIP_ACCESS::READ);
+            jsonBytes = archive->GetFileData("object.json");
+        }
+        else
+        {
+            jsonBytes = File::ReadAllBytes(path);
+        }
+
+        // The images are dropped while parsing, the definition is only used by instances that do not load them
+        json_t jRoot = json_t::parse(
+            jsonBytes.begin(), jsonBytes.end(), [](int32_t depth, json_t::parse_event_t event, json_t& parsed) {
+                if (event == json_t::parse_event_t::key && depth == 1)
+                {
+                    const auto& key = parsed.get_ref<const std::string&>();
+                    return key != "images" && key != "noCsgImages";
+                }
+                return true;
+            });
+        if (!jRoot.is_object())
+        {
+            throw std::runtime_error("Object JSON root was not an object");
+        }
+        return json_t::to_msgpack(jRoot);
+    }
+
+    std::unique_ptr<Object> CreateObjectFromDefinition(
+        IObjectRepository& objectRepository, std::string_view path, const uint8_t* data, size_t dataSize)
+    {
+        try
+        {
+            json_t jRoot = json_t::from_msgpack(data, data + dataSize);
+            if (String::IEquals(Path::GetExtension(path), ".parkobj"))
+            {
+                auto fileDataRetriever = DeferredZipDataRetriever(path);
+                return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, false);
+            }
+
+            auto fileDataRetriever = FileSystemDataRetriever(Path::GetDirectory(path));
+            return CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever, false);
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to read definition of '%s': %s", std::string(path).c_str(), e.what());
+        }
+        return nullptr;
+    }
+
     std::unique_ptr<Object> CreateObjectFromJsonFile(
         IObjectRepository& objectRepository, const std::string& path, bool loadImages)
     {
@@ -500,8 +659,18 @@ namespace ObjectFactory
         }
     }
 
+    /**
+     * Objects of these types add information from their properties to their repository item, so their properties have
+     * to be read for the object index as well.
+     */
+    static bool HasRepositoryItemProperties(ObjectType type)
+    {
+        return type == ObjectType::Ride || type == ObjectType::SceneryGroup || type == ObjectType::FootpathSurface;
+    }
+
     std::unique_ptr<Object> CreateObjectFromJson(
-        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever, bool loadImageTable)
+        IObjectRepository& objectRepository, json_t& jRoot, const IFileDataRetriever* fileRetriever, bool loadImageTable,
+        bool metadataOnly)
     {
         if (!jRoot.is_object())
         {
@@ -557,7 +726,14 @@ namespace ObjectFactory
             result->SetDescriptor(descriptor);
             result->MarkAsJsonObject();
             auto readContext = ReadObjectContext(objectRepository, id, loadImageTable, fileRetriever);
-            result->ReadJson(&readContext, jRoot);
+            if (metadataOnly && !HasRepositoryItemProperties(objectType))
+            {
+                result->ReadJsonStrings(jRoot);
+            }
+            else
+            {
+                result->ReadJson(&readContext, jRoot);
+            }
             if (readContext.WasError())
             {
                 throw std::runtime_error("Object has errors");
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string_view>
+#include <vector>
 
 struct IObjectRepository;
 class Object;
@@ -32,4 +33,22 @@ namespace ObjectFactory
 
     [[nodiscard]] std::unique_ptr<Object> CreateObjectFromJsonFile(
         IObjectRepository& objectRepository, const std::string& path, bool loadImages);
+
+    /**
+     * Creates an object with only what the object index needs: the identifier, version, name, authors and sources, and
+     * the properties of objects that add them to their repository item. The object has to be loaded with one of the
+     * functions above before it can be used.
+     */
+    [[nodiscard]] std::unique_ptr<Object> CreateObjectMetadataFromJsonFile(
+        IObjectRepository& objectRepository, const std::string& path);
+    [[nodiscard]] std::unique_ptr<Object> CreateObjectMetadataFromZipFile(
+        IObjectRepository& objectRepository, std::string_view path);
+
+    /**
+     * Reads the JSON of a .json or .parkobj object without its images, encoded as MessagePack. Objects created from it
+     * never load images, so it is only used by instances without graphics.
+     */
+    [[nodiscard]] std::vector<uint8_t> ReadObjectDefinition(std::string_view path);
+    [[nodiscard]] std::unique_ptr<Object> CreateObjectFromDefinition(
+        IObjectRepository& objectRepository, std::string_view path, const uint8_t* data, size_t dataSize);
 } // namespace ObjectFactory
@@ -30,6 +30,7 @@
 #include "../object/Object.h"
 #include "../park/Legacy.h"
 #include "../platform/Platform.h"
+#include "../profiling/MemoryStats.h"
 #include "../rct12/SawyerChunkReader.h"
 #include "../rct12/SawyerChunkWriter.h"
 #include "../scenario/ScenarioRepository.h"
@@ -40,6 +41,7 @@
 #include "ObjectList.h"
 #include "ObjectManager.h"
 #include "RideObject.h"
+#include "SharedObjectCache.h"
 
 #include <algorithm>
 #include <memory>
@@ -103,11 +105,11 @@ public:
         auto extension = Path::GetExtension(path);
         if (String::IEquals(extension, ".json"))
         {
-            object = ObjectFactory::CreateObjectFromJsonFile(_objectRepository, path, false);
+            object = ObjectFactory::CreateObjectMetadataFromJsonFile(_objectRepository, path);
         }
         else if (String::IEquals(extension, ".parkobj"))
         {
-            object = ObjectFactory::CreateObjectFromZipFile(_objectRepository, path, false);
+            object = ObjectFactory::CreateObjectMetadataFromZipFile(_objectRepository, path);
         }
         else
         {
@@ -183,6 +185,8 @@ class ObjectRepository final : public IObjectRepository
     std::vector<ObjectRepositoryItem> _items;
     ObjectIdentifierMap _newItemMap;
     ObjectEntryMap _itemMap;
+    MemoryStats::TrackedSize _itemsSize{ MemoryStats::Subsystem::Objects };
+    std::unique_ptr<SharedObjectCache> _sharedCache;
 
 public:
     explicit ObjectRepository(const std::shared_ptr<IPlatformEnvironment>& env)
@@ -202,6 +206,19 @@ public:
         auto items = _fileIndex.LoadOrBuild(language);
         AddItems(items);
         SortItems();
+
+        // The shared cache has no images, so only instances without graphics can load objects from it
+        _sharedCache = nullptr;
+        if (gOpenRCT2NoGraphics)
+        {
+            auto cachePath = _env->GetFilePath(PATHID::CACHE_OBJECTS_SHARED);
+            _sharedCache = SharedObjectCache::Open(cachePath);
+            if (_sharedCache != nullptr)
+            {
+                Console::WriteLine(
+                    "Using shared object cache '%s' (%zu objects)", cachePath.c_str(), _sharedCache->GetNumEntries());
+            }
+        }
     }
 
     void Construct(int32_t language) override
@@ -266,6 +283,15 @@ public:
     {
         Guard::ArgumentNotNull(ori, GUARD_LINE);
 
+        if (_sharedCache != nullptr)
+        {
+            auto object = _sharedCache->LoadObject(*this, *ori);
+            if (object != nullptr)
+            {
+                return object;
+            }
+        }
+
         auto extension = Path::GetExtension(ori->Path);
         if (String::IEquals(extension, ".json"))
         {
@@ -362,6 +388,19 @@ private:
         _items.clear();
         _newItemMap.clear();
         _itemMap.clear();
+        _itemsSize.Set(0);
+    }
+
+    static size_t GetItemSize(const ObjectRepositoryItem& item)
+    {
+        auto size = sizeof(ObjectRepositoryItem) + item.Identifier.size() + item.Path.size() + item.Name.size()
+            + item.Sources.size() * sizeof(ObjectSourceGame)
+            + item.SceneryGroupInfo.Entries.size() * sizeof(ObjectEntryDescriptor);
+        for (const auto& author : item.Authors)
+        {
+            size += sizeof(std::string) + author.size();
+        }
+        return size;
     }
 
     void SortItems()
@@ -430,6 +469,7 @@ private:
             auto copy = item;
             copy.Id = index;
             _items.push_back(std::move(copy));
+            _itemsSize.Set(_itemsSize.Get() + GetItemSize(item));
             if (!item.Identifier.empty())
             {
                 _newItemMap[item.Identifier] = index;
@@ -445,6 +485,7 @@ private:
         {
             const auto id = conflict->Id;
             const auto oldPath = conflict->Path;
+            _itemsSize.Set(_itemsSize.Get() - GetItemSize(_items[id]) + GetItemSize(item));
             _items[id] = item;
             _items[id].Id = id;
             if (!item.Identifier.empty())
@@ -0,0 +1,333 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "SharedObjectCache.h"
+
+#include "../Diagnostic.h"
+#include "../core/Console.hpp"
+#include "../core/Crypt.h"
+#include "../core/File.h"
+#include "../core/FileStream.h"
+#include "../core/MemoryStream.h"
+#include "../core/String.hpp"
+#include "../rct12/SawyerChunkReader.h"
+#include "Object.h"
+#include "ObjectFactory.h"
+#include "ObjectRepository.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static constexpr uint32_t CacheMagicNumber = 0x4843424F; // OBCH
+// Increment to make older caches unusable
+static constexpr uint32_t CacheVersion = 1;
+
+enum class CacheEntryKind : uint8_t
+{
+    // MessagePack encoded JSON of a .json or .parkobj object.
+    Definition,
+    // Decoded chunk of a .dat object.
+    LegacyChunk,
+};
+
+struct SharedObjectCache::Header
+{
+    uint32_t MagicNumber;
+    uint32_t Version;
+    uint64_t NumEntries;
+};
+
+struct SharedObjectCache::Entry
+{
+    uint64_t KeyHash;
+    uint64_t KeyOffset;
+    uint64_t PathOffset;
+    uint64_t DataOffset;
+    uint64_t DataLength;
+    uint64_t FileSize;
+    uint64_t LastModified;
+    std::array<uint8_t, 8> ContentHash;
+    RCTObjectEntry LegacyEntry;
+    uint32_t KeyLength;
+    uint32_t PathLength;
+    CacheEntryKind Kind;
+    uint8_t Padding[7];
+};
+
+// Legacy objects have no identifier, they are keyed by their object entry instead.
+static std::string GetKey(const ObjectRepositoryItem& item)
+{
+    if (item.Generation == ObjectGeneration::JSON)
+    {
+        return item.Identifier;
+    }
+    const auto& entry = item.ObjectEntry;
+    return String::StdFormat("%08X|%.8s|%08X", entry.flags, entry.name, entry.checksum);
+}
+
+// Instances may have the cache mapped while it is rebuilt, which prevents replacing or deleting the file on some
+// platforms. Every build is written to a new file instead and the file at the cache path names the current one.
+static std::string GetDataPath(const std::string& path, uint32_t generation)
+{
+    return path + "." + std::to_string(generation);
+}
+
+// Returns 0 if there is no cache at the path.
+static uint32_t GetGeneration(const std::string& path)
+{
+    if (!File::Exists(path))
+    {
+        return 0;
+    }
+    const auto text = File::ReadAllText(path);
+    return static_cast<uint32_t>(std::strtoul(text.c_str(), nullptr, 10));
+}
+
+static uint64_t GetKeyHash(std::string_view key)
+{
+    // FNV-1a
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (auto c : key)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+SharedObjectCache::SharedObjectCache(std::unique_ptr<MemoryMappedFile>&& file)
+    : _file(std::move(file))
+    , _header(reinterpret_cast<const Header*>(_file->GetData()))
+    , _entries(reinterpret_cast<const Entry*>(_file->GetData() + sizeof(Header)))
+{
+}
+
+std::unique_ptr<SharedObjectCache> SharedObjectCache::Open(const std::string& path)
+{
+    if (!File::Exists(path))
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        const auto dataPath = GetDataPath(path, GetGeneration(path));
+        if (!File::Exists(dataPath))
+        {
+            Console::WriteLine("Shared object cache '%s' is out of date, rebuild it with build-object-cache", path.c_str());
+            return nullptr;
+        }
+
+        auto file = std::make_unique<MemoryMappedFile>(dataPath);
+        if (file->GetLength() < sizeof(Header))
+        {
+            throw IOException("File too small");
+        }
+
+        const auto* header = reinterpret_cast<const Header*>(file->GetData());
+        if (header->MagicNumber != CacheMagicNumber || header->Version != CacheVersion
+            || header->NumEntries > (file->GetLength() - sizeof(Header)) / sizeof(Entry))
+        {
+            Console::WriteLine("Shared object cache '%s' is out of date, rebuild it with build-object-cache", path.c_str());
+            return nullptr;
+        }
+
+        // Check every entry once, so lookups can trust the offsets
+        const auto* entries = reinterpret_cast<const Entry*>(file->GetData() + sizeof(Header));
+        for (uint64_t i = 0; i < header->NumEntries; i++)
+        {
+            const auto& entry = entries[i];
+            const auto length = file->GetLength();
+            if (entry.KeyOffset > length || entry.KeyLength > length - entry.KeyOffset || entry.PathOffset > length
+                || entry.PathLength > length - entry.PathOffset || entry.DataOffset > length
+                || entry.DataLength > length - entry.DataOffset)
+            {
+                throw IOException("Entry out of range");
+            }
+        }
+        return std::unique_ptr<SharedObjectCache>(new SharedObjectCache(std::move(file)));
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Unable to open shared object cache '%s': %s", path.c_str(), e.what());
+    }
+    return nullptr;
+}
+
+size_t SharedObjectCache::GetNumEntries() const
+{
+    return static_cast<size_t>(_header->NumEntries);
+}
+
+std::unique_ptr<Object> SharedObjectCache::LoadObject(
+    IObjectRepository& objectRepository, const ObjectRepositoryItem& item) const
+{
+    const auto key = GetKey(item);
+    const auto keyHash = GetKeyHash(key);
+    const auto* data = _file->GetData();
+
+    const auto* entriesEnd = _entries + _header->NumEntries;
+    auto it = std::lower_bound(
+        _entries, entriesEnd, keyHash, [](const Entry& entry, uint64_t hash) { return entry.KeyHash < hash; });
+    for (; it != entriesEnd && it->KeyHash == keyHash; it++)
+    {
+        const auto& entry = *it;
+        const auto entryKey = std::string_view(reinterpret_cast<const char*>(data + entry.KeyOffset), entry.KeyLength);
+        const auto entryPath = std::string_view(reinterpret_cast<const char*>(data + entry.PathOffset), entry.PathLength);
+        if (entryKey != key || entryPath != item.Path)
+        {
+            continue;
+        }
+
+        // A file with a new modification time can still have the same content, e.g. after a redeploy
+        if (File::GetSize(item.Path) != entry.FileSize
+            || (File::GetLastModified(item.Path) != entry.LastModified
+                && entry.ContentHash != Crypt::FNV1a(File::ReadAllBytes(item.Path).data(), entry.FileSize)))
+        {
+            LOG_VERBOSE("Shared object cache: '%s' has changed", item.Path.c_str());
+            return nullptr;
+        }
+
+        if (entry.Kind == CacheEntryKind::LegacyChunk)
+        {
+            return ObjectFactory::CreateObjectFromLegacyData(
+                objectRepository, &entry.LegacyEntry, data + entry.DataOffset, entry.DataLength);
+        }
+        return ObjectFactory::CreateObjectFromDefinition(
+            objectRepository, item.Path, data + entry.DataOffset, entry.DataLength);
+    }
+    return nullptr;
+}
+
+size_t SharedObjectCache::Build(IObjectRepository& objectRepository, const std::string& path)
+{
+    struct PendingEntry
+    {
+        Entry CacheEntry{};
+        std::string Key;
+        std::string Path;
+        std::vector<uint8_t> Data;
+    };
+
+    std::vector<PendingEntry> pending;
+    const auto numObjects = objectRepository.GetNumObjects();
+    const auto* items = objectRepository.GetObjects();
+    for (size_t i = 0; i < numObjects; i++)
+    {
+        const auto& item = items[i];
+        try
+        {
+            PendingEntry result;
+            auto& entry = result.CacheEntry;
+
+            auto fileData = File::ReadAllBytes(item.Path);
+            entry.FileSize = fileData.size();
+            entry.LastModified = File::GetLastModified(item.Path);
+            entry.ContentHash = Crypt::FNV1a(fileData.data(), fileData.size());
+
+            std::unique_ptr<Object> object;
+            if (item.Generation == ObjectGeneration::JSON)
+            {
+                entry.Kind = CacheEntryKind::Definition;
+                result.Data = ObjectFactory::ReadObjectDefinition(item.Path);
+                object = ObjectFactory::CreateObjectFromDefinition(
+                    objectRepository, item.Path, result.Data.data(), result.Data.size());
+            }
+            else
+            {
+                auto stream = OpenRCT2::MemoryStream(fileData.data(), fileData.size());
+                auto chunkReader = SawyerChunkReader(&stream);
+                entry.Kind = CacheEntryKind::LegacyChunk;
+                entry.LegacyEntry = stream.ReadValue<RCTObjectEntry>();
+                auto chunk = chunkReader.ReadChunk();
+                result.Data.assign(
+                    static_cast<const uint8_t*>(chunk->GetData()),
+                    static_cast<const uint8_t*>(chunk->GetData()) + chunk->GetLength());
+                object = ObjectFactory::CreateObjectFromLegacyData(
+                    objectRepository, &entry.LegacyEntry, result.Data.data(), result.Data.size());
+            }
+
+            // Objects that fail to load are left out, so they report their errors when loaded from their file
+            if (object == nullptr)
+            {
+                continue;
+            }
+
+            result.Key = GetKey(item);
+            result.Path = item.Path;
+            entry.KeyHash = GetKeyHash(result.Key);
+            pending.push_back(std::move(result));
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to add '%s' to the shared object cache: %s", item.Path.c_str(), e.what());
+        }
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const PendingEntry& a, const PendingEntry& b) {
+        return a.CacheEntry.KeyHash < b.CacheEntry.KeyHash;
+    });
+
+    // Layout: header, entries sorted by key hash, then the key, path and data of every entry
+    uint64_t offset = sizeof(Header) + pending.size() * sizeof(Entry);
+    for (auto& result : pending)
+    {
+        auto& entry = result.CacheEntry;
+        entry.KeyOffset = offset;
+        entry.KeyLength = static_cast<uint32_t>(result.Key.size());
+        entry.PathOffset = entry.KeyOffset + entry.KeyLength;
+        entry.PathLength = static_cast<uint32_t>(result.Path.size());
+        entry.DataOffset = entry.PathOffset + entry.PathLength;
+        entry.DataLength = result.Data.size();
+        offset = entry.DataOffset + entry.DataLength;
+    }
+
+    const auto previousGeneration = GetGeneration(path);
+    const auto generation = previousGeneration + 1;
+    {
+        auto fs = OpenRCT2::FileStream(GetDataPath(path, generation), OpenRCT2::FILE_MODE_WRITE);
+        fs.WriteValue(Header{ CacheMagicNumber, CacheVersion, pending.size() });
+        for (const auto& result : pending)
+        {
+            fs.WriteValue(result.CacheEntry);
+        }
+        for (const auto& result : pending)
+        {
+            fs.Write(result.Key.data(), result.Key.size());
+            fs.Write(result.Path.data(), result.Path.size());
+            fs.Write(result.Data.data(), result.Data.size());
+        }
+    }
+
+    // Nothing maps the file naming the current build, so it can be replaced while the cache is in use
+    const auto tempPath = path + ".tmp";
+    const auto generationText = std::to_string(generation);
+    File::WriteAllBytes(tempPath, generationText.data(), generationText.size());
+    if (!File::Move(tempPath, path))
+    {
+        File::Delete(tempPath);
+        File::Delete(GetDataPath(path, generation));
+        throw IOException("Unable to replace " + path);
+    }
+
+    // Builds that are still mapped by a running instance can not be deleted yet, they are retried on the next build
+    for (uint32_t i = 1; i <= previousGeneration; i++)
+    {
+        const auto oldPath = GetDataPath(path, i);
+        if (File::Exists(oldPath) && !File::Delete(oldPath))
+        {
+            LOG_VERBOSE("Unable to delete old shared object cache '%s'", oldPath.c_str());
+        }
+    }
+    return pending.size();
+}
@@ -0,0 +1,49 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../core/MemoryMappedFile.h"
+
+#include <memory>
+#include <string>
+
+class Object;
+struct IObjectRepository;
+struct ObjectRepositoryItem;
+
+/**
+ * A file of object definitions without images, built once for all objects in the repository and mapped read-only by
+ * instances without graphics. Loading an object from it skips opening and parsing the object file and the mapped pages
+ * are shared between all instances on the same host. Objects are looked up by their identifier and only used while
+ * their file is unchanged.
+ */
+class SharedObjectCache
+{
+private:
+    struct Header;
+    struct Entry;
+
+    std::unique_ptr<MemoryMappedFile> _file;
+    const Header* _header{};
+    const Entry* _entries{};
+
+    explicit SharedObjectCache(std::unique_ptr<MemoryMappedFile>&& file);
+
+public:
+    // Returns nullptr if there is no cache at the path or it can not be used.
+    static std::unique_ptr<SharedObjectCache> Open(const std::string& path);
+    // Writes the definitions of all objects in the repository, returns how many were written.
+    static size_t Build(IObjectRepository& objectRepository, const std::string& path);
+
+    size_t GetNumEntries() const;
+
+    // Returns nullptr if the object is not in the cache or its file changed since the cache was built.
+    std::unique_ptr<Object> LoadObject(IObjectRepository& objectRepository, const ObjectRepositoryItem& item) const;
+};
@@ -1026,6 +1026,8 @@ PaintEntryPool::Node* PaintEntryPool::AllocateNode()
     else
     {
         result = new (std::nothrow) PaintEntryPool::Node();
+        if (result != nullptr)
+            _allocatedSize.Set(_allocatedSize.Get() + sizeof(PaintEntryPool::Node));
     }
     return result;
 }
@@ -13,6 +13,7 @@
 #include "../core/FixedVector.h"
 #include "../drawing/Drawing.h"
 #include "../interface/Colour.h"
+#include "../profiling/MemoryStats.h"
 #include "../world/Location.hpp"
 #include "../world/Map.h"
 #include "Boundbox.h"
@@ -167,6 +168,8 @@ public:
 private:
     std::vector<Node*> _available;
     std::mutex _mutex;
+    // Size of every node allocated by the pool, including those still in use by chains.
+    OpenRCT2::MemoryStats::TrackedSize _allocatedSize{ OpenRCT2::MemoryStats::Subsystem::Paint };
 
     Node* AllocateNode();
 
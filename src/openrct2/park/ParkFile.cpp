@@ -16,12 +16,14 @@
 #include "../OpenRCT2.h"
 #include "../ParkImporter.h"
 #include "../Version.h"
+#include "../config/Config.h"
 #include "../core/Console.hpp"
 #include "../core/Crypt.h"
 #include "../core/DataSerialiser.h"
 #include "../core/File.h"
 #include "../core/OrcaStream.hpp"
 #include "../core/Path.hpp"
+#include "../core/Timer.hpp"
 #include "../drawing/Drawing.h"
 #include "../entity/Balloon.h"
 #include "../entity/Duck.h"
@@ -59,6 +61,7 @@
 
 #include <cstdint>
 #include <ctime>
+#include <future>
 #include <numeric>
 #include <optional>
 #include <string_view>
@@ -102,9 +105,19 @@ namespace OpenRCT2
         ObjectList RequiredObjects;
         std::vector<const ObjectRepositoryItem*> ExportObjectsList;
         bool OmitTracklessRides{};
+        // Compresses chunks in blocks; such files require PARK_FILE_BLOCK_COMPRESSION_MIN_VERSION to load.
+        bool UseBlockCompression{};
 
     private:
+        struct DecodedTiles
+        {
+            TileCoordsXY MapSize;
+            std::vector<TileElement> Elements;
+        };
+
         std::unique_ptr<OrcaStream> _os;
+        // Declared after _os so that a pending decode is waited on before the stream is released
+        std::future<DecodedTiles> _decodedTiles;
         ObjectEntryIndex _pathToSurfaceMap[MAX_PATH_OBJECTS];
         ObjectEntryIndex _pathToQueueSurfaceMap[MAX_PATH_OBJECTS];
         ObjectEntryIndex _pathToRailingsMap[MAX_PATH_OBJECTS];
@@ -127,29 +140,41 @@ namespace OpenRCT2
             return targetVersion > PARK_FILE_CURRENT_VERSION;
         }
 
-        void Load(const std::string_view path)
+        void Load(const std::string_view path, bool beginImport = false)
         {
             FileStream fs(path, FILE_MODE_OPEN);
-            Load(fs);
+            Load(fs, beginImport);
         }
 
-        void Load(IStream& stream)
+        void Load(IStream& stream, bool beginImport = false)
         {
+            Timer timer;
             _os = std::make_unique<OrcaStream>(stream, OrcaStream::Mode::READING);
             ThrowIfIncompatibleVersion();
+            LOG_VERBOSE("ParkFile: read and decompressed in %.2f ms", timer.GetElapsedTimeAndRestart().count() * 1000.0f);
 
             RequiredObjects = {};
             ReadWriteObjectsChunk(*_os);
             ReadWritePackedObjectsChunk(*_os);
+            LOG_VERBOSE("ParkFile: read object list in %.2f ms", timer.GetElapsedTime().count() * 1000.0f);
+
+            if (beginImport)
+            {
+                BeginDecodeTilesChunk();
+            }
         }
 
         void Import()
         {
             auto& os = *_os;
+            Timer timer;
             ReadWriteTilesChunk(os);
+            LOG_VERBOSE("ParkFile: imported tiles in %.2f ms", timer.GetElapsedTimeAndRestart().count() * 1000.0f);
             ReadWriteBannersChunk(os);
             ReadWriteRidesChunk(os);
+            LOG_VERBOSE("ParkFile: imported banners and rides in %.2f ms", timer.GetElapsedTimeAndRestart().count() * 1000.0f);
             ReadWriteEntitiesChunk(os);
+            LOG_VERBOSE("ParkFile: imported entities in %.2f ms", timer.GetElapsedTimeAndRestart().count() * 1000.0f);
             ReadWriteScenarioChunk(os);
             ReadWriteGeneralChunk(os);
             ReadWriteParkChunk(os);
@@ -167,16 +192,44 @@ namespace OpenRCT2
 
             // Initial cash will eventually be removed
             gInitialCash = gCash;
+            LOG_VERBOSE("ParkFile: imported remaining chunks in %.2f ms", timer.GetElapsedTime().count() * 1000.0f);
         }
 
         void Save(IStream& stream)
         {
             OrcaStream os(stream, OrcaStream::Mode::WRITING);
+            WriteChunks(os);
+        }
+
+        /**
+         * Serialises the park without compressing it, so that the expensive part of saving can be
+         * done away from the game thread with OrcaStream::PendingWrite::WriteTo.
+         */
+        OrcaStream::PendingWrite Snapshot()
+        {
+            OrcaStream os;
+            WriteChunks(os);
+            return os.Detach();
+        }
 
+        void Save(const std::string_view path)
+        {
+            FileStream fs(path, FILE_MODE_WRITE);
+            Save(fs);
+        }
+
+    private:
+        void WriteChunks(OrcaStream& os)
+        {
             auto& header = os.GetHeader();
             header.Magic = PARK_FILE_MAGIC;
             header.TargetVersion = PARK_FILE_CURRENT_VERSION;
             header.MinVersion = PARK_FILE_MIN_VERSION;
+            if (UseBlockCompression)
+            {
+                header.Compression = OrcaStream::COMPRESSION_ZLIB_BLOCKS;
+                header.MinVersion = PARK_FILE_BLOCK_COMPRESSION_MIN_VERSION;
+            }
 
             ReadWriteAuthoringChunk(os);
             ReadWriteObjectsChunk(os);
@@ -197,12 +250,7 @@ namespace OpenRCT2
             ReadWritePackedObjectsChunk(os);
         }
 
-        void Save(const std::string_view path)
-        {
-            FileStream fs(path, FILE_MODE_WRITE);
-            Save(fs);
-        }
-
+    public:
         ScenarioIndexEntry ReadScenarioChunk()
         {
             ScenarioIndexEntry entry{};
@@ -1047,98 +1095,121 @@ namespace OpenRCT2
             }
         }
 
-        void ReadWriteTilesChunk(OrcaStream& os)
+        /**
+         * Starts decoding the tiles chunk on a worker thread. This only depends on the header and
+         * the objects chunk, so it can run while the caller loads the required objects.
+         */
+        void BeginDecodeTilesChunk()
         {
-            auto* pathToSurfaceMap = _pathToSurfaceMap;
-            auto* pathToQueueSurfaceMap = _pathToQueueSurfaceMap;
-            auto* pathToRailingsMap = _pathToRailingsMap;
+            _decodedTiles = std::async(std::launch::async, [this] {
+                Timer timer;
+                auto result = DecodeTilesChunk(*_os);
+                LOG_VERBOSE("ParkFile: decoded tiles in %.2f ms", timer.GetElapsedTime().count() * 1000.0f);
+                return result;
+            });
+        }
 
-            auto found = os.ReadWriteChunk(
-                ParkFileChunkType::TILES,
-                [pathToSurfaceMap, pathToQueueSurfaceMap, pathToRailingsMap, &os](OrcaStream::ChunkStream& cs) {
-                    cs.ReadWrite(gMapSize.x);
-                    cs.ReadWrite(gMapSize.y);
+        DecodedTiles DecodeTilesChunk(const OrcaStream& os) const
+        {
+            const auto* pathToSurfaceMap = _pathToSurfaceMap;
+            const auto* pathToQueueSurfaceMap = _pathToQueueSurfaceMap;
+            const auto* pathToRailingsMap = _pathToRailingsMap;
+            const auto version = os.GetHeader().TargetVersion;
 
-                    if (cs.GetMode() == OrcaStream::Mode::READING)
+            DecodedTiles result;
+            auto found = os.ReadChunkDetached(
+                ParkFileChunkType::TILES,
+                [pathToSurfaceMap, pathToQueueSurfaceMap, pathToRailingsMap, version,
+                 &result](OrcaStream::ChunkStream& cs) {
+                    cs.ReadWrite(result.MapSize.x);
+                    cs.ReadWrite(result.MapSize.y);
+
+                    auto numElements = cs.Read<uint32_t>();
+                    auto& tileElements = result.Elements;
+                    tileElements.resize(numElements);
+                    cs.Read(tileElements.data(), tileElements.size() * sizeof(TileElement));
+
+                    // The fix-ups below only depend on the element itself, so they are applied
+                    // to the flat element array before it is handed over to the map.
+                    for (auto& element : tileElements)
                     {
-                        OpenRCT2::GetContext()->GetGameState()->InitAll(gMapSize);
-
-                        auto numElements = cs.Read<uint32_t>();
-
-                        std::vector<TileElement> tileElements;
-                        tileElements.resize(numElements);
-                        cs.Read(tileElements.data(), tileElements.size() * sizeof(TileElement));
-                        SetTileElements(std::move(tileElements));
+                        if (element.GetType() == TileElementType::Path)
                         {
-                            TileElementIterator it;
-                            TileElementIteratorBegin(&it);
-                            while (TileElementIteratorNext(&it))
+                            auto* pathElement = element.AsPath();
+                            if (pathElement->HasLegacyPathEntry())
                             {
-                                if (it.element->GetType() == TileElementType::Path)
+                                auto pathEntryIndex = pathElement->GetLegacyPathEntryIndex();
+                                if (pathToRailingsMap[pathEntryIndex] != OBJECT_ENTRY_INDEX_NULL)
                                 {
-                                    auto* pathElement = it.element->AsPath();
-                                    if (pathElement->HasLegacyPathEntry())
-                                    {
-                                        auto pathEntryIndex = pathElement->GetLegacyPathEntryIndex();
-                                        if (pathToRailingsMap[pathEntryIndex] != OBJECT_ENTRY_INDEX_NULL)
-                                        {
-                                            if (pathElement->IsQueue())
-                                                pathElement->SetSurfaceEntryIndex(pathToQueueSurfaceMap[pathEntryIndex]);
-                                            else
-                                                pathElement->SetSurfaceEntryIndex(pathToSurfaceMap[pathEntryIndex]);
+                                    if (pathElement->IsQueue())
+                                        pathElement->SetSurfaceEntryIndex(pathToQueueSurfaceMap[pathEntryIndex]);
+                                    else
+                                        pathElement->SetSurfaceEntryIndex(pathToSurfaceMap[pathEntryIndex]);
 
-                                            pathElement->SetRailingsEntryIndex(pathToRailingsMap[pathEntryIndex]);
-                                        }
-                                    }
-                                }
-                                else if (it.element->GetType() == TileElementType::Track)
-                                {
-                                    auto* trackElement = it.element->AsTrack();
-                                    auto trackType = trackElement->GetTrackType();
-                                    if (TrackTypeMustBeMadeInvisible(
-                                            trackElement->GetRideType(), trackType, os.GetHeader().TargetVersion))
-                                    {
-                                        it.element->SetInvisible(true);
-                                    }
-                                    if (os.GetHeader().TargetVersion < BlockBrakeImprovementsVersion)
-                                    {
-                                        if (trackType == TrackElemType::Brakes)
-                                            trackElement->SetBrakeClosed(true);
-                                        if (trackType == TrackElemType::BlockBrakes)
-                                            trackElement->SetBrakeBoosterSpeed(kRCT2DefaultBlockBrakeSpeed);
-                                    }
-                                }
-                                else if (
-                                    it.element->GetType() == TileElementType::SmallScenery && os.GetHeader().TargetVersion < 23)
-                                {
-                                    auto* sceneryElement = it.element->AsSmallScenery();
-                                    // Previous formats stored the needs supports flag in the primary colour
-                                    // We have moved it into a flags field to support extended colour sets
-                                    bool needsSupports = sceneryElement->GetPrimaryColour()
-                                        & RCT12_SMALL_SCENERY_ELEMENT_NEEDS_SUPPORTS_FLAG;
-                                    if (needsSupports)
-                                    {
-                                        sceneryElement->SetPrimaryColour(
-                                            sceneryElement->GetPrimaryColour()
-                                            & ~RCT12_SMALL_SCENERY_ELEMENT_NEEDS_SUPPORTS_FLAG);
-                                        sceneryElement->SetNeedsSupports();
-                                    }
+                                    pathElement->SetRailingsEntryIndex(pathToRailingsMap[pathEntryIndex]);
                                 }
                             }
                         }
-                        ParkEntranceUpdateLocations();
-                    }
-                    else
-                    {
-                        auto tileElements = GetReorganisedTileElementsWithoutGhosts();
-                        cs.Write(static_cast<uint32_t>(tileElements.size()));
-                        cs.Write(tileElements.data(), tileElements.size() * sizeof(TileElement));
+                        else if (element.GetType() == TileElementType::Track)
+                        {
+                            auto* trackElement = element.AsTrack();
+                            auto trackType = trackElement->GetTrackType();
+                            if (TrackTypeMustBeMadeInvisible(trackElement->GetRideType(), trackType, version))
+                            {
+                                element.SetInvisible(true);
+                            }
+                            if (version < BlockBrakeImprovementsVersion)
+                            {
+                                if (trackType == TrackElemType::Brakes)
+                                    trackElement->SetBrakeClosed(true);
+                                if (trackType == TrackElemType::BlockBrakes)
+                                    trackElement->SetBrakeBoosterSpeed(kRCT2DefaultBlockBrakeSpeed);
+                            }
+                        }
+                        else if (element.GetType() == TileElementType::SmallScenery && version < 23)
+                        {
+                            auto* sceneryElement = element.AsSmallScenery();
+                            // Previous formats stored the needs supports flag in the primary colour
+                            // We have moved it into a flags field to support extended colour sets
+                            bool needsSupports = sceneryElement->GetPrimaryColour()
+                                & RCT12_SMALL_SCENERY_ELEMENT_NEEDS_SUPPORTS_FLAG;
+                            if (needsSupports)
+                            {
+                                sceneryElement->SetPrimaryColour(
+                                    sceneryElement->GetPrimaryColour() & ~RCT12_SMALL_SCENERY_ELEMENT_NEEDS_SUPPORTS_FLAG);
+                                sceneryElement->SetNeedsSupports();
+                            }
+                        }
                     }
                 });
             if (!found)
             {
                 throw std::runtime_error("No tiles chunk found.");
             }
+            return result;
+        }
+
+        void ReadWriteTilesChunk(OrcaStream& os)
+        {
+            if (os.GetMode() == OrcaStream::Mode::READING)
+            {
+                auto tiles = _decodedTiles.valid() ? _decodedTiles.get() : DecodeTilesChunk(os);
+
+                gMapSize = tiles.MapSize;
+                OpenRCT2::GetContext()->GetGameState()->InitAll(gMapSize);
+                SetTileElements(std::move(tiles.Elements));
+                ParkEntranceUpdateLocations();
+                return;
+            }
+
+            os.ReadWriteChunk(ParkFileChunkType::TILES, [](OrcaStream::ChunkStream& cs) {
+                cs.ReadWrite(gMapSize.x);
+                cs.ReadWrite(gMapSize.y);
+
+                auto tileElements = GetReorganisedTileElementsWithoutGhosts();
+                cs.Write(static_cast<uint32_t>(tileElements.size()));
+                cs.Write(tileElements.data(), tileElements.size() * sizeof(TileElement));
+            });
         }
 
         void UpdateTrackElementsRideType()
@@ -2526,6 +2597,14 @@ void ParkFileExporter::Export(IStream& stream)
     parkFile->Save(stream);
 }
 
+std::function<void(IStream&)> ParkFileExporter::ExportDeferred()
+{
+    auto parkFile = std::make_unique<OpenRCT2::ParkFile>();
+    parkFile->ExportObjectsList = ExportObjectsList;
+    auto pendingWrite = std::make_shared<OrcaStream::PendingWrite>(parkFile->Snapshot());
+    return [pendingWrite](IStream& stream) { pendingWrite->WriteTo(stream); };
+}
+
 enum : uint32_t
 {
     S6_SAVE_FLAG_EXPORT = 1 << 0,
@@ -2533,6 +2612,31 @@ enum : uint32_t
     S6_SAVE_FLAG_AUTOMATIC = 1u << 31,
 };
 
+// Shared by ScenarioSave and ScenarioSaveInBackground so both write the same park.
+static void PrepareScenarioSave(int32_t flags)
+{
+    gIsAutosave = flags & S6_SAVE_FLAG_AUTOMATIC;
+    if (!gIsAutosave)
+    {
+        WindowCloseConstructionWindows();
+    }
+
+    PrepareMapForSave();
+}
+
+static std::unique_ptr<OpenRCT2::ParkFile> CreateParkFileForSave(int32_t flags)
+{
+    auto parkFile = std::make_unique<OpenRCT2::ParkFile>();
+    if (flags & S6_SAVE_FLAG_EXPORT)
+    {
+        auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
+        parkFile->ExportObjectsList = objManager.GetPackableObjects();
+    }
+    parkFile->OmitTracklessRides = true;
+    parkFile->UseBlockCompression = gConfigGeneral.ParkBlockCompression;
+    return parkFile;
+}
+
 int32_t ScenarioSave(u8string_view path, int32_t flags)
 {
     if (flags & S6_SAVE_FLAG_SCENARIO)
@@ -2544,24 +2648,12 @@ int32_t ScenarioSave(u8string_view path, int32_t flags)
         LOG_VERBOSE("saving game");
     }
 
-    gIsAutosave = flags & S6_SAVE_FLAG_AUTOMATIC;
-    if (!gIsAutosave)
-    {
-        WindowCloseConstructionWindows();
-    }
-
-    PrepareMapForSave();
+    PrepareScenarioSave(flags);
 
     bool result = false;
-    auto parkFile = std::make_unique<OpenRCT2::ParkFile>();
     try
     {
-        if (flags & S6_SAVE_FLAG_EXPORT)
-        {
-            auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
-            parkFile->ExportObjectsList = objManager.GetPackableObjects();
-        }
-        parkFile->OmitTracklessRides = true;
+        auto parkFile = CreateParkFileForSave(flags);
         if (flags & S6_SAVE_FLAG_SCENARIO)
         {
             // s6exporter->SaveScenario(path);
@@ -2612,6 +2704,50 @@ int32_t ScenarioSave(u8string_view path, int32_t flags)
     return result;
 }
 
+std::future<bool> ScenarioSaveInBackground(u8string_view path, int32_t flags)
+{
+    LOG_VERBOSE("saving game in the background");
+
+    PrepareScenarioSave(flags);
+
+    // Serialising reads the game state so it has to happen here, compressing and writing the
+    // serialised chunks does not.
+    OrcaStream::PendingWrite pendingWrite;
+    try
+    {
+        auto parkFile = CreateParkFileForSave(flags);
+        pendingWrite = parkFile->Snapshot();
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR(e.what());
+
+        std::promise<bool> failed;
+        failed.set_value(false);
+        return failed.get_future();
+    }
+
+    if (!(flags & S6_SAVE_FLAG_AUTOMATIC))
+    {
+        gScreenAge = 0;
+    }
+
+    return std::async(
+        std::launch::async, [pendingWrite = std::move(pendingWrite), path = u8string(path)]() mutable {
+            try
+            {
+                FileStream fs(path, FILE_MODE_WRITE);
+                pendingWrite.WriteTo(fs);
+                return true;
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Unable to write %s: %s", path.c_str(), e.what());
+                return false;
+            }
+        });
+}
+
 class ParkFileImporter final : public IParkImporter
 {
 private:
@@ -2621,6 +2757,18 @@ private:
     const IObjectRepository& _objectRepository;
     std::unique_ptr<OpenRCT2::ParkFile> _parkFile;
 
+    // Callers that skip the object check only want the park details, so decoding of the
+    // tiles is only started ahead of Import for callers that go on to load objects.
+    ParkLoadResult Load(const u8string& path, bool beginImport)
+    {
+        _parkFile = std::make_unique<OpenRCT2::ParkFile>();
+        _parkFile->Load(path, beginImport);
+
+        auto result = ParkLoadResult(std::move(_parkFile->RequiredObjects));
+        result.SemiCompatibleVersion = _parkFile->IsSemiCompatibleVersion(result.MinVersion, result.TargetVersion);
+        return result;
+    }
+
 public:
     ParkFileImporter(IObjectRepository& objectRepository)
         : _objectRepository(objectRepository)
@@ -2629,29 +2777,24 @@ public:
 
     ParkLoadResult Load(const u8string& path) override
     {
-        _parkFile = std::make_unique<OpenRCT2::ParkFile>();
-        _parkFile->Load(path);
-
-        auto result = ParkLoadResult(std::move(_parkFile->RequiredObjects));
-        result.SemiCompatibleVersion = _parkFile->IsSemiCompatibleVersion(result.MinVersion, result.TargetVersion);
-        return result;
+        return Load(path, true);
     }
 
     ParkLoadResult LoadSavedGame(const u8string& path, bool skipObjectCheck = false) override
     {
-        return Load(path);
+        return Load(path, !skipObjectCheck);
     }
 
     ParkLoadResult LoadScenario(const u8string& path, bool skipObjectCheck = false) override
     {
-        return Load(path);
+        return Load(path, !skipObjectCheck);
     }
 
     ParkLoadResult LoadFromStream(
         OpenRCT2::IStream* stream, bool isScenario, bool skipObjectCheck = false, const u8string& path = {}) override
     {
         _parkFile = std::make_unique<OpenRCT2::ParkFile>();
-        _parkFile->Load(*stream);
+        _parkFile->Load(*stream, !skipObjectCheck);
 
         auto result = ParkLoadResult(std::move(_parkFile->RequiredObjects));
         result.SemiCompatibleVersion = _parkFile->IsSemiCompatibleVersion(result.MinVersion, result.TargetVersion);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <string_view>
 #include <vector>
 
@@ -9,11 +10,14 @@ struct ObjectRepositoryItem;
 namespace OpenRCT2
 {
     // Current version that is saved.
-    constexpr uint32_t PARK_FILE_CURRENT_VERSION = 30;
+    constexpr uint32_t PARK_FILE_CURRENT_VERSION = 31;
 
     // The minimum version that is forwards compatible with the current version.
     constexpr uint32_t PARK_FILE_MIN_VERSION = 30;
 
+    // The minimum version that can read files whose chunks are compressed in blocks, only set for such files.
+    constexpr uint32_t PARK_FILE_BLOCK_COMPRESSION_MIN_VERSION = 31;
+
     // The minimum version that is backwards compatible with the current version.
     // If this is increased beyond 0, uncomment the checks in ParkFile.cpp and Context.cpp!
     constexpr uint32_t PARK_FILE_MIN_SUPPORTED_VERSION = 0x0;
@@ -30,4 +34,10 @@ public:
 
     void Export(std::string_view path);
     void Export(OpenRCT2::IStream& stream);
+
+    /**
+     * Serialises the park straight away and returns a function that compresses and writes it out,
+     * which does not touch the game state and can be called from another thread.
+     */
+    std::function<void(OpenRCT2::IStream&)> ExportDeferred();
 };
@@ -279,7 +279,7 @@ static uint8_t FootpathElementNextInDirection(TileCoordsXYZ loc, PathElement* pa
     }
 
     loc += TileDirectionDelta[chosenDirection];
-    nextTileElement = MapGetFirstElementAt(loc);
+    nextTileElement = MapGetFirstElementOfTypeAt(loc, TileElementType::Path);
     do
     {
         if (nextTileElement == nullptr)
@@ -1285,7 +1285,7 @@ Direction OriginalPathfinding::ChooseDirection(const TileCoordsXYZ& loc, Peep& p
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
     // Get the path element at this location
-    TileElement* dest_tile_element = MapGetFirstElementAt(loc);
+    TileElement* dest_tile_element = MapGetFirstElementOfTypeAt(loc, TileElementType::Path);
     /* Where there are multiple matching map elements placed with zero
      * clearance, save the first one for later use to determine the path
      * slope - this maintains the original behaviour (which only processes
@@ -1843,7 +1843,7 @@ static void GetRideQueueEnd(TileCoordsXYZ& loc)
         }
         nextTile += TileDirectionDelta[direction];
 
-        tileElement = MapGetFirstElementAt(nextTile);
+        tileElement = MapGetFirstElementOfTypeAt(nextTile, TileElementType::Path);
         found = false;
         if (tileElement == nullptr)
             break;
@@ -0,0 +1,72 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MemoryStats.h"
+
+#include <array>
+#include <atomic>
+
+namespace OpenRCT2::MemoryStats
+{
+    struct Counter
+    {
+        std::atomic<int64_t> CurrentBytes{};
+        std::atomic<int64_t> PeakBytes{};
+    };
+
+    static std::array<Counter, NumSubsystems> _counters;
+
+    void Add(Subsystem subsystem, int64_t bytes)
+    {
+        auto& counter = _counters[static_cast<size_t>(subsystem)];
+        const auto current = counter.CurrentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+        auto peak = counter.PeakBytes.load(std::memory_order_relaxed);
+        while (current > peak && !counter.PeakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    Usage GetUsage(Subsystem subsystem)
+    {
+        const auto& counter = _counters[static_cast<size_t>(subsystem)];
+        return { counter.CurrentBytes.load(std::memory_order_relaxed), counter.PeakBytes.load(std::memory_order_relaxed) };
+    }
+
+    void ResetPeaks()
+    {
+        for (auto& counter : _counters)
+        {
+            counter.PeakBytes.store(counter.CurrentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    const char* GetSubsystemName(Subsystem subsystem)
+    {
+        switch (subsystem)
+        {
+            case Subsystem::Paint:
+                return "paint";
+            case Subsystem::TTF:
+                return "ttf";
+            case Subsystem::Objects:
+                return "objects";
+            case Subsystem::Network:
+                return "network";
+            case Subsystem::Scripting:
+                return "scripting";
+            case Subsystem::Snapshots:
+                return "snapshots";
+            case Subsystem::Sprites:
+                return "sprites";
+            default:
+                return "unknown";
+        }
+    }
+} // namespace OpenRCT2::MemoryStats
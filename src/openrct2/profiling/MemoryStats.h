@@ -0,0 +1,116 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Memory accounting per subsystem. Subsystems report how many bytes they currently hold, either by
+ * calling Add directly or through a TrackedSize member, and the current and peak values can be queried
+ * at any time. The counters are atomic so they can be updated from any thread.
+ */
+namespace OpenRCT2::MemoryStats
+{
+    enum class Subsystem : uint8_t
+    {
+        Paint,
+        TTF,
+        Objects,
+        Network,
+        Scripting,
+        Snapshots,
+        Sprites,
+        Count,
+    };
+    static constexpr size_t NumSubsystems = static_cast<size_t>(Subsystem::Count);
+
+    struct Usage
+    {
+        int64_t CurrentBytes{};
+        int64_t PeakBytes{};
+    };
+
+    // Adds the given number of bytes to the subsystem, a negative number releases them.
+    void Add(Subsystem subsystem, int64_t bytes);
+    Usage GetUsage(Subsystem subsystem);
+    // Sets the peak of every subsystem back to its current usage.
+    void ResetPeaks();
+
+    const char* GetSubsystemName(Subsystem subsystem);
+
+    /**
+     * Holds a number of bytes accounted to a subsystem and releases them when destroyed, for use as a
+     * member of the object that owns the memory.
+     */
+    class TrackedSize
+    {
+    private:
+        Subsystem _subsystem;
+        size_t _size{};
+
+    public:
+        explicit TrackedSize(Subsystem subsystem)
+            : _subsystem(subsystem)
+        {
+        }
+        TrackedSize(const TrackedSize& other)
+            : _subsystem(other._subsystem)
+        {
+            Set(other._size);
+        }
+        TrackedSize(TrackedSize&& other) noexcept
+            : _subsystem(other._subsystem)
+            , _size(other._size)
+        {
+            other._size = 0;
+        }
+        ~TrackedSize()
+        {
+            Set(0);
+        }
+
+        TrackedSize& operator=(const TrackedSize& other)
+        {
+            if (this != &other)
+            {
+                Set(0);
+                _subsystem = other._subsystem;
+                Set(other._size);
+            }
+            return *this;
+        }
+        TrackedSize& operator=(TrackedSize&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Set(0);
+                _subsystem = other._subsystem;
+                _size = other._size;
+                other._size = 0;
+            }
+            return *this;
+        }
+
+        size_t Get() const
+        {
+            return _size;
+        }
+
+        void Set(size_t size)
+        {
+            if (size != _size)
+            {
+                Add(_subsystem, static_cast<int64_t>(size) - static_cast<int64_t>(_size));
+                _size = size;
+            }
+        }
+    };
+} // namespace OpenRCT2::MemoryStats
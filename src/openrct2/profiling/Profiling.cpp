@@ -9,11 +9,17 @@
 
 #include "Profiling.h"
 
+#include "../Diagnostic.h"
+
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <limits>
+#include <memory>
 #include <stack>
+#include <unordered_map>
 
 namespace OpenRCT2::Profiling
 {
@@ -120,6 +126,126 @@ namespace OpenRCT2::Profiling
             return Registry;
         }
 
+        enum class TracePhase : uint8_t
+        {
+            Begin,
+            End,
+            Tick,
+        };
+
+        struct TraceEvent
+        {
+            const Function* Func;
+            int64_t TimeNs;
+            uint32_t Tick;
+            TracePhase Phase;
+        };
+
+        // Maximum number of events recorded per thread, later events are dropped.
+        static constexpr size_t MaxTraceEvents = 512 * 1024;
+
+        // Events are only written by the thread owning the buffer. The count is published after the event has been
+        // written so the exporting thread never sees a partial event. Starting a trace never touches the buffers, the
+        // owning thread discards its events itself once it notices that they belong to an earlier trace generation.
+        struct TraceBuffer
+        {
+            uint32_t ThreadIndex{};
+            bool InUse{};
+            std::unique_ptr<TraceEvent[]> Events;
+            std::atomic<size_t> Count{};
+            std::atomic<size_t> Dropped{};
+            std::atomic<uint32_t> Generation{};
+        };
+
+        static std::mutex _traceBuffersMutex;
+        static std::vector<std::unique_ptr<TraceBuffer>> _traceBuffers;
+
+        static std::atomic<bool> _tracing{};
+        static std::atomic<bool> _traceArmed{};
+        static std::atomic<uint32_t> _traceGeneration{};
+        static uint32_t _traceFirstTick{};
+        static uint32_t _traceLastTick{};
+
+        // Hands the buffer back when the thread exits so that a later thread can reuse it.
+        struct TraceBufferHandle
+        {
+            TraceBuffer* Buffer{};
+
+            ~TraceBufferHandle()
+            {
+                if (Buffer != nullptr)
+                {
+                    std::scoped_lock lock(_traceBuffersMutex);
+                    Buffer->InUse = false;
+                }
+            }
+        };
+
+        static thread_local TraceBufferHandle _traceBuffer;
+
+        static TraceBuffer& GetTraceBuffer()
+        {
+            if (_traceBuffer.Buffer == nullptr)
+            {
+                std::scoped_lock lock(_traceBuffersMutex);
+                auto it = std::find_if(
+                    _traceBuffers.begin(), _traceBuffers.end(), [](const auto& buffer) { return !buffer->InUse; });
+                if (it == _traceBuffers.end())
+                {
+                    auto buffer = std::make_unique<TraceBuffer>();
+                    buffer->ThreadIndex = static_cast<uint32_t>(_traceBuffers.size());
+                    buffer->Events = std::make_unique<TraceEvent[]>(MaxTraceEvents);
+                    it = _traceBuffers.insert(_traceBuffers.end(), std::move(buffer));
+                }
+                (*it)->InUse = true;
+                _traceBuffer.Buffer = it->get();
+            }
+            return *_traceBuffer.Buffer;
+        }
+
+        static void AddTraceEvent(const Function* func, TracePhase phase, uint32_t tick)
+        {
+            const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+
+            auto& buffer = GetTraceBuffer();
+            const auto generation = _traceGeneration.load(std::memory_order_acquire);
+            if (buffer.Generation.load(std::memory_order_relaxed) != generation)
+            {
+                buffer.Count.store(0, std::memory_order_relaxed);
+                buffer.Dropped.store(0, std::memory_order_relaxed);
+                buffer.Generation.store(generation, std::memory_order_release);
+            }
+
+            const auto index = buffer.Count.load(std::memory_order_relaxed);
+            if (index >= MaxTraceEvents)
+            {
+                buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            buffer.Events[index] = TraceEvent{ func, time, tick, phase };
+            buffer.Count.store(index + 1, std::memory_order_release);
+        }
+
+        void TraceEnter(const Function& func)
+        {
+            AddTraceEvent(&func, TracePhase::Begin, 0);
+        }
+
+        void TraceExit(const Function& func)
+        {
+            AddTraceEvent(&func, TracePhase::End, 0);
+        }
+
+        struct NamedFunction : FunctionInternal
+        {
+            std::string FunctionName;
+
+            const char* GetName() const noexcept override
+            {
+                return FunctionName.c_str();
+            }
+        };
+
     } // namespace Detail
 
     const std::vector<Function*>& GetData()
@@ -127,6 +253,153 @@ namespace OpenRCT2::Profiling
         return Detail::GetRegistry();
     }
 
+    Function& GetNamedFunction(std::string_view name)
+    {
+        static std::unordered_map<std::string, std::unique_ptr<Detail::NamedFunction>> NamedFunctions;
+
+        auto key = std::string(name);
+        auto it = NamedFunctions.find(key);
+        if (it == NamedFunctions.end())
+        {
+            auto func = std::make_unique<Detail::NamedFunction>();
+            func->FunctionName = key;
+            it = NamedFunctions.emplace(std::move(key), std::move(func)).first;
+        }
+        return *it->second;
+    }
+
+    void StartTrace(uint32_t firstTick, uint32_t lastTick)
+    {
+        StopTrace();
+        Detail::_traceGeneration.fetch_add(1, std::memory_order_acq_rel);
+        Detail::_traceFirstTick = firstTick;
+        Detail::_traceLastTick = lastTick;
+        Detail::_traceArmed = true;
+    }
+
+    void StopTrace()
+    {
+        Detail::_traceArmed = false;
+        Detail::_tracing = false;
+    }
+
+    bool IsTracing()
+    {
+        return Detail::_tracing.load(std::memory_order_relaxed);
+    }
+
+    void TraceTick(uint32_t tick)
+    {
+        if (!Detail::_traceArmed)
+            return;
+
+        if (tick > Detail::_traceLastTick)
+        {
+            StopTrace();
+            return;
+        }
+        if (tick >= Detail::_traceFirstTick)
+        {
+            Detail::_tracing = true;
+            Detail::AddTraceEvent(nullptr, Detail::TracePhase::Tick, tick);
+        }
+    }
+
+    static void WriteJsonString(std::ofstream& out, const char* str)
+    {
+        out << '"';
+        for (; *str != '\0'; str++)
+        {
+            if (*str == '"' || *str == '\\')
+                out << '\\';
+            out << *str;
+        }
+        out << '"';
+    }
+
+    bool ExportTrace(const std::string& filePath)
+    {
+        std::ofstream out(filePath);
+        if (!out.is_open())
+            return false;
+
+        std::scoped_lock lock(Detail::_traceBuffersMutex);
+
+        // Buffers that have not been written to since the trace was started still hold events of an earlier trace.
+        const auto generation = Detail::_traceGeneration.load(std::memory_order_acquire);
+        auto getCount = [generation](const Detail::TraceBuffer& buffer) -> size_t {
+            if (buffer.Generation.load(std::memory_order_acquire) != generation)
+                return 0;
+            return buffer.Count.load(std::memory_order_acquire);
+        };
+
+        auto startTimeNs = std::numeric_limits<int64_t>::max();
+        for (const auto& buffer : Detail::_traceBuffers)
+        {
+            if (getCount(*buffer) > 0)
+                startTimeNs = std::min(startTimeNs, buffer->Events[0].TimeNs);
+        }
+
+        out << "{\"traceEvents\":[\n";
+        out << std::fixed << std::setprecision(3);
+        bool first = true;
+        for (const auto& buffer : Detail::_traceBuffers)
+        {
+            const auto count = getCount(*buffer);
+            if (count == 0)
+                continue;
+
+            if (!first)
+                out << ",\n";
+            first = false;
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->ThreadIndex
+                << ",\"args\":{\"name\":\"Thread " << buffer->ThreadIndex << "\"}}";
+
+            // Scopes that were entered before the trace started only have their end recorded, those ends are dropped so
+            // that every end in the trace matches a begin.
+            size_t depth = 0;
+            for (size_t i = 0; i < count; i++)
+            {
+                const auto& event = buffer->Events[i];
+                if (event.Phase == Detail::TracePhase::Begin)
+                {
+                    depth++;
+                }
+                else if (event.Phase == Detail::TracePhase::End)
+                {
+                    if (depth == 0)
+                        continue;
+                    depth--;
+                }
+
+                out << ",\n{\"ts\":" << (event.TimeNs - startTimeNs) / 1000.0 << ",\"pid\":1,\"tid\":" << buffer->ThreadIndex;
+                switch (event.Phase)
+                {
+                    case Detail::TracePhase::Begin:
+                        out << ",\"ph\":\"B\",\"name\":";
+                        WriteJsonString(out, event.Func->GetName());
+                        break;
+                    case Detail::TracePhase::End:
+                        out << ",\"ph\":\"E\"";
+                        break;
+                    case Detail::TracePhase::Tick:
+                        out << ",\"ph\":\"i\",\"s\":\"g\",\"name\":\"tick " << event.Tick << "\"";
+                        break;
+                }
+                out << "}";
+            }
+
+            const auto dropped = buffer->Dropped.load();
+            if (dropped > 0)
+            {
+                LOG_WARNING("Trace buffer of thread %u was full, %zu events were dropped", buffer->ThreadIndex, dropped);
+            }
+        }
+        out << "\n]}\n";
+
+        return true;
+    }
+
     void ResetData()
     {
         for (auto* func : Detail::GetRegistry())
@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -157,28 +158,53 @@ namespace OpenRCT2::Profiling
         void FunctionEnter(Function& func);
         void FunctionExit(Function& func);
 
+        void TraceEnter(const Function& func);
+        void TraceExit(const Function& func);
+
     } // namespace Detail
 
+    // Records a timeline of every profiled scope on every thread, starting at firstTick up to and including lastTick.
+    void StartTrace(uint32_t firstTick, uint32_t lastTick);
+    void StopTrace();
+    bool IsTracing();
+
+    // Called at the start of every game tick, starts and stops the trace when the tick range is entered or left.
+    void TraceTick(uint32_t tick);
+
+    // Writes the recorded timeline as a Chrome trace, which can be opened with chrome://tracing or Perfetto.
+    bool ExportTrace(const std::string& filePath);
+
     template<typename T> class ScopedProfiling
     {
         bool _enabled;
+        bool _tracing;
         T& _func;
 
     public:
         ScopedProfiling(T& func)
             : _enabled{ IsEnabled() }
+            , _tracing{ IsTracing() }
             , _func(func)
         {
             if (_enabled)
             {
                 Detail::FunctionEnter(_func);
             }
+            if (_tracing)
+            {
+                Detail::TraceEnter(_func);
+            }
         }
         ~ScopedProfiling()
         {
-            if (!_enabled)
-                return;
-            Detail::FunctionExit(_func);
+            if (_tracing)
+            {
+                Detail::TraceExit(_func);
+            }
+            if (_enabled)
+            {
+                Detail::FunctionExit(_func);
+            }
         }
     };
 
@@ -188,6 +214,9 @@ namespace OpenRCT2::Profiling
     // Returns all functions.
     const std::vector<Function*>& GetData();
 
+    // Returns an entry for code that is not a C++ function, such as a plugin. Created on first use.
+    Function& GetNamedFunction(std::string_view name);
+
     bool ExportCSV(const std::string& filePath);
 
 } // namespace OpenRCT2::Profiling
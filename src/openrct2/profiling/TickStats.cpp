@@ -0,0 +1,219 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TickStats.h"
+
+#include "../Diagnostic.h"
+#include "../config/Config.h"
+#include "../core/String.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace OpenRCT2::TickStats
+{
+    using Clock = std::chrono::steady_clock;
+
+    static Stats _stats;
+
+    static bool _inTick = false;
+    static Phase _currentPhase = Phase::Other;
+    static Clock::time_point _tickStart;
+    static Clock::time_point _phaseStart;
+    static std::array<Clock::duration, NumPhases> _phaseTimes;
+
+    static uint64_t ToMicroseconds(Clock::duration duration)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    }
+
+    static double ToMilliseconds(uint64_t us)
+    {
+        return us / 1000.0;
+    }
+
+    static void AddSample(Series& series, uint64_t us)
+    {
+        series.TotalTimeUs += us;
+        series.MaxTimeUs = std::max(series.MaxTimeUs, us);
+
+        const auto ms = ToMilliseconds(us);
+        auto bucket = std::lower_bound(BucketLimitsMs.begin(), BucketLimitsMs.end(), ms) - BucketLimitsMs.begin();
+        series.Histogram[bucket]++;
+    }
+
+    void BeginTick()
+    {
+        _inTick = true;
+        _currentPhase = Phase::Other;
+        _phaseTimes.fill(Clock::duration::zero());
+        _tickStart = Clock::now();
+        _phaseStart = _tickStart;
+    }
+
+    void BeginPhase(Phase phase)
+    {
+        if (!_inTick)
+            return;
+
+        const auto now = Clock::now();
+        _phaseTimes[static_cast<size_t>(_currentPhase)] += now - _phaseStart;
+        _currentPhase = phase;
+        _phaseStart = now;
+    }
+
+    void AbortTick()
+    {
+        _inTick = false;
+    }
+
+    void EndTick(uint32_t tick)
+    {
+        if (!_inTick)
+            return;
+
+        BeginPhase(Phase::Other);
+        _inTick = false;
+
+        const auto totalUs = ToMicroseconds(_phaseStart - _tickStart);
+        _stats.Ticks++;
+        AddSample(_stats.Total, totalUs);
+        for (size_t i = 0; i < NumPhases; i++)
+        {
+            AddSample(_stats.Phases[i], ToMicroseconds(_phaseTimes[i]));
+        }
+
+        const auto thresholdMs = gConfigGeneral.TickStallThreshold;
+        if (thresholdMs <= 0.0f || ToMilliseconds(totalUs) < thresholdMs)
+            return;
+
+        _stats.Stalls++;
+        std::string breakdown;
+        for (size_t i = 0; i < NumPhases; i++)
+        {
+            breakdown += String::StdFormat(
+                "%s%s %.2f", i == 0 ? "" : ", ", GetPhaseName(static_cast<Phase>(i)),
+                ToMilliseconds(ToMicroseconds(_phaseTimes[i])));
+        }
+        LOG_WARNING("Tick %u took %.2f ms: %s", tick, ToMilliseconds(totalUs), breakdown.c_str());
+    }
+
+    const Stats& GetStats()
+    {
+        return _stats;
+    }
+
+    void Reset()
+    {
+        _stats = {};
+    }
+
+    const char* GetPhaseName(Phase phase)
+    {
+        switch (phase)
+        {
+            case Phase::Network:
+                return "network";
+            case Phase::World:
+                return "world";
+            case Phase::Peeps:
+                return "peeps";
+            case Phase::Vehicles:
+                return "vehicles";
+            case Phase::Rides:
+                return "rides";
+            case Phase::Ratings:
+                return "ratings";
+            case Phase::Actions:
+                return "actions";
+            case Phase::Hooks:
+                return "hooks";
+            default:
+                return "other";
+        }
+    }
+
+    static double GetMeanMs(const Series& series)
+    {
+        return _stats.Ticks == 0 ? 0.0 : ToMilliseconds(series.TotalTimeUs) / _stats.Ticks;
+    }
+
+    static std::string GetBucketName(size_t bucket)
+    {
+        if (bucket < BucketLimitsMs.size())
+            return String::StdFormat("<= %g ms", BucketLimitsMs[bucket]);
+        return String::StdFormat("> %g ms", BucketLimitsMs.back());
+    }
+
+    std::string GetReport()
+    {
+        std::string report = String::StdFormat(
+            "Ticks: %llu, stalls: %llu, mean: %.3f ms, max: %.3f ms\n", static_cast<unsigned long long>(_stats.Ticks),
+            static_cast<unsigned long long>(_stats.Stalls), GetMeanMs(_stats.Total), ToMilliseconds(_stats.Total.MaxTimeUs));
+
+        report += String::StdFormat("%-10s %10s %10s\n", "phase", "mean ms", "max ms");
+        for (size_t i = 0; i < NumPhases; i++)
+        {
+            const auto& series = _stats.Phases[i];
+            report += String::StdFormat(
+                "%-10s %10.3f %10.3f\n", GetPhaseName(static_cast<Phase>(i)), GetMeanMs(series),
+                ToMilliseconds(series.MaxTimeUs));
+        }
+
+        for (size_t i = 0; i < NumBuckets; i++)
+        {
+            if (_stats.Total.Histogram[i] == 0)
+                continue;
+
+            const auto count = _stats.Total.Histogram[i];
+            report += String::StdFormat(
+                "%-10s %10llu %9.2f%%\n", GetBucketName(i).c_str(), static_cast<unsigned long long>(count),
+                count * 100.0 / _stats.Ticks);
+        }
+        report.pop_back();
+        return report;
+    }
+
+    static void WriteSeries(std::ofstream& out, const Series& series)
+    {
+        out << "{\"meanMs\":" << GetMeanMs(series) << ",\"maxMs\":" << ToMilliseconds(series.MaxTimeUs) << ",\"histogram\":[";
+        for (size_t i = 0; i < NumBuckets; i++)
+        {
+            out << (i == 0 ? "" : ",") << series.Histogram[i];
+        }
+        out << "]}";
+    }
+
+    bool ExportStats(const std::string& path)
+    {
+        std::ofstream out(path);
+        if (!out.is_open())
+            return false;
+
+        out << std::fixed << std::setprecision(3);
+        out << "{\"ticks\":" << _stats.Ticks << ",\"stalls\":" << _stats.Stalls
+            << ",\"stallThresholdMs\":" << gConfigGeneral.TickStallThreshold << ",\"bucketLimitsMs\":[";
+        for (size_t i = 0; i < BucketLimitsMs.size(); i++)
+        {
+            out << (i == 0 ? "" : ",") << BucketLimitsMs[i];
+        }
+        out << "],\n\"total\":";
+        WriteSeries(out, _stats.Total);
+        out << ",\n\"phases\":{";
+        for (size_t i = 0; i < NumPhases; i++)
+        {
+            out << (i == 0 ? "\n" : ",\n") << "\"" << GetPhaseName(static_cast<Phase>(i)) << "\":";
+            WriteSeries(out, _stats.Phases[i]);
+        }
+        out << "}}\n";
+        return !out.fail();
+    }
+} // namespace OpenRCT2::TickStats
@@ -0,0 +1,71 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Always-on tick timing. Unlike the profiler this only takes a timestamp at each phase boundary of
+ * GameState::UpdateLogic, so it stays enabled on servers. Tick durations go into a histogram and
+ * ticks that exceed the stall threshold are logged with their per-phase breakdown.
+ */
+namespace OpenRCT2::TickStats
+{
+    enum class Phase : uint8_t
+    {
+        Network,
+        World,
+        Peeps,
+        Vehicles,
+        Rides,
+        Ratings,
+        Actions,
+        Hooks,
+        Other,
+        Count,
+    };
+    static constexpr size_t NumPhases = static_cast<size_t>(Phase::Count);
+
+    // Upper bounds of the histogram buckets in milliseconds, the last bucket has no upper bound.
+    static constexpr std::array<double, 12> BucketLimitsMs = { 0.5, 1, 2, 4, 8, 16, 25, 33, 50, 100, 250, 1000 };
+    static constexpr size_t NumBuckets = BucketLimitsMs.size() + 1;
+
+    struct Series
+    {
+        uint64_t TotalTimeUs{};
+        uint64_t MaxTimeUs{};
+        std::array<uint64_t, NumBuckets> Histogram{};
+    };
+
+    struct Stats
+    {
+        uint64_t Ticks{};
+        uint64_t Stalls{};
+        Series Total;
+        std::array<Series, NumPhases> Phases;
+    };
+
+    void BeginTick();
+    // Attributes the time since the previous phase boundary to the current phase and starts the given one.
+    void BeginPhase(Phase phase);
+    // Discards the current tick, used when UpdateLogic returns without simulating anything.
+    void AbortTick();
+    void EndTick(uint32_t tick);
+
+    const Stats& GetStats();
+    void Reset();
+
+    const char* GetPhaseName(Phase phase);
+    std::string GetReport();
+    bool ExportStats(const std::string& path);
+} // namespace OpenRCT2::TickStats
@@ -2202,7 +2202,7 @@ namespace RCT1
 
             // Flags
             gParkFlags = _s4.ParkFlags;
-            gParkFlags &= ~PARK_FLAGS_ANTI_CHEAT_DEPRECATED;
+            gParkFlags &= ~(PARK_FLAGS_ANTI_CHEAT_DEPRECATED | PARK_FLAGS_FAST_MAP_SWEEPS);
             gParkFlags |= PARK_FLAGS_RCT1_INTEREST;
             // Loopy Landscape parks can set a flag to lock the entry price to free.
             // If this flag is not set, the player can ask money for both rides and entry.
@@ -261,7 +261,7 @@ namespace RCT2
             gInitialCash = ToMoney64(_s6.InitialCash);
             gBankLoan = ToMoney64(_s6.CurrentLoan);
 
-            gParkFlags = _s6.ParkFlags & ~PARK_FLAGS_NO_MONEY_SCENARIO;
+            gParkFlags = _s6.ParkFlags & ~(PARK_FLAGS_NO_MONEY_SCENARIO | PARK_FLAGS_FAST_MAP_SWEEPS);
 
             // RCT2 used a different flag for `no money` when the park is a scenario
             if (_s6.Header.Type == S6_TYPE_SCENARIO)
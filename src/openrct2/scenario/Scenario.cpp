@@ -265,6 +265,8 @@ static void ScenarioCheckEntranceFeeTooHigh()
 
 void ScenarioAutosaveCheck()
 {
+    GameCheckAutosaveWrite(false);
+
     if (gLastAutoSaveUpdate == AUTOSAVE_PAUSE)
         return;
 
@@ -21,6 +21,8 @@
 #include "../world/Map.h"
 #include "../world/MapAnimation.h"
 
+#include <future>
+
 struct ResultWithMessage;
 
 using random_engine_t = Random::RCT2::Engine;
@@ -185,6 +187,7 @@ uint32_t ScenarioRandMax(uint32_t max);
 
 ResultWithMessage ScenarioPrepareForSave();
 int32_t ScenarioSave(u8string_view path, int32_t flags);
+std::future<bool> ScenarioSaveInBackground(u8string_view path, int32_t flags);
 void ScenarioFailure();
 void ScenarioSuccess();
 void ScenarioSuccessSubmitName(const char* name);
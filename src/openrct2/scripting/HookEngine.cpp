@@ -14,6 +14,8 @@
 #    include "../core/EnumMap.hpp"
 #    include "ScriptEngine.h"
 
+#    include <algorithm>
+#    include <chrono>
 #    include <unordered_map>
 
 using namespace OpenRCT2::Scripting;
@@ -42,6 +44,11 @@ HOOK_TYPE OpenRCT2::Scripting::GetHookType(const std::string& name)
     return (result != HooksLookupTable.end()) ? result->second : HOOK_TYPE::UNDEFINED;
 }
 
+std::string_view OpenRCT2::Scripting::GetHookName(HOOK_TYPE type)
+{
+    return HooksLookupTable[type];
+}
+
 HookEngine::HookEngine(ScriptEngine& scriptEngine)
     : _scriptEngine(scriptEngine)
 {
@@ -110,27 +117,24 @@ bool HookEngine::IsValidHookForPlugin(HOOK_TYPE type, Plugin& plugin) const
 
 void HookEngine::Call(HOOK_TYPE type, bool isGameStateMutable)
 {
-    auto& hookList = GetHookList(type);
-    for (auto& hook : hookList.Hooks)
+    for (auto cookie : GetCookies(type))
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, {}, isGameStateMutable);
+        CallHook(type, cookie, {}, isGameStateMutable);
     }
 }
 
 void HookEngine::Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable)
 {
-    auto& hookList = GetHookList(type);
-    for (auto& hook : hookList.Hooks)
+    for (auto cookie : GetCookies(type))
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, { arg }, isGameStateMutable);
+        CallHook(type, cookie, { arg }, isGameStateMutable);
     }
 }
 
 void HookEngine::Call(
     HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable)
 {
-    auto& hookList = GetHookList(type);
-    for (auto& hook : hookList.Hooks)
+    for (auto cookie : GetCookies(type))
     {
         auto ctx = _scriptEngine.GetContext();
 
@@ -157,7 +161,90 @@ void HookEngine::Call(
 
         std::vector<DukValue> dukArgs;
         dukArgs.push_back(DukValue::take_from_stack(ctx));
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, dukArgs, isGameStateMutable);
+        CallHook(type, cookie, dukArgs, isGameStateMutable);
+    }
+}
+
+void HookEngine::CallHook(HOOK_TYPE type, uint32_t cookie, const std::vector<DukValue>& args, bool isGameStateMutable)
+{
+    // The hook list may change while the plugin runs, so only copies of the hook are used during the call.
+    auto* hook = FindHook(type, cookie);
+    if (hook == nullptr)
+    {
+        return;
+    }
+    auto owner = hook->Owner;
+    auto function = hook->Function;
+
+    // Only plugins that run on a single peer are skipped, the network mode is checked again as it may have changed since
+    // the plugin was throttled.
+    auto& timings = owner->GetTimings();
+    if (type == HOOK_TYPE::INTERVAL_TICK && timings.ThrottledTicks > 0 && _scriptEngine.CanThrottlePlugin(*owner))
+    {
+        return;
+    }
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    _scriptEngine.ExecutePluginCall(owner, function, args, isGameStateMutable);
+    const auto elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - startTime)
+                               .count();
+    timings.TickTimeUs += elapsedUs;
+
+    // The hook may have unsubscribed itself.
+    hook = FindHook(type, cookie);
+    if (hook != nullptr)
+    {
+        hook->CallCount++;
+        hook->TotalTimeUs += elapsedUs;
+        hook->MaxTimeUs = std::max(hook->MaxTimeUs, elapsedUs);
+    }
+}
+
+std::vector<uint32_t> HookEngine::GetCookies(HOOK_TYPE type) const
+{
+    const auto& hooks = GetHookList(type).Hooks;
+    std::vector<uint32_t> cookies;
+    cookies.reserve(hooks.size());
+    for (const auto& hook : hooks)
+    {
+        cookies.push_back(hook.Cookie);
+    }
+    return cookies;
+}
+
+Hook* HookEngine::FindHook(HOOK_TYPE type, uint32_t cookie)
+{
+    auto& hooks = GetHookList(type).Hooks;
+    auto it = std::find_if(hooks.begin(), hooks.end(), [cookie](const Hook& hook) { return hook.Cookie == cookie; });
+    return it != hooks.end() ? &*it : nullptr;
+}
+
+std::vector<std::pair<HOOK_TYPE, const Hook*>> HookEngine::GetHooks(const Plugin& owner) const
+{
+    std::vector<std::pair<HOOK_TYPE, const Hook*>> result;
+    for (const auto& hookList : _hookMap)
+    {
+        for (const auto& hook : hookList.Hooks)
+        {
+            if (hook.Owner.get() == &owner)
+            {
+                result.emplace_back(hookList.Type, &hook);
+            }
+        }
+    }
+    return result;
+}
+
+void HookEngine::ResetTimings()
+{
+    for (auto& hookList : _hookMap)
+    {
+        for (auto& hook : hookList.Hooks)
+        {
+            hook.CallCount = 0;
+            hook.TotalTimeUs = 0;
+            hook.MaxTimeUs = 0;
+        }
     }
 }
 
@@ -17,6 +17,7 @@
 #    include <any>
 #    include <memory>
 #    include <string>
+#    include <string_view>
 #    include <tuple>
 #    include <vector>
 
@@ -48,6 +49,7 @@ namespace OpenRCT2::Scripting
     };
     constexpr size_t NUM_HOOK_TYPES = static_cast<size_t>(HOOK_TYPE::COUNT);
     HOOK_TYPE GetHookType(const std::string& name);
+    std::string_view GetHookName(HOOK_TYPE type);
 
     struct Hook
     {
@@ -55,6 +57,11 @@ namespace OpenRCT2::Scripting
         std::shared_ptr<Plugin> Owner;
         DukValue Function;
 
+        // Time spent in this hook, in microseconds.
+        uint64_t CallCount{};
+        double TotalTimeUs{};
+        double MaxTimeUs{};
+
         Hook() = default;
         Hook(uint32_t cookie, std::shared_ptr<Plugin> owner, const DukValue& function)
             : Cookie(cookie)
@@ -94,8 +101,13 @@ namespace OpenRCT2::Scripting
         void Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable);
         void Call(
             HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable);
+        std::vector<std::pair<HOOK_TYPE, const Hook*>> GetHooks(const Plugin& owner) const;
+        void ResetTimings();
 
     private:
+        void CallHook(HOOK_TYPE type, uint32_t cookie, const std::vector<DukValue>& args, bool isGameStateMutable);
+        std::vector<uint32_t> GetCookies(HOOK_TYPE type) const;
+        Hook* FindHook(HOOK_TYPE type, uint32_t cookie);
         HookList& GetHookList(HOOK_TYPE type);
         const HookList& GetHookList(HOOK_TYPE type) const;
     };
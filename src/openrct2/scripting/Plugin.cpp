@@ -74,6 +74,9 @@ void Plugin::Load()
 
     _metadata = GetMetadata(DukValue::take_from_stack(_context));
     _hasLoaded = true;
+
+    if (_heapUsage != nullptr)
+        _heapUsage->Name = _metadata.Name;
 }
 
 void Plugin::Start()
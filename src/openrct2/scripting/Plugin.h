@@ -18,6 +18,11 @@
 #    include <string_view>
 #    include <vector>
 
+namespace OpenRCT2::Profiling
+{
+    struct Function;
+}
+
 namespace OpenRCT2::Scripting
 {
     enum class PluginType
@@ -52,6 +57,31 @@ namespace OpenRCT2::Scripting
         DukValue Main;
     };
 
+    struct PluginTimings
+    {
+        // All calls into the plugin, times in microseconds.
+        uint64_t CallCount{};
+        double TotalTimeUs{};
+        double MaxTimeUs{};
+
+        // Time spent in hooks during the current game tick.
+        double TickTimeUs{};
+        uint32_t TicksOverBudget{};
+
+        // Number of game ticks for which the interval.tick hooks of the plugin are still skipped.
+        uint32_t ThrottledTicks{};
+
+        Profiling::Function* ProfilingFunction{};
+    };
+
+    // Duktape heap memory allocated while running the code of a plugin, or of the engine itself.
+    struct PluginHeapUsage
+    {
+        std::string Name;
+        int64_t CurrentBytes{};
+        int64_t PeakBytes{};
+    };
+
     class Plugin
     {
     private:
@@ -62,6 +92,8 @@ namespace OpenRCT2::Scripting
         bool _hasLoaded{};
         bool _hasStarted{};
         bool _isStopping{};
+        PluginTimings _timings{};
+        PluginHeapUsage* _heapUsage{};
 
     public:
         std::string_view GetPath() const
@@ -99,6 +131,26 @@ namespace OpenRCT2::Scripting
             return _hasLoaded;
         }
 
+        PluginTimings& GetTimings()
+        {
+            return _timings;
+        }
+
+        const PluginTimings& GetTimings() const
+        {
+            return _timings;
+        }
+
+        PluginHeapUsage* GetHeapUsage() const
+        {
+            return _heapUsage;
+        }
+
+        void SetHeapUsage(PluginHeapUsage* heapUsage)
+        {
+            _heapUsage = heapUsage;
+        }
+
         int32_t GetTargetAPIVersion() const;
 
         Plugin() = default;
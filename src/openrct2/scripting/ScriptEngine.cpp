@@ -22,7 +22,9 @@
 #    include "../core/FileScanner.h"
 #    include "../core/Path.hpp"
 #    include "../interface/InteractiveConsole.h"
+#    include "../network/network.h"
 #    include "../platform/Platform.h"
+#    include "../profiling/MemoryStats.h"
 #    include "Duktape.hpp"
 #    include "bindings/entity/ScEntity.hpp"
 #    include "bindings/entity/ScGuest.hpp"
@@ -54,14 +56,20 @@
 #    include "bindings/world/ScTile.hpp"
 #    include "bindings/world/ScTileElement.hpp"
 
+#    include <chrono>
+#    include <cstdlib>
 #    include <iostream>
 #    include <memory>
 #    include <stdexcept>
 #    include <string>
+#    include <utility>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
 
+// Upper limit on the number of consecutive ticks a plugin over its budget is skipped for.
+static constexpr uint32_t MaxThrottledTicks = 40;
+
 struct ExpressionStringifier final
 {
 private:
@@ -368,23 +376,128 @@ public:
     }
 };
 
-DukContext::DukContext()
+namespace OpenRCT2::Scripting
+{
+    struct DukHeapAccounting
+    {
+        const ScriptExecutionInfo* ExecInfo{};
+        // Entries are never removed as allocation headers point to them, the first entry is the engine.
+        std::list<std::pair<std::string, PluginHeapUsage>> Usages;
+    };
+} // namespace OpenRCT2::Scripting
+
+struct alignas(std::max_align_t) DukAllocationHeader
+{
+    size_t Size;
+    PluginHeapUsage* Owner;
+};
+
+static void DukAccountAllocation(PluginHeapUsage& usage, int64_t bytes)
+{
+    usage.CurrentBytes += bytes;
+    usage.PeakBytes = std::max(usage.PeakBytes, usage.CurrentBytes);
+    MemoryStats::Add(MemoryStats::Subsystem::Scripting, bytes);
+}
+
+static void* DukAlloc(void* udata, duk_size_t size)
+{
+    auto* header = static_cast<DukAllocationHeader*>(std::malloc(sizeof(DukAllocationHeader) + size));
+    if (header == nullptr)
+        return nullptr;
+
+    auto* accounting = static_cast<DukHeapAccounting*>(udata);
+    auto* owner = accounting->ExecInfo != nullptr ? accounting->ExecInfo->GetHeapUsage() : nullptr;
+    header->Size = size;
+    header->Owner = owner != nullptr ? owner : &accounting->Usages.front().second;
+    DukAccountAllocation(*header->Owner, static_cast<int64_t>(size));
+    return header + 1;
+}
+
+static void DukFree([[maybe_unused]] void* udata, void* ptr)
+{
+    if (ptr == nullptr)
+        return;
+
+    auto* header = static_cast<DukAllocationHeader*>(ptr) - 1;
+    DukAccountAllocation(*header->Owner, -static_cast<int64_t>(header->Size));
+    std::free(header);
+}
+
+static void* DukRealloc(void* udata, void* ptr, duk_size_t size)
 {
-    _context = duk_create_heap_default();
+    if (ptr == nullptr)
+        return DukAlloc(udata, size);
+    if (size == 0)
+    {
+        DukFree(udata, ptr);
+        return nullptr;
+    }
+
+    // The memory stays accounted to the plugin that allocated it first.
+    auto* header = static_cast<DukAllocationHeader*>(ptr) - 1;
+    const auto oldSize = header->Size;
+    auto* newHeader = static_cast<DukAllocationHeader*>(std::realloc(header, sizeof(DukAllocationHeader) + size));
+    if (newHeader == nullptr)
+        return nullptr;
+
+    newHeader->Size = size;
+    DukAccountAllocation(*newHeader->Owner, static_cast<int64_t>(size) - static_cast<int64_t>(oldSize));
+    return newHeader + 1;
+}
+
+DukContext::DukContext(const ScriptExecutionInfo& execInfo)
+    : _accounting(std::make_unique<DukHeapAccounting>())
+{
+    _accounting->ExecInfo = &execInfo;
+    _accounting->Usages.emplace_back(std::string(), PluginHeapUsage{ "engine" });
+
+    _context = duk_create_heap(DukAlloc, DukRealloc, DukFree, _accounting.get(), nullptr);
     if (_context == nullptr)
     {
         throw std::runtime_error("Unable to initialise duktape context.");
     }
 }
 
+DukContext::DukContext(DukContext&& src) noexcept
+    : _context(std::move(src._context))
+    , _accounting(std::move(src._accounting))
+{
+    src._context = {};
+}
+
 DukContext::~DukContext()
 {
-    duk_destroy_heap(_context);
+    if (_context != nullptr)
+    {
+        duk_destroy_heap(_context);
+    }
+}
+
+PluginHeapUsage& DukContext::GetHeapUsage(std::string_view key)
+{
+    for (auto& [usageKey, usage] : _accounting->Usages)
+    {
+        if (usageKey == key)
+            return usage;
+    }
+    auto& [usageKey, usage] = _accounting->Usages.emplace_back(std::string(key), PluginHeapUsage{ std::string(key) });
+    return usage;
+}
+
+std::vector<PluginHeapUsage*> DukContext::GetHeapUsages()
+{
+    std::vector<PluginHeapUsage*> result;
+    for (auto& [usageKey, usage] : _accounting->Usages)
+    {
+        result.push_back(&usage);
+    }
+    return result;
 }
 
 ScriptEngine::ScriptEngine(InteractiveConsole& console, IPlatformEnvironment& env)
     : _console(console)
     , _env(env)
+    , _context(_execInfo)
     , _hookEngine(*this)
 {
 }
@@ -628,6 +741,7 @@ void ScriptEngine::RegisterPlugin(std::string_view path)
     try
     {
         auto plugin = std::make_shared<Plugin>(_context, path);
+        plugin->SetHeapUsage(&_context.GetHeapUsage(path));
 
         // We must load the plugin to get the metadata for it
         ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, false);
@@ -692,6 +806,7 @@ void ScriptEngine::LoadTransientPlugins()
 void ScriptEngine::LoadPlugin(const std::string& path)
 {
     auto plugin = std::make_shared<Plugin>(_context, path);
+    plugin->SetHeapUsage(&_context.GetHeapUsage(path));
     LoadPlugin(plugin);
 }
 
@@ -988,7 +1103,25 @@ DukValue ScriptEngine::ExecutePluginCall(
         {
             arg.push();
         }
-        auto result = duk_pcall_method(_context, static_cast<duk_idx_t>(args.size()));
+
+        auto& timings = plugin->GetTimings();
+        if (timings.ProfilingFunction == nullptr)
+        {
+            timings.ProfilingFunction = &Profiling::GetNamedFunction("plugin: " + plugin->GetMetadata().Name);
+        }
+
+        int32_t result;
+        {
+            Profiling::ScopedProfiling<Profiling::Function> profilingScope(*timings.ProfilingFunction);
+            const auto startTime = std::chrono::high_resolution_clock::now();
+            result = duk_pcall_method(_context, static_cast<duk_idx_t>(args.size()));
+            const auto elapsedUs = std::chrono::duration<double, std::micro>(
+                                       std::chrono::high_resolution_clock::now() - startTime)
+                                       .count();
+            timings.CallCount++;
+            timings.TotalTimeUs += elapsedUs;
+            timings.MaxTimeUs = std::max(timings.MaxTimeUs, elapsedUs);
+        }
         if (result == DUK_EXEC_SUCCESS)
         {
             return DukValue::take_from_stack(_context);
@@ -1001,6 +1134,47 @@ DukValue ScriptEngine::ExecutePluginCall(
     return DukValue();
 }
 
+bool ScriptEngine::CanThrottlePlugin(const Plugin& plugin) const
+{
+    // Remote plugins run on every client, skipping their hooks on one side would cause a desync. Other plugins only run on
+    // one peer and can only change the game state of a network game through game actions, which are synchronised.
+    return plugin.GetMetadata().Type != PluginType::Remote || NetworkGetMode() == NETWORK_MODE_NONE;
+}
+
+void ScriptEngine::UpdatePluginBudgets()
+{
+    const auto budgetUs = static_cast<double>(gConfigPlugin.TickBudget) * 1000.0;
+    for (const auto& plugin : _plugins)
+    {
+        auto& timings = plugin->GetTimings();
+        const auto tickTimeUs = std::exchange(timings.TickTimeUs, 0.0);
+        if (timings.ThrottledTicks > 0)
+        {
+            timings.ThrottledTicks--;
+            continue;
+        }
+        if (budgetUs <= 0 || tickTimeUs <= budgetUs)
+        {
+            continue;
+        }
+
+        timings.TicksOverBudget++;
+        if (gConfigPlugin.ThrottleOverBudget && CanThrottlePlugin(*plugin))
+        {
+            // Skip enough ticks to bring the average time per tick back within the budget.
+            timings.ThrottledTicks = std::min(static_cast<uint32_t>(tickTimeUs / budgetUs), MaxThrottledTicks);
+        }
+
+        // Only warn on the first overrun and every so often after that to avoid flooding the log.
+        if (timings.TicksOverBudget % 1000 == 1)
+        {
+            LOG_WARNING(
+                "Plugin '%s' took %.2f ms in a tick, the budget is %.2f ms (%u ticks over budget)",
+                plugin->GetMetadata().Name.c_str(), tickTimeUs / 1000.0, budgetUs / 1000.0, timings.TicksOverBudget);
+        }
+    }
+}
+
 void ScriptEngine::LogPluginInfo(std::string_view message)
 {
     auto plugin = _execInfo.GetCurrentPlugin();
@@ -1022,7 +1196,11 @@ void ScriptEngine::LogPluginInfo(const std::shared_ptr<Plugin>& plugin, std::str
 
 void ScriptEngine::AddNetworkPlugin(std::string_view code)
 {
+    // Network plugins have no path, they are accounted by their position so reconnecting reuses the entries.
+    auto numNetworkPlugins = std::count_if(
+        _plugins.begin(), _plugins.end(), [](const std::shared_ptr<Plugin>& p) { return !p->HasPath(); });
     auto plugin = std::make_shared<Plugin>(_context, std::string());
+    plugin->SetHeapUsage(&_context.GetHeapUsage("network/" + std::to_string(numNetworkPlugins)));
     plugin->SetCode(code);
     _plugins.push_back(plugin);
 }
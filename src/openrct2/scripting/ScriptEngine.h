@@ -47,7 +47,7 @@ namespace OpenRCT2
 
 namespace OpenRCT2::Scripting
 {
-    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 78;
+    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 81;
 
     // Versions marking breaking changes.
     static constexpr int32_t API_VERSION_33_PEEP_DEPRECATION = 33;
@@ -63,6 +63,7 @@ namespace OpenRCT2::Scripting
     {
     private:
         std::shared_ptr<Plugin> _plugin;
+        PluginHeapUsage* _heapUsage{};
         bool _isGameStateMutable{};
 
     public:
@@ -73,6 +74,7 @@ namespace OpenRCT2::Scripting
             std::shared_ptr<Plugin> _plugin;
 
             std::shared_ptr<Plugin> _backupPlugin;
+            PluginHeapUsage* _backupHeapUsage;
             bool _backupIsGameStateMutable;
 
         public:
@@ -81,8 +83,10 @@ namespace OpenRCT2::Scripting
                 , _plugin(plugin)
             {
                 _backupPlugin = _execInfo._plugin;
+                _backupHeapUsage = _execInfo._heapUsage;
                 _backupIsGameStateMutable = _execInfo._isGameStateMutable;
 
+                _execInfo._heapUsage = plugin != nullptr ? plugin->GetHeapUsage() : nullptr;
                 _execInfo._plugin = std::move(plugin);
                 _execInfo._isGameStateMutable = isGameStateMutable;
             }
@@ -90,6 +94,7 @@ namespace OpenRCT2::Scripting
             ~PluginScope()
             {
                 _execInfo._plugin = _backupPlugin;
+                _execInfo._heapUsage = _backupHeapUsage;
                 _execInfo._isGameStateMutable = _backupIsGameStateMutable;
             }
         };
@@ -103,27 +108,36 @@ namespace OpenRCT2::Scripting
         {
             return _isGameStateMutable;
         }
+
+        // Where Duktape allocations made by the current plugin are accounted, or nullptr for the engine.
+        PluginHeapUsage* GetHeapUsage() const
+        {
+            return _heapUsage;
+        }
     };
 
+    struct DukHeapAccounting;
+
     class DukContext
     {
     private:
         duk_context* _context{};
+        std::unique_ptr<DukHeapAccounting> _accounting;
 
     public:
-        DukContext();
+        explicit DukContext(const ScriptExecutionInfo& execInfo);
         DukContext(DukContext&) = delete;
-        DukContext(DukContext&& src) noexcept
-            : _context(std::move(src._context))
-        {
-            src._context = {};
-        }
+        DukContext(DukContext&& src) noexcept;
         ~DukContext();
 
         operator duk_context*()
         {
             return _context;
         }
+
+        // Returns the heap usage entry with the given key, the first entry is the engine.
+        PluginHeapUsage& GetHeapUsage(std::string_view key);
+        std::vector<PluginHeapUsage*> GetHeapUsages();
     };
 
     using IntervalHandle = int32_t;
@@ -147,6 +161,7 @@ namespace OpenRCT2::Scripting
     private:
         InteractiveConsole& _console;
         IPlatformEnvironment& _env;
+        ScriptExecutionInfo _execInfo;
         DukContext _context;
         bool _initialised{};
         bool _hotReloadingInitialised{};
@@ -157,7 +172,6 @@ namespace OpenRCT2::Scripting
         std::vector<std::shared_ptr<Plugin>> _plugins;
         uint32_t _lastHotReloadCheckTick{};
         HookEngine _hookEngine;
-        ScriptExecutionInfo _execInfo;
         DukValue _sharedStorage;
         DukValue _parkStorage;
 
@@ -198,6 +212,10 @@ namespace OpenRCT2::Scripting
         {
             return _execInfo;
         }
+        std::vector<PluginHeapUsage*> GetHeapUsages()
+        {
+            return _context.GetHeapUsages();
+        }
         DukValue GetSharedStorage()
         {
             return _sharedStorage;
@@ -234,6 +252,10 @@ namespace OpenRCT2::Scripting
         void UnloadTransientPlugins();
         void StopUnloadRegisterAllPlugins();
         void Tick();
+        // Checks the time plugins spent in hooks during the last game tick against the configured budget.
+        void UpdatePluginBudgets();
+        // Whether interval.tick hooks of the plugin may be skipped without the peers of a network game going out of sync.
+        bool CanThrottlePlugin(const Plugin& plugin) const;
         std::future<void> Eval(const std::string& s);
         DukValue ExecutePluginCall(
             const std::shared_ptr<Plugin>& plugin, const DukValue& func, const std::vector<DukValue>& args,
@@ -11,8 +11,10 @@
 
 #ifdef ENABLE_SCRIPTING
 
+#    include "../../../Context.h"
 #    include "../../../profiling/Profiling.h"
 #    include "../../Duktape.hpp"
+#    include "../../ScriptEngine.h"
 
 namespace OpenRCT2::Scripting
 {
@@ -50,6 +52,46 @@ namespace OpenRCT2::Scripting
             return DukValue::take_from_stack(_ctx);
         }
 
+        DukValue getPluginData()
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto& hookEngine = scriptEngine.GetHookEngine();
+
+            duk_push_array(_ctx);
+            duk_uarridx_t index = 0;
+            for (const auto& plugin : scriptEngine.GetPlugins())
+            {
+                const auto& timings = plugin->GetTimings();
+                DukObject obj(_ctx);
+                obj.Set("name", plugin->GetMetadata().Name);
+                obj.Set("callCount", timings.CallCount);
+                obj.Set("maxTime", timings.MaxTimeUs);
+                obj.Set("totalTime", timings.TotalTimeUs);
+                obj.Set("ticksOverBudget", timings.TicksOverBudget);
+                obj.Set("isThrottled", timings.ThrottledTicks > 0);
+
+                duk_push_array(_ctx);
+                duk_uarridx_t hookIndex = 0;
+                for (const auto& [type, hook] : hookEngine.GetHooks(*plugin))
+                {
+                    DukObject hookObj(_ctx);
+                    hookObj.Set("hook", GetHookName(type));
+                    hookObj.Set("callCount", hook->CallCount);
+                    hookObj.Set("maxTime", hook->MaxTimeUs);
+                    hookObj.Set("totalTime", hook->TotalTimeUs);
+                    hookObj.Take().push();
+                    duk_put_prop_index(_ctx, /* duk stack index */ -2, hookIndex);
+                    hookIndex++;
+                }
+                obj.Set("hooks", DukValue::take_from_stack(_ctx));
+
+                obj.Take().push();
+                duk_put_prop_index(_ctx, /* duk stack index */ -2, index);
+                index++;
+            }
+            return DukValue::take_from_stack(_ctx);
+        }
+
         DukValue GetFunctionIndexArray(
             const std::vector<OpenRCT2::Profiling::Function*>& all, const std::vector<OpenRCT2::Profiling::Function*>& items)
         {
@@ -82,6 +124,17 @@ namespace OpenRCT2::Scripting
         void reset()
         {
             OpenRCT2::Profiling::ResetData();
+
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            for (const auto& plugin : scriptEngine.GetPlugins())
+            {
+                auto& timings = plugin->GetTimings();
+                timings.CallCount = 0;
+                timings.TotalTimeUs = 0;
+                timings.MaxTimeUs = 0;
+                timings.TicksOverBudget = 0;
+            }
+            scriptEngine.GetHookEngine().ResetTimings();
         }
 
         bool enabled_get() const
@@ -93,6 +146,7 @@ namespace OpenRCT2::Scripting
         static void Register(duk_context* ctx)
         {
             dukglue_register_method(ctx, &ScProfiler::getData, "getData");
+            dukglue_register_method(ctx, &ScProfiler::getPluginData, "getPluginData");
             dukglue_register_method(ctx, &ScProfiler::start, "start");
             dukglue_register_method(ctx, &ScProfiler::stop, "stop");
             dukglue_register_method(ctx, &ScProfiler::reset, "reset");
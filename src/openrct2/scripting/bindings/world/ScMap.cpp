@@ -34,6 +34,9 @@
 #    include "../ride/ScTrackIterator.h"
 #    include "../world/ScTile.hpp"
 
+#    include <limits>
+#    include <optional>
+
 namespace OpenRCT2::Scripting
 {
     ScMap::ScMap(duk_context* ctx)
@@ -229,6 +232,244 @@ namespace OpenRCT2::Scripting
         return result;
     }
 
+    struct EntityQueryField
+    {
+        std::string_view Name;
+        duk_uint_t ArrayType;
+        int64_t (*GetValue)(const EntityBase& entity);
+    };
+
+#    define ENTITY_QUERY_FIELD(name, entityType, arrayType, expr)                                                             \
+        EntityQueryField                                                                                                       \
+        {                                                                                                                      \
+            name, arrayType, [](const EntityBase& base) -> int64_t {                                                           \
+                [[maybe_unused]] const auto& entity = static_cast<const entityType&>(base);                                    \
+                return static_cast<int64_t>(expr);                                                                             \
+            }                                                                                                                  \
+        }
+
+    // clang-format off
+    static const EntityQueryField EntityQueryFields[] = {
+        ENTITY_QUERY_FIELD("id", EntityBase, DUK_BUFOBJ_UINT16ARRAY, entity.Id.ToUnderlying()),
+        ENTITY_QUERY_FIELD("x", EntityBase, DUK_BUFOBJ_INT32ARRAY, entity.x),
+        ENTITY_QUERY_FIELD("y", EntityBase, DUK_BUFOBJ_INT32ARRAY, entity.y),
+        ENTITY_QUERY_FIELD("z", EntityBase, DUK_BUFOBJ_INT32ARRAY, entity.z),
+    };
+
+    static const EntityQueryField PeepQueryFields[] = {
+        ENTITY_QUERY_FIELD("energy", Peep, DUK_BUFOBJ_UINT8ARRAY, entity.Energy),
+        ENTITY_QUERY_FIELD("energyTarget", Peep, DUK_BUFOBJ_UINT8ARRAY, entity.EnergyTarget),
+    };
+
+    static const EntityQueryField GuestQueryFields[] = {
+        ENTITY_QUERY_FIELD("happiness", Guest, DUK_BUFOBJ_UINT8ARRAY, entity.Happiness),
+        ENTITY_QUERY_FIELD("happinessTarget", Guest, DUK_BUFOBJ_UINT8ARRAY, entity.HappinessTarget),
+        ENTITY_QUERY_FIELD("nausea", Guest, DUK_BUFOBJ_UINT8ARRAY, entity.Nausea),
+        ENTITY_QUERY_FIELD("nauseaTarget", Guest, DUK_BUFOBJ_UINT8ARRAY, entity.NauseaTarget),
+        ENTITY_QUERY_FIELD("hunger", Guest, DUK_BUFOBJ_UINT8ARRAY, entity.Hunger),
+        ENTITY_QUERY_FIELD("thirst", Guest, DUK_BUFOBJ_UINT8ARRAY, entity.Thirst),
+        ENTITY_QUERY_FIELD("toilet", Guest, DUK_BUFOBJ_UINT8ARRAY, entity.Toilet),
+        ENTITY_QUERY_FIELD("mass", Guest, DUK_BUFOBJ_UINT8ARRAY, entity.Mass),
+        ENTITY_QUERY_FIELD("cash", Guest, DUK_BUFOBJ_INT32ARRAY, entity.CashInPocket),
+        ENTITY_QUERY_FIELD("isInPark", Guest, DUK_BUFOBJ_UINT8ARRAY, !entity.OutsideOfPark),
+        ENTITY_QUERY_FIELD("isLost", Guest, DUK_BUFOBJ_UINT8ARRAY, entity.GuestIsLostCountdown < 90),
+        ENTITY_QUERY_FIELD("lostCountdown", Guest, DUK_BUFOBJ_UINT8ARRAY, entity.GuestIsLostCountdown),
+    };
+
+    static const EntityQueryField StaffQueryFields[] = {
+        ENTITY_QUERY_FIELD("colour", Staff, DUK_BUFOBJ_UINT8ARRAY, entity.TshirtColour),
+        ENTITY_QUERY_FIELD("orders", Staff, DUK_BUFOBJ_UINT8ARRAY, entity.StaffOrders),
+    };
+
+    static const EntityQueryField CarQueryFields[] = {
+        ENTITY_QUERY_FIELD("ride", Vehicle, DUK_BUFOBJ_UINT16ARRAY, entity.ride.ToUnderlying()),
+        ENTITY_QUERY_FIELD("rideObject", Vehicle, DUK_BUFOBJ_UINT16ARRAY, entity.ride_subtype),
+        ENTITY_QUERY_FIELD("vehicleObject", Vehicle, DUK_BUFOBJ_UINT8ARRAY, entity.vehicle_type),
+        ENTITY_QUERY_FIELD("numSeats", Vehicle, DUK_BUFOBJ_UINT8ARRAY, entity.num_seats & VEHICLE_SEAT_NUM_MASK),
+        ENTITY_QUERY_FIELD("currentStation", Vehicle, DUK_BUFOBJ_UINT8ARRAY, entity.current_station.ToUnderlying()),
+        ENTITY_QUERY_FIELD("mass", Vehicle, DUK_BUFOBJ_UINT16ARRAY, entity.mass),
+        ENTITY_QUERY_FIELD("acceleration", Vehicle, DUK_BUFOBJ_INT32ARRAY, entity.acceleration),
+        ENTITY_QUERY_FIELD("velocity", Vehicle, DUK_BUFOBJ_INT32ARRAY, entity.velocity),
+        ENTITY_QUERY_FIELD("bankRotation", Vehicle, DUK_BUFOBJ_UINT8ARRAY, entity.bank_rotation),
+        ENTITY_QUERY_FIELD("trackProgress", Vehicle, DUK_BUFOBJ_UINT16ARRAY, entity.track_progress),
+        ENTITY_QUERY_FIELD("remainingDistance", Vehicle, DUK_BUFOBJ_INT32ARRAY, entity.remaining_distance),
+    };
+
+    static const EntityQueryField LitterQueryFields[] = {
+        ENTITY_QUERY_FIELD("creationTick", Litter, DUK_BUFOBJ_UINT32ARRAY, entity.creationTick),
+    };
+    // clang-format on
+
+#    undef ENTITY_QUERY_FIELD
+
+    struct EntityQueryFilter
+    {
+        std::optional<MapRange> Range;
+        const EntityQueryField* Field{};
+        int64_t Min = std::numeric_limits<int64_t>::min();
+        int64_t Max = std::numeric_limits<int64_t>::max();
+
+        bool Matches(const EntityBase& entity) const
+        {
+            if (Range.has_value())
+            {
+                if (entity.x < Range->GetLeft() || entity.x > Range->GetRight() || entity.y < Range->GetTop()
+                    || entity.y > Range->GetBottom())
+                {
+                    return false;
+                }
+            }
+            if (Field != nullptr)
+            {
+                auto value = Field->GetValue(entity);
+                if (value < Min || value > Max)
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    template<typename T> static void GatherEntities(std::vector<const EntityBase*>& result, const EntityQueryFilter& filter)
+    {
+        for (const auto* entity : EntityList<T>())
+        {
+            if (filter.Matches(*entity))
+            {
+                result.push_back(entity);
+            }
+        }
+    }
+
+    template<typename T>
+    static void FillColumn(void* data, const std::vector<const EntityBase*>& entities, const EntityQueryField& field)
+    {
+        auto* column = static_cast<T*>(data);
+        for (size_t i = 0; i < entities.size(); i++)
+        {
+            column[i] = static_cast<T>(field.GetValue(*entities[i]));
+        }
+    }
+
+    static size_t GetArrayElementSize(duk_uint_t arrayType)
+    {
+        switch (arrayType)
+        {
+            case DUK_BUFOBJ_UINT16ARRAY:
+                return sizeof(uint16_t);
+            case DUK_BUFOBJ_INT32ARRAY:
+                return sizeof(int32_t);
+            case DUK_BUFOBJ_UINT32ARRAY:
+                return sizeof(uint32_t);
+            default:
+                return sizeof(uint8_t);
+        }
+    }
+
+    DukValue ScMap::queryEntities(const std::string& type, const std::vector<std::string>& fields, const DukValue& filter) const
+    {
+        std::vector<std::pair<const EntityQueryField*, size_t>> fieldTables = { { EntityQueryFields,
+                                                                                  std::size(EntityQueryFields) } };
+        if (type == "guest" || type == "staff")
+        {
+            fieldTables.emplace_back(PeepQueryFields, std::size(PeepQueryFields));
+            if (type == "guest")
+                fieldTables.emplace_back(GuestQueryFields, std::size(GuestQueryFields));
+            else
+                fieldTables.emplace_back(StaffQueryFields, std::size(StaffQueryFields));
+        }
+        else if (type == "car")
+        {
+            fieldTables.emplace_back(CarQueryFields, std::size(CarQueryFields));
+        }
+        else if (type == "litter")
+        {
+            fieldTables.emplace_back(LitterQueryFields, std::size(LitterQueryFields));
+        }
+        else if (type != "balloon" && type != "duck")
+        {
+            duk_error(_context, DUK_ERR_ERROR, "Invalid entity type: %s", type.c_str());
+        }
+
+        auto findField = [&](std::string_view name) -> const EntityQueryField* {
+            for (const auto& [table, count] : fieldTables)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    if (table[i].Name == name)
+                        return &table[i];
+                }
+            }
+            duk_error(_context, DUK_ERR_ERROR, "Invalid field for %s: %s", type.c_str(), std::string(name).c_str());
+            return nullptr;
+        };
+
+        std::vector<const EntityQueryField*> columns;
+        columns.reserve(fields.size());
+        for (const auto& name : fields)
+        {
+            columns.push_back(findField(name));
+        }
+
+        EntityQueryFilter entityFilter;
+        if (filter.type() == DukValue::Type::OBJECT)
+        {
+            if (filter["range"].type() == DukValue::Type::OBJECT)
+            {
+                entityFilter.Range = FromDuk<MapRange>(filter["range"]).Normalise();
+            }
+            if (filter["field"].type() == DukValue::Type::STRING)
+            {
+                entityFilter.Field = findField(filter["field"].as_string());
+                if (filter["min"].type() == DukValue::Type::NUMBER)
+                    entityFilter.Min = static_cast<int64_t>(filter["min"].as_double());
+                if (filter["max"].type() == DukValue::Type::NUMBER)
+                    entityFilter.Max = static_cast<int64_t>(filter["max"].as_double());
+            }
+        }
+
+        std::vector<const EntityBase*> entities;
+        if (type == "guest")
+            GatherEntities<Guest>(entities, entityFilter);
+        else if (type == "staff")
+            GatherEntities<Staff>(entities, entityFilter);
+        else if (type == "car")
+            GatherEntities<Vehicle>(entities, entityFilter);
+        else if (type == "litter")
+            GatherEntities<Litter>(entities, entityFilter);
+        else if (type == "balloon")
+            GatherEntities<Balloon>(entities, entityFilter);
+        else if (type == "duck")
+            GatherEntities<Duck>(entities, entityFilter);
+
+        duk_push_object(_context);
+        duk_push_uint(_context, static_cast<duk_uint_t>(entities.size()));
+        duk_put_prop_string(_context, -2, "count");
+        for (const auto* field : columns)
+        {
+            const auto size = entities.size() * GetArrayElementSize(field->ArrayType);
+            auto* data = duk_push_fixed_buffer(_context, size);
+            switch (field->ArrayType)
+            {
+                case DUK_BUFOBJ_UINT16ARRAY:
+                    FillColumn<uint16_t>(data, entities, *field);
+                    break;
+                case DUK_BUFOBJ_INT32ARRAY:
+                    FillColumn<int32_t>(data, entities, *field);
+                    break;
+                case DUK_BUFOBJ_UINT32ARRAY:
+                    FillColumn<uint32_t>(data, entities, *field);
+                    break;
+                default:
+                    FillColumn<uint8_t>(data, entities, *field);
+                    break;
+            }
+            duk_push_buffer_object(_context, -1, 0, size, field->ArrayType);
+            duk_remove(_context, -2);
+            duk_put_prop_lstring(_context, -2, field->Name.data(), field->Name.size());
+        }
+        return DukValue::take_from_stack(_context);
+    }
+
     template<typename TEntityType, typename TScriptType>
     DukValue createEntityType(duk_context* ctx, const DukValue& initializer)
     {
@@ -325,6 +566,7 @@ namespace OpenRCT2::Scripting
         dukglue_register_method(ctx, &ScMap::getEntity, "getEntity");
         dukglue_register_method(ctx, &ScMap::getAllEntities, "getAllEntities");
         dukglue_register_method(ctx, &ScMap::getAllEntitiesOnTile, "getAllEntitiesOnTile");
+        dukglue_register_method(ctx, &ScMap::queryEntities, "queryEntities");
         dukglue_register_method(ctx, &ScMap::createEntity, "createEntity");
         dukglue_register_method(ctx, &ScMap::getTrackIterator, "getTrackIterator");
     }
@@ -124,6 +124,7 @@ namespace OpenRCT2::Scripting
                     // Safely force last tile flag for last element to avoid read overrun
                     first[numElements - 1].SetLastForTile(true);
                 }
+                MapUpdateElementTypesAt(TileCoordsXY(_coords));
             }
             MapInvalidateTileFull(_coords);
         }
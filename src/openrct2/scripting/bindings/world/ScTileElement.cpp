@@ -86,6 +86,7 @@ namespace OpenRCT2::Scripting
             return;
         }
 
+        MapUpdateElementTypesAt(TileCoordsXY(_coords));
         Invalidate();
     }
 
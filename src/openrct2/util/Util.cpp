@@ -11,6 +11,8 @@
 
 #include "../common.h"
 #include "../core/Guard.hpp"
+#include "../core/IStream.hpp"
+#include "../core/JobPool.h"
 #include "../core/Path.hpp"
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
@@ -19,9 +21,11 @@
 #include "zlib.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
 #include <ctime>
+#include <memory>
 #include <random>
 
 int32_t SquaredMetresToSquaredFeet(int32_t squaredMetres)
@@ -502,6 +506,157 @@ std::vector<uint8_t> Ungzip(const void* data, const size_t dataLen)
     return output;
 }
 
+void Ungzip(OpenRCT2::IStream& source, uint64_t sourceLen, OpenRCT2::IStream& destination)
+{
+    z_stream strm{};
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+
+    {
+        const auto ret = inflateInit2(&strm, 15 | 16);
+        if (ret != Z_OK)
+        {
+            throw std::runtime_error("inflateInit2 failed with error " + std::to_string(ret));
+        }
+    }
+
+    // Inflate block by block as the compressed data is read so that neither the
+    // compressed nor the uncompressed data needs to be held in an intermediate buffer.
+    auto in = std::make_unique<Bytef[]>(CHUNK);
+    auto out = std::make_unique<Bytef[]>(CHUNK);
+    auto ret = Z_OK;
+    do
+    {
+        const auto nextBlockSize = static_cast<size_t>(std::min<uint64_t>(sourceLen, CHUNK));
+        source.Read(in.get(), nextBlockSize);
+        sourceLen -= nextBlockSize;
+
+        strm.avail_in = static_cast<uInt>(nextBlockSize);
+        strm.next_in = in.get();
+        do
+        {
+            strm.avail_out = static_cast<uInt>(CHUNK);
+            strm.next_out = out.get();
+            ret = inflate(&strm, sourceLen == 0 ? Z_FINISH : Z_NO_FLUSH);
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+            {
+                inflateEnd(&strm);
+                throw std::runtime_error("inflate failed with error " + std::to_string(ret));
+            }
+            destination.Write(out.get(), CHUNK - strm.avail_out);
+        } while (strm.avail_out == 0);
+    } while (sourceLen > 0 && ret != Z_STREAM_END);
+    inflateEnd(&strm);
+}
+
+std::vector<uint8_t> ZlibCompressBlocks(const void* data, const size_t dataLen, const size_t blockSize, const int32_t level)
+{
+    assert(data != nullptr);
+    assert(blockSize > 0);
+
+    const auto* src = static_cast<const uint8_t*>(data);
+    const auto numBlocks = (dataLen + blockSize - 1) / blockSize;
+
+    // Each block is deflated on its own so that both compression and decompression can be
+    // spread over multiple threads.
+    std::vector<std::vector<uint8_t>> blocks(numBlocks);
+    std::atomic<bool> failed{ false };
+    {
+        JobPool jobPool;
+        for (size_t i = 0; i < numBlocks; i++)
+        {
+            jobPool.AddTask([&, i]() {
+                const auto offset = i * blockSize;
+                const auto length = std::min(blockSize, dataLen - offset);
+                auto compressedLength = compressBound(static_cast<uLong>(length));
+                auto& block = blocks[i];
+                block.resize(compressedLength);
+                if (compress2(block.data(), &compressedLength, src + offset, static_cast<uLong>(length), level) != Z_OK)
+                {
+                    failed = true;
+                }
+                block.resize(compressedLength);
+            });
+        }
+        jobPool.Join();
+    }
+    if (failed)
+    {
+        throw std::runtime_error("compress2 failed");
+    }
+
+    std::vector<uint8_t> output;
+    const auto writeU32 = [&output](uint32_t value) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        output.insert(output.end(), bytes, bytes + sizeof(value));
+    };
+    writeU32(static_cast<uint32_t>(blockSize));
+    writeU32(static_cast<uint32_t>(numBlocks));
+    for (const auto& block : blocks)
+    {
+        writeU32(static_cast<uint32_t>(block.size()));
+    }
+    for (const auto& block : blocks)
+    {
+        output.insert(output.end(), block.begin(), block.end());
+    }
+    return output;
+}
+
+void ZlibDecompressBlocks(OpenRCT2::IStream& source, uint64_t sourceLen, void* destination, const size_t destinationLen)
+{
+    const auto blockSize = source.ReadValue<uint32_t>();
+    const auto numBlocks = source.ReadValue<uint32_t>();
+    if (blockSize == 0 || static_cast<uint64_t>(blockSize) * numBlocks < destinationLen)
+    {
+        throw std::runtime_error("Invalid compressed block table");
+    }
+
+    const auto tableLength = (2 + static_cast<uint64_t>(numBlocks)) * sizeof(uint32_t);
+    if (sourceLen < tableLength)
+    {
+        throw std::runtime_error("Invalid compressed block table");
+    }
+
+    std::vector<uint32_t> blockLengths(numBlocks);
+    source.Read(blockLengths.data(), blockLengths.size() * sizeof(uint32_t));
+    std::vector<uint8_t> compressed(static_cast<size_t>(sourceLen - tableLength));
+    source.Read(compressed.data(), compressed.size());
+
+    auto* dst = static_cast<uint8_t*>(destination);
+    std::atomic<bool> failed{ false };
+    {
+        JobPool jobPool;
+        size_t srcOffset = 0;
+        for (size_t i = 0; i < numBlocks; i++)
+        {
+            const auto dstOffset = i * blockSize;
+            const auto srcLength = blockLengths[i];
+            if (srcOffset + srcLength > compressed.size() || dstOffset >= destinationLen)
+            {
+                failed = true;
+                break;
+            }
+            jobPool.AddTask([&, i, srcOffset, srcLength, dstOffset]() {
+                const auto expectedLength = std::min<size_t>(blockSize, destinationLen - dstOffset);
+                auto dstLength = static_cast<uLong>(expectedLength);
+                if (uncompress(dst + dstOffset, &dstLength, compressed.data() + srcOffset, srcLength) != Z_OK
+                    || dstLength != expectedLength)
+                {
+                    failed = true;
+                }
+            });
+            srcOffset += srcLength;
+        }
+        jobPool.Join();
+    }
+    if (failed)
+    {
+        throw std::runtime_error("Unable to decompress block");
+    }
+}
+
 // Type-independent code left as macro to reduce duplicate code.
 #define ADD_CLAMP_BODY(value, value_to_add, min_cap, max_cap)                                                                  \
     if ((value_to_add > 0) && (value > (max_cap - (value_to_add))))                                                            \
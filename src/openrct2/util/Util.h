@@ -18,6 +18,11 @@
 #include <type_traits>
 #include <vector>
 
+namespace OpenRCT2
+{
+    struct IStream;
+}
+
 int32_t SquaredMetresToSquaredFeet(int32_t squaredMetres);
 int32_t MetresToFeet(int32_t metres);
 int32_t MphToKmph(int32_t mph);
@@ -39,6 +44,9 @@ float UtilRandNormalDistributed();
 bool UtilGzipCompress(FILE* source, FILE* dest);
 std::vector<uint8_t> Gzip(const void* data, const size_t dataLen);
 std::vector<uint8_t> Ungzip(const void* data, const size_t dataLen);
+void Ungzip(OpenRCT2::IStream& source, uint64_t sourceLen, OpenRCT2::IStream& destination);
+std::vector<uint8_t> ZlibCompressBlocks(const void* data, const size_t dataLen, const size_t blockSize, const int32_t level);
+void ZlibDecompressBlocks(OpenRCT2::IStream& source, uint64_t sourceLen, void* destination, const size_t destinationLen);
 
 // TODO: Make these specialized template functions, or when possible Concepts in C++20
 int8_t AddClamp_int8_t(int8_t value, int8_t value_to_add);
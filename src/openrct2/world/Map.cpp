@@ -12,6 +12,7 @@
 #include "../Cheats.h"
 #include "../Context.h"
 #include "../Game.h"
+#include "../GameStateHash.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
 #include "../actions/BannerRemoveAction.h"
@@ -21,6 +22,7 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/JobPool.h"
 #include "../interface/Cursors.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
@@ -50,11 +52,14 @@
 #include "Surface.h"
 #include "TileElementsView.h"
 #include "TileInspector.h"
+#include "TileUpdateEffects.h"
 #include "Wall.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <memory>
+#include <thread>
 
 using namespace OpenRCT2;
 
@@ -108,14 +113,50 @@ uint32_t gLandRemainingConstructionSales;
 bool gMapLandRightsUpdateSuccess;
 
 static TilePointerIndex<TileElement> _tileIndex;
-static std::vector<TileElement> _tileElements;
+static TileElementStorage _tileElements;
 static TilePointerIndex<TileElement> _tileIndexStash;
-static std::vector<TileElement> _tileElementsStash;
+static TileElementStorage _tileElementsStash;
 static size_t _tileElementsInUse;
 static size_t _tileElementsInUseStash;
 static TileCoordsXY _mapSizeStash;
 static int32_t _currentRotationStash;
 
+// Positions of each 256x256 block MapUpdateTiles updates per tick, the same with or without the job pool.
+static constexpr int32_t MapUpdateTilesPerTick = 43;
+static constexpr size_t MapUpdateTilesPerTask = 128;
+static constexpr int32_t PathWideRowLength = MAXIMUM_MAP_SIZE_TECHNICAL;
+// Tiles MapUpdatePathWideFlags updates per tick.
+static constexpr int32_t PathWideTilesPerTick = 128;
+// With PARK_FLAGS_FAST_MAP_SWEEPS both sweeps cover the whole map in 16 ticks.
+static constexpr int32_t FastMapSweepTicks = 16;
+static constexpr int32_t MapUpdateTilesFastPerTick = 256 * 256 / FastMapSweepTicks;
+static constexpr int32_t PathWideFastTilesPerTick = PathWideRowLength
+    * ((PathWideRowLength + FastMapSweepTicks - 1) / FastMapSweepTicks);
+
+static std::unique_ptr<JobPool> _mapSweepJobs;
+
+static bool UseFastMapSweeps()
+{
+    return (gParkFlags & PARK_FLAGS_FAST_MAP_SWEEPS) != 0;
+}
+
+// Returns nullptr unless the fast map sweeps are enabled and there are threads to run them on.
+static JobPool* GetMapSweepJobPool()
+{
+    // The sweeps give the same result on the job pool, so this only changes how fast they run. Only the fast sweeps
+    // have enough tiles per tick to be worth splitting up.
+    bool useParallelSweeps = UseFastMapSweeps() && std::thread::hardware_concurrency() > 1;
+    if (useParallelSweeps && _mapSweepJobs == nullptr)
+    {
+        _mapSweepJobs = std::make_unique<JobPool>();
+    }
+    else if (!useParallelSweeps && _mapSweepJobs != nullptr)
+    {
+        _mapSweepJobs.reset();
+    }
+    return _mapSweepJobs.get();
+}
+
 void StashMap()
 {
     _tileIndexStash = std::move(_tileIndex);
@@ -134,16 +175,99 @@ void UnstashMap()
     _tileElementsInUse = _tileElementsInUseStash;
 }
 
-const std::vector<TileElement>& GetTileElements()
+const TileElementStorage& GetTileElements()
 {
     return _tileElements;
 }
 
+/**
+ * Returns the number of free elements to place before a tile so that it does not span more cache lines than its number
+ * of elements requires. Always 0 unless the aligned layout is enabled.
+ */
+static size_t GetTilePadding(size_t index, size_t numElements)
+{
+    if (!gConfigGeneral.AlignTileElements)
+        return 0;
+
+    const auto offset = index % TILE_ELEMENTS_PER_CACHE_LINE;
+    if (offset == 0)
+        return 0;
+
+    const auto alignedLines = (numElements + TILE_ELEMENTS_PER_CACHE_LINE - 1) / TILE_ELEMENTS_PER_CACHE_LINE;
+    const auto unalignedLines = (offset + numElements + TILE_ELEMENTS_PER_CACHE_LINE - 1) / TILE_ELEMENTS_PER_CACHE_LINE;
+    return unalignedLines > alignedLines ? TILE_ELEMENTS_PER_CACHE_LINE - offset : 0;
+}
+
+// Free elements look the same as the ones left behind by TileElementRemove.
+static void AddFreeTileElements(TileElementStorage& elements, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        auto& element = elements.emplace_back();
+        element.BaseHeight = MAX_ELEMENT_HEIGHT;
+    }
+}
+
+static TileElement GetDefaultSurfaceElement();
+
+/**
+ * Copies all tiles into new storage, one after another in the order of the tile index. getFirstElement returns the first
+ * element of each tile or nullptr for a tile without elements, which gets a default surface element.
+ */
+template<typename TGetFirstElement> static void LayOutTileElements(size_t capacity, TGetFirstElement getFirstElement)
+{
+    TileElementStorage newElements;
+    newElements.reserve(std::max(MIN_TILE_ELEMENTS, capacity));
+    std::vector<uint32_t> tileOffsets;
+    tileOffsets.reserve(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+
+    size_t numFreeElements = 0;
+    const auto defaultSurfaceElement = GetDefaultSurfaceElement();
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            const TileElement* element = getFirstElement(TileCoordsXY{ x, y });
+            if (element == nullptr)
+            {
+                element = &defaultSurfaceElement;
+            }
+
+            size_t numElements = 0;
+            do
+            {
+                numElements++;
+            } while (!element[numElements - 1].IsLastForTile());
+
+            const auto padding = GetTilePadding(newElements.size(), numElements);
+            AddFreeTileElements(newElements, padding);
+            numFreeElements += padding;
+
+            tileOffsets.push_back(static_cast<uint32_t>(newElements.size()));
+            newElements.insert(newElements.end(), element, element + numElements);
+        }
+    }
+
+    _tileElements = std::move(newElements);
+    _tileIndex = TilePointerIndex<TileElement>(MAXIMUM_MAP_SIZE_TECHNICAL, _tileElements.data(), tileOffsets);
+    _tileElementsInUse = _tileElements.size() - numFreeElements;
+}
+
 void SetTileElements(std::vector<TileElement>&& tileElements)
 {
-    _tileElements = std::move(tileElements);
-    _tileIndex = TilePointerIndex<TileElement>(MAXIMUM_MAP_SIZE_TECHNICAL, _tileElements.data(), _tileElements.size());
-    _tileElementsInUse = _tileElements.size();
+    // The given elements have no gaps, every tile starts right after the last element of the previous one.
+    size_t index = 0;
+    LayOutTileElements(tileElements.size(), [&tileElements, &index](const TileCoordsXY&) -> const TileElement* {
+        if (index >= tileElements.size())
+            return nullptr;
+
+        const auto* firstElement = &tileElements[index];
+        do
+        {
+            index++;
+        } while (!tileElements[index - 1].IsLastForTile());
+        return firstElement;
+    });
 }
 
 static TileElement GetDefaultSurfaceElement()
@@ -205,28 +329,8 @@ static void ReorganiseTileElements(size_t capacity)
 {
     ContextSetCurrentCursor(CursorID::ZZZ);
 
-    std::vector<TileElement> newElements;
-    newElements.reserve(std::max(MIN_TILE_ELEMENTS, capacity));
-    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
-    {
-        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
-        {
-            const auto* element = MapGetFirstElementAt(TileCoordsXY{ x, y });
-            if (element == nullptr)
-            {
-                newElements.push_back(GetDefaultSurfaceElement());
-            }
-            else
-            {
-                do
-                {
-                    newElements.push_back(*element);
-                } while (!(element++)->IsLastForTile());
-            }
-        }
-    }
-
-    SetTileElements(std::move(newElements));
+    // The old storage is only released once all tiles have been copied.
+    LayOutTileElements(capacity, [](const TileCoordsXY& loc) -> const TileElement* { return MapGetFirstElementAt(loc); });
 }
 
 void ReorganiseTileElements()
@@ -242,7 +346,9 @@ static bool MapCheckFreeElementsAndReorganise(size_t numElementsOnTile, size_t n
         return false;
     }
 
-    auto totalElementsRequired = numElementsOnTile + numNewElements;
+    // Leave room for the free elements AllocateTileElements may place in front of the tile to align it
+    auto maxPadding = gConfigGeneral.AlignTileElements ? TILE_ELEMENTS_PER_CACHE_LINE - 1 : 0;
+    auto totalElementsRequired = numElementsOnTile + numNewElements + maxPadding;
     auto freeElements = _tileElements.capacity() - _tileElements.size();
     if (freeElements >= totalElementsRequired)
     {
@@ -339,6 +445,30 @@ TileElement* MapGetFirstElementAt(const TileCoordsXY& tilePos)
     return _tileIndex.GetFirstElementAt(tilePos);
 }
 
+TileElement* MapGetFirstElementOfTypeAt(const TileCoordsXY& tilePos, TileElementType type)
+{
+    if (!IsTileLocationValid(tilePos))
+    {
+        LOG_VERBOSE("Trying to access element outside of range");
+        return nullptr;
+    }
+    if (!(_tileIndex.GetElementTypesAt(tilePos) & (1u << EnumValue(type))))
+    {
+        return nullptr;
+    }
+
+    TileElement* tileElement = _tileIndex.GetFirstElementAt(tilePos);
+    if (tileElement == nullptr)
+        return nullptr;
+    do
+    {
+        if (tileElement->GetType() == type)
+            return tileElement;
+    } while (!(tileElement++)->IsLastForTile());
+
+    return nullptr;
+}
+
 TileElement* MapGetFirstElementAt(const CoordsXY& elementPos)
 {
     return MapGetFirstElementAt(TileCoordsXY{ elementPos });
@@ -373,7 +503,7 @@ TileElement* MapGetNthElementAt(const CoordsXY& coords, int32_t n)
 
 TileElement* MapGetFirstTileElementWithBaseHeightBetween(const TileCoordsXYRangedZ& loc, TileElementType type)
 {
-    TileElement* tileElement = MapGetFirstElementAt(loc);
+    TileElement* tileElement = MapGetFirstElementOfTypeAt(loc, type);
     if (tileElement == nullptr)
         return nullptr;
     do
@@ -395,6 +525,17 @@ void MapSetTileElement(const TileCoordsXY& tilePos, TileElement* elements)
         return;
     }
     _tileIndex.SetTile(tilePos, elements);
+    _tileIndex.UpdateElementTypesAt(tilePos);
+}
+
+void MapUpdateElementTypesAt(const TileCoordsXY& tilePos)
+{
+    if (!IsTileLocationValid(tilePos))
+    {
+        LOG_ERROR("Trying to access element outside of range");
+        return;
+    }
+    _tileIndex.UpdateElementTypesAt(tilePos);
 }
 
 SurfaceElement* MapGetSurfaceElementAt(const TileCoordsXY& coords)
@@ -717,24 +858,73 @@ bool MapCoordIsConnected(const TileCoordsXYZ& loc, uint8_t faceDirection)
 }
 
 /**
- *
- *  rct2: 0x006A876D
+ * Updates numTiles tiles starting at the given tile, in the order of the serial sweep, without wrapping around the end
+ * of the map. A tile reads the wide flags of the tiles left of it and on the row before it, so every row is updated by
+ * its own task that stays two tiles behind the row before it. That way every tile sees the same neighbours as in the
+ * serial sweep, and no two tasks ever touch a tile or its neighbours at the same time.
  */
-void MapUpdatePathWideFlags()
+static void MapUpdatePathWideFlagsParallel(JobPool& jobPool, const TileCoordsXY& start, int32_t numTiles)
 {
-    PROFILED_FUNCTION();
+    const int32_t endIndex = start.y * PathWideRowLength + start.x + numTiles;
+    const int32_t numRows = (endIndex - 1) / PathWideRowLength - start.y + 1;
 
-    if (gScreenFlags & (SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER))
+    // The next tile each row will update, tiles before the start count as updated.
+    std::vector<std::atomic<int32_t>> progress(numRows);
+    progress[0].store(start.x);
+    for (int32_t row = 0; row < numRows; row++)
     {
+        jobPool.AddTask([&progress, &start, endIndex, row]() {
+            const int32_t y = start.y + row;
+            const int32_t firstX = row == 0 ? start.x : 0;
+            const int32_t endX = std::min(PathWideRowLength, endIndex - y * PathWideRowLength);
+            for (int32_t x = firstX; x < endX; x++)
+            {
+                if (row > 0)
+                {
+                    const int32_t required = std::min(x + 2, PathWideRowLength);
+                    while (progress[row - 1].load(std::memory_order_acquire) < required)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                FootpathUpdatePathWideFlags(TileCoordsXY{ x, y }.ToCoordsXY());
+                progress[row].store(x + 1, std::memory_order_release);
+            }
+        });
+    }
+    jobPool.Join();
+}
+
+void MapUpdatePathWideFlags(int32_t numTiles, JobPool* jobPool)
+{
+    // Each row waits for the one before it, fewer tiles than two rows run serially.
+    if (jobPool != nullptr && numTiles >= PathWideRowLength * 2)
+    {
+        // The loop position is stored in big coordinates
+        constexpr int32_t numTilesOnMap = PathWideRowLength * PathWideRowLength;
+        auto start = TileCoordsXY(CoordsXY{ gWidePathTileLoopPosition.x, gWidePathTileLoopPosition.y });
+        if (start.x < 0 || start.y < 0 || start.x >= PathWideRowLength || start.y >= PathWideRowLength)
+        {
+            start = {};
+        }
+        while (numTiles > 0)
+        {
+            const int32_t startIndex = start.y * PathWideRowLength + start.x;
+            const int32_t count = std::min(numTiles, numTilesOnMap - startIndex);
+            MapUpdatePathWideFlagsParallel(*jobPool, start, count);
+            numTiles -= count;
+
+            const int32_t nextIndex = (startIndex + count) % numTilesOnMap;
+            start = { nextIndex % PathWideRowLength, nextIndex / PathWideRowLength };
+        }
+        gWidePathTileLoopPosition.x = start.x * COORDS_XY_STEP;
+        gWidePathTileLoopPosition.y = start.y * COORDS_XY_STEP;
         return;
     }
 
-    // Presumably update_path_wide_flags is too computationally expensive to call for every
-    // tile every update, so gWidePathTileLoopX and gWidePathTileLoopY store the x and y
-    // progress. A maximum of 128 calls is done per update.
     auto x = gWidePathTileLoopPosition.x;
     auto y = gWidePathTileLoopPosition.y;
-    for (int32_t i = 0; i < 128; i++)
+    for (int32_t i = 0; i < numTiles; i++)
     {
         FootpathUpdatePathWideFlags({ x, y });
 
@@ -754,6 +944,25 @@ void MapUpdatePathWideFlags()
     gWidePathTileLoopPosition.y = y;
 }
 
+/**
+ *
+ *  rct2: 0x006A876D
+ */
+void MapUpdatePathWideFlags()
+{
+    PROFILED_FUNCTION();
+
+    if (gScreenFlags & (SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER))
+    {
+        return;
+    }
+
+    // Presumably update_path_wide_flags is too computationally expensive to call for every
+    // tile every update, so gWidePathTileLoopX and gWidePathTileLoopY store the x and y
+    // progress. A maximum of 128 calls is done per update.
+    MapUpdatePathWideFlags(UseFastMapSweeps() ? PathWideFastTilesPerTick : PathWideTilesPerTick, GetMapSweepJobPool());
+}
+
 /**
  *
  *  rct2: 0x006A7B84
@@ -1125,7 +1334,11 @@ static size_t CountElementsOnTile(const CoordsXY& loc)
     return count;
 }
 
-static TileElement* AllocateTileElements(size_t numElementsOnTile, size_t numNewElements)
+/**
+ * Appends room for a tile to the storage, sizeBeforeTile is set to the size of the storage before any padding was added
+ * in front of the new tile.
+ */
+static TileElement* AllocateTileElements(size_t numElementsOnTile, size_t numNewElements, size_t& sizeBeforeTile)
 {
     if (!MapCheckFreeElementsAndReorganise(numElementsOnTile, numNewElements))
     {
@@ -1133,12 +1346,42 @@ static TileElement* AllocateTileElements(size_t numElementsOnTile, size_t numNew
         return nullptr;
     }
 
+    sizeBeforeTile = _tileElements.size();
+    const auto padding = GetTilePadding(_tileElements.size(), numElementsOnTile + numNewElements);
+    AddFreeTileElements(_tileElements, padding);
+
     auto oldSize = _tileElements.size();
     _tileElements.resize(_tileElements.size() + numElementsOnTile + numNewElements);
     _tileElementsInUse += numNewElements;
     return &_tileElements[oldSize];
 }
 
+/**
+ * Moves the last tile in the storage back to index and drops everything after it. Used when the last tile grows, so that
+ * its old copy and the padding in front of the new one are reclaimed straight away instead of on the next reorganise.
+ * Returns where element now is.
+ */
+static TileElement* MoveLastTileTo(const TileCoordsXY& tileLoc, size_t index, size_t numElements, TileElement* element)
+{
+    auto* first = _tileIndex.GetFirstElementAt(tileLoc);
+    const auto padding = GetTilePadding(index, numElements);
+    auto* target = &_tileElements[index + padding];
+    if (target == first)
+    {
+        return element;
+    }
+
+    std::copy(first, first + numElements, target);
+    for (auto* freeElement = &_tileElements[index]; freeElement != target; freeElement++)
+    {
+        *freeElement = {};
+        freeElement->BaseHeight = MAX_ELEMENT_HEIGHT;
+    }
+    _tileElements.resize(index + padding + numElements);
+    _tileIndex.SetTile(tileLoc, target);
+    return target + (element - first);
+}
+
 /**
  *
  *  rct2: 0x0068B1F6
@@ -1148,7 +1391,8 @@ TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants,
     const auto& tileLoc = TileCoordsXYZ(loc);
 
     auto numElementsOnTileOld = CountElementsOnTile(loc);
-    auto* newTileElement = AllocateTileElements(numElementsOnTileOld, 1);
+    size_t sizeBeforeTile = 0;
+    auto* newTileElement = AllocateTileElements(numElementsOnTileOld, 1, sizeBeforeTile);
     auto* originalTileElement = _tileIndex.GetFirstElementAt(tileLoc);
     if (newTileElement == nullptr)
     {
@@ -1158,6 +1402,15 @@ TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants,
     // Set tile index pointer to point to new element block
     _tileIndex.SetTile(tileLoc, newTileElement);
 
+    // The tile was already the last one in the storage if it ended where the storage ended before the new block.
+    size_t originalIndex = 0;
+    bool wasLastTile = false;
+    if (originalTileElement != nullptr)
+    {
+        originalIndex = originalTileElement - _tileElements.data();
+        wasLastTile = originalIndex + numElementsOnTileOld == sizeBeforeTile;
+    }
+
     bool isLastForTile = false;
     if (originalTileElement == nullptr)
     {
@@ -1196,6 +1449,7 @@ TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants,
     newTileElement->Owner = 0;
     std::memset(&newTileElement->Pad05, 0, sizeof(newTileElement->Pad05));
     std::memset(&newTileElement->Pad08, 0, sizeof(newTileElement->Pad08));
+    _tileIndex.AddElementTypeAt(tileLoc, *newTileElement);
     newTileElement++;
 
     // Insert rest of map elements above insert height
@@ -1211,24 +1465,36 @@ TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants,
         } while (!((newTileElement - 1)->IsLastForTile()));
     }
 
+    if (wasLastTile)
+    {
+        insertedElement = MoveLastTileTo(tileLoc, originalIndex, numElementsOnTileOld + 1, insertedElement);
+    }
     return insertedElement;
 }
 
-/**
- * Updates grass length, scenery age and jumping fountains.
- *
- *  rct2: 0x006646E1
- */
-void MapUpdateTiles()
+static void MapUpdateTile(const CoordsXY& mapPos, TileUpdateEffects& effects)
 {
-    PROFILED_FUNCTION();
+    auto* surfaceElement = MapGetSurfaceElementAt(mapPos);
+    if (surfaceElement != nullptr)
+    {
+        surfaceElement->UpdateGrassLength(mapPos, effects);
+        SceneryUpdateTile(mapPos, effects);
+        effects.MarkTileDirty(mapPos);
+    }
+}
 
-    int32_t ignoreScreenFlags = SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER;
-    if (gScreenFlags & ignoreScreenFlags)
-        return;
+void MapUpdateTiles(int32_t numPositions, JobPool* jobPool)
+{
+    // Too few tiles to be worth splitting into tasks.
+    const auto numBlocks = ((gMapSize.x + 255) / 256) * ((gMapSize.y + 255) / 256);
+    if (static_cast<size_t>(numPositions) * numBlocks < MapUpdateTilesPerTask * 2)
+    {
+        jobPool = nullptr;
+    }
 
-    // Update 43 more tiles (for each 256x256 block)
-    for (int32_t j = 0; j < 43; j++)
+    // Tiles only change themselves, everything else they affect is recorded and applied in order afterwards.
+    std::vector<CoordsXY> tiles;
+    for (int32_t j = 0; j < numPositions; j++)
     {
         int32_t x = 0;
         int32_t y = 0;
@@ -1251,17 +1517,58 @@ void MapUpdateTiles()
                 if (MapIsEdge(mapPos))
                     continue;
 
-                auto* surfaceElement = MapGetSurfaceElementAt(mapPos);
-                if (surfaceElement != nullptr)
+                if (jobPool == nullptr)
                 {
-                    surfaceElement->UpdateGrassLength(mapPos);
-                    SceneryUpdateTile(mapPos);
+                    MapUpdateTile(mapPos, TileUpdateEffects::Immediate());
+                }
+                else
+                {
+                    tiles.push_back(mapPos);
                 }
             }
         }
 
         gGrassSceneryTileLoopPosition++;
     }
+
+    if (tiles.empty())
+        return;
+
+    const auto numTasks = (tiles.size() + MapUpdateTilesPerTask - 1) / MapUpdateTilesPerTask;
+    std::vector<TileUpdateEffects> effects(numTasks);
+    for (size_t task = 0; task < numTasks; task++)
+    {
+        jobPool->AddTask([&tiles, &effects, task]() {
+            const auto end = std::min(tiles.size(), (task + 1) * MapUpdateTilesPerTask);
+            for (auto i = task * MapUpdateTilesPerTask; i < end; i++)
+            {
+                MapUpdateTile(tiles[i], effects[task]);
+            }
+        });
+    }
+    jobPool->Join();
+
+    for (auto& taskEffects : effects)
+    {
+        taskEffects.Apply();
+    }
+}
+
+/**
+ * Updates grass length, scenery age and jumping fountains.
+ *
+ *  rct2: 0x006646E1
+ */
+void MapUpdateTiles()
+{
+    PROFILED_FUNCTION();
+
+    int32_t ignoreScreenFlags = SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER;
+    if (gScreenFlags & ignoreScreenFlags)
+        return;
+
+    // Update 43 more tiles (for each 256x256 block)
+    MapUpdateTiles(UseFastMapSweeps() ? MapUpdateTilesFastPerTick : MapUpdateTilesPerTick, GetMapSweepJobPool());
 }
 
 void MapRemoveProvisionalElements()
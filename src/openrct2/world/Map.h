@@ -10,12 +10,15 @@
 #pragma once
 
 #include "../common.h"
+#include "../core/Memory.hpp"
 #include "Location.hpp"
 #include "TileElement.h"
 
 #include <initializer_list>
 #include <vector>
 
+class JobPool;
+
 constexpr uint8_t MINIMUM_LAND_HEIGHT = 2;
 constexpr uint8_t MAXIMUM_LAND_HEIGHT = 254;
 constexpr uint8_t MINIMUM_WATER_HEIGHT = 2;
@@ -42,6 +45,12 @@ constexpr uint32_t MAX_TILE_ELEMENTS_WITH_SPARE_ROOM = 0x1000000;
 constexpr uint32_t MAX_TILE_ELEMENTS = MAX_TILE_ELEMENTS_WITH_SPARE_ROOM - 512;
 #define MAX_TILE_TILE_ELEMENT_POINTERS (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
 
+constexpr size_t TILE_ELEMENT_CACHE_LINE_SIZE = 64;
+constexpr size_t TILE_ELEMENTS_PER_CACHE_LINE = TILE_ELEMENT_CACHE_LINE_SIZE / sizeof(TileElement);
+// The elements of all tiles. With the aligned layout, tiles are padded with free elements so none of them spans more
+// cache lines than its number of elements requires.
+using TileElementStorage = std::vector<TileElement, Memory::AlignedAllocator<TileElement, TILE_ELEMENT_CACHE_LINE_SIZE>>;
+
 #define TILE_UNDEFINED_TILE_ELEMENT NULL
 
 using PeepSpawn = CoordsXYZD;
@@ -147,7 +156,7 @@ extern uint32_t gLandRemainingConstructionSales;
 extern bool gMapLandRightsUpdateSuccess;
 
 void ReorganiseTileElements();
-const std::vector<TileElement>& GetTileElements();
+const TileElementStorage& GetTileElements();
 void SetTileElements(std::vector<TileElement>&& tileElements);
 void StashMap();
 void UnstashMap();
@@ -159,9 +168,13 @@ void MapCountRemainingLandRights();
 void MapStripGhostFlagFromElements();
 TileElement* MapGetFirstElementAt(const CoordsXY& tilePos);
 TileElement* MapGetFirstElementAt(const TileCoordsXY& tilePos);
+// Returns nullptr without walking the tile if it has no element of the type.
+TileElement* MapGetFirstElementOfTypeAt(const TileCoordsXY& tilePos, TileElementType type);
 TileElement* MapGetNthElementAt(const CoordsXY& coords, int32_t n);
 TileElement* MapGetFirstTileElementWithBaseHeightBetween(const TileCoordsXYRangedZ& loc, TileElementType type);
 void MapSetTileElement(const TileCoordsXY& tilePos, TileElement* elements);
+// Has to be called after elements of a tile were overwritten with elements of another type.
+void MapUpdateElementTypesAt(const TileCoordsXY& tilePos);
 int32_t MapHeightFromSlope(const CoordsXY& coords, int32_t slopeDirection, bool isSloped);
 BannerElement* MapGetBannerElementAt(const CoordsXYZ& bannerPos, uint8_t direction);
 SurfaceElement* MapGetSurfaceElementAt(const TileCoordsXY& coords);
@@ -179,6 +192,8 @@ bool MapCoordIsConnected(const TileCoordsXYZ& loc, uint8_t faceDirection);
 void MapRemoveProvisionalElements();
 void MapRestoreProvisionalElements();
 void MapUpdatePathWideFlags();
+// Updates the next numTiles tiles, on the threads of the job pool if one is given. The result is the same either way.
+void MapUpdatePathWideFlags(int32_t numTiles, JobPool* jobPool);
 bool MapIsLocationValid(const CoordsXY& coords);
 bool MapIsEdge(const CoordsXY& coords);
 bool MapCanBuildAt(const CoordsXYZ& loc);
@@ -222,6 +237,9 @@ int32_t TileElementIteratorNext(TileElementIterator* it);
 void TileElementIteratorRestartForTile(TileElementIterator* it);
 
 void MapUpdateTiles();
+// Updates the next numPositions (at most 65536) positions of each 256x256 block, on the threads of the job pool if one
+// is given. The result is the same either way.
+void MapUpdateTiles(int32_t numPositions, JobPool* jobPool);
 int32_t MapGetHighestZ(const CoordsXY& loc);
 
 bool TileElementWantsPathConnectionTowards(const TileCoordsXYZD& coords, const TileElement* const elementToBeRemoved);
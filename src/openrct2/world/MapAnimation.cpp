@@ -28,41 +28,129 @@
 #include "Map.h"
 #include "Scenery.h"
 
+#include <array>
+#include <unordered_map>
+
 using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
 
-static std::vector<MapAnimation> _mapAnimations;
+/**
+ * The animations of a single type. Locations are kept densely so a tick walks them in order, a location is removed
+ * by moving the last one into its slot.
+ */
+struct MapAnimationBucket
+{
+    std::vector<CoordsXYZ> Locations;
+    std::unordered_map<uint64_t, uint32_t> Indices;
+    // Where the next tick continues checking animations that are not on screen.
+    uint32_t OffscreenPosition{};
+};
+
+static std::array<MapAnimationBucket, MAP_ANIMATION_TYPE_COUNT> _mapAnimations;
+static std::vector<ScreenRect> _mapAnimationViewBounds;
+
+// Animations that are not on screen and are checked each tick per type, so ones whose element is gone still get removed.
+static constexpr uint32_t OffscreenChecksPerTick = 32;
+// The highest any animation invalidates above its base, the ride entrance sign sits on top of the station.
+static constexpr int32_t MaxAnimationHeight = 256;
+
+static bool InvalidateMapAnimation(uint8_t type, const CoordsXYZ& loc);
+
+static uint64_t GetMapAnimationKey(const CoordsXYZ& loc)
+{
+    return (static_cast<uint64_t>(loc.x & 0xFFFFFF) << 40) | (static_cast<uint64_t>(loc.y & 0xFFFFFF) << 16)
+        | static_cast<uint16_t>(loc.z);
+}
+
+static void RemoveMapAnimation(MapAnimationBucket& bucket, uint32_t index)
+{
+    bucket.Indices.erase(GetMapAnimationKey(bucket.Locations[index]));
+    if (index != bucket.Locations.size() - 1)
+    {
+        bucket.Locations[index] = bucket.Locations.back();
+        bucket.Indices[GetMapAnimationKey(bucket.Locations[index])] = index;
+    }
+    bucket.Locations.pop_back();
+}
 
-constexpr size_t MAX_ANIMATED_OBJECTS = 2000;
+void MapAnimationCreate(int32_t type, const CoordsXYZ& loc)
+{
+    if (type < 0 || type >= MAP_ANIMATION_TYPE_COUNT)
+        return;
 
-static bool InvalidateMapAnimation(const MapAnimation& obj);
+    auto& bucket = _mapAnimations[type];
+    const auto index = static_cast<uint32_t>(bucket.Locations.size());
+    if (bucket.Indices.emplace(GetMapAnimationKey(loc), index).second)
+    {
+        bucket.Locations.push_back(loc);
+    }
+}
 
-static bool DoesAnimationExist(int32_t type, const CoordsXYZ& location)
+/**
+ * Animations of these types change the park or peeps and have to be updated whether they are seen or not, the others
+ * only redraw their tile.
+ */
+static bool IsMapAnimationVisualOnly(uint8_t type)
 {
-    for (const auto& a : _mapAnimations)
+    switch (type)
     {
-        if (a.type == type && a.location == location)
+        case MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO:
+        case MAP_ANIMATION_TYPE_WALL_DOOR:
+        case MAP_ANIMATION_TYPE_REMOVE:
+            return false;
+        case MAP_ANIMATION_TYPE_SMALL_SCENERY:
+            // Clocks send peeps to look at them on these ticks.
+            return (gCurrentTicks & 0x3FF) || !GameIsNotPaused();
+        default:
+            return true;
+    }
+}
+
+static bool IsMapAnimationOnScreen(const CoordsXYZ& loc)
+{
+    // Same area as MapInvalidateTileZoom1 invalidates for the highest animation.
+    const auto screenCoords = Translate3DTo2DWithZ(GetCurrentRotation(), { loc.x + 16, loc.y + 16, 0 });
+    const auto left = screenCoords.x - 32;
+    const auto top = screenCoords.y - 32 - (loc.z + MaxAnimationHeight);
+    const auto right = screenCoords.x + 32;
+    const auto bottom = screenCoords.y + 32 - loc.z;
+    for (const auto& view : _mapAnimationViewBounds)
+    {
+        if (right > view.GetLeft() && bottom > view.GetTop() && left < view.GetRight() && top < view.GetBottom())
         {
-            // Animation already exists
             return true;
         }
     }
     return false;
 }
 
-void MapAnimationCreate(int32_t type, const CoordsXYZ& loc)
+static void InvalidateMapAnimationBucket(uint8_t type, MapAnimationBucket& bucket)
 {
-    if (!DoesAnimationExist(type, loc))
+    const bool visualOnly = IsMapAnimationVisualOnly(type);
+    if (bucket.OffscreenPosition >= bucket.Locations.size())
+    {
+        bucket.OffscreenPosition = 0;
+    }
+    const auto offscreenEnd = bucket.OffscreenPosition + OffscreenChecksPerTick;
+
+    uint32_t index = 0;
+    while (index < bucket.Locations.size())
     {
-        if (_mapAnimations.size() < MAX_ANIMATED_OBJECTS)
+        const auto loc = bucket.Locations[index];
+        if (visualOnly && !IsMapAnimationOnScreen(loc) && (index < bucket.OffscreenPosition || index >= offscreenEnd))
+        {
+            index++;
+        }
+        else if (InvalidateMapAnimation(type, loc))
         {
-            // Create new animation
-            _mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
+            // Map animation has finished, remove it and check the one moved into its slot next.
+            RemoveMapAnimation(bucket, index);
         }
         else
         {
-            LOG_ERROR("Exceeded the maximum number of animations");
+            index++;
         }
     }
+    bucket.OffscreenPosition = offscreenEnd;
 }
 
 /**
@@ -73,18 +161,11 @@ void MapAnimationInvalidateAll()
 {
     PROFILED_FUNCTION();
 
-    auto it = _mapAnimations.begin();
-    while (it != _mapAnimations.end())
+    // All animations invalidate their tile with MapInvalidateTileZoom1, which skips viewports zoomed out further.
+    ViewportsGetViewBounds(_mapAnimationViewBounds, ZoomLevel{ 1 });
+    for (uint8_t type = 0; type < MAP_ANIMATION_TYPE_COUNT; type++)
     {
-        if (InvalidateMapAnimation(*it))
-        {
-            // Map animation has finished, remove it
-            it = _mapAnimations.erase(it);
-        }
-        else
-        {
-            it++;
-        }
+        InvalidateMapAnimationBucket(type, _mapAnimations[type]);
     }
 }
 
@@ -583,23 +664,36 @@ static constexpr map_animation_invalidate_event_handler _animatedObjectEventHand
 /**
  * @returns true if the animation should be removed.
  */
-static bool InvalidateMapAnimation(const MapAnimation& a)
+static bool InvalidateMapAnimation(uint8_t type, const CoordsXYZ& loc)
 {
-    if (a.type < std::size(_animatedObjectEventHandlers))
+    if (type < std::size(_animatedObjectEventHandlers))
     {
-        return _animatedObjectEventHandlers[a.type](a.location);
+        return _animatedObjectEventHandlers[type](loc);
     }
     return true;
 }
 
-const std::vector<MapAnimation>& GetMapAnimations()
+std::vector<MapAnimation> GetMapAnimations()
 {
-    return _mapAnimations;
+    std::vector<MapAnimation> animations;
+    for (uint8_t type = 0; type < MAP_ANIMATION_TYPE_COUNT; type++)
+    {
+        for (const auto& loc : _mapAnimations[type].Locations)
+        {
+            animations.push_back({ type, loc });
+        }
+    }
+    return animations;
 }
 
 static void ClearMapAnimations()
 {
-    _mapAnimations.clear();
+    for (auto& bucket : _mapAnimations)
+    {
+        bucket.Locations.clear();
+        bucket.Indices.clear();
+        bucket.OffscreenPosition = 0;
+    }
 }
 
 void MapAnimationAutoCreate()
@@ -43,6 +43,7 @@ enum
 
 void MapAnimationCreate(int32_t type, const CoordsXYZ& loc);
 void MapAnimationInvalidateAll();
-const std::vector<MapAnimation>& GetMapAnimations();
+// Copies the animations ordered by type.
+std::vector<MapAnimation> GetMapAnimations();
 void MapAnimationAutoCreate();
 void MapAnimationAutoCreateAtTileElement(TileCoordsXY coords, TileElement* el);
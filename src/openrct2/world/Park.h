@@ -41,6 +41,7 @@ enum : uint32_t
     PARK_FLAGS_SPRITES_INITIALISED = (1 << 18),  // After a scenario is loaded this prevents edits in the scenario editor
     PARK_FLAGS_SIX_FLAGS_DEPRECATED = (1 << 19), // Not used anymore
 
+    PARK_FLAGS_FAST_MAP_SWEEPS = (1u << 29),   // OpenRCT2 only, grass, scenery and wide paths are updated more often
     PARK_FLAGS_RCT1_INTEREST = (1u << 30),     // OpenRCT2 only
     PARK_FLAGS_UNLOCK_ALL_PRICES = (1u << 31), // OpenRCT2 only
 };
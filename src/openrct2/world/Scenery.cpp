@@ -37,6 +37,7 @@
 #include "Footpath.h"
 #include "Map.h"
 #include "Park.h"
+#include "TileUpdateEffects.h"
 #include "Wall.h"
 
 uint8_t gSceneryQuadrant;
@@ -125,7 +126,7 @@ int32_t LargeSceneryText::MeasureHeight(std::string_view text) const
     return result;
 }
 
-void SceneryUpdateTile(const CoordsXY& sceneryPos)
+void SceneryUpdateTile(const CoordsXY& sceneryPos, TileUpdateEffects& effects)
 {
     TileElement* tileElement;
 
@@ -144,7 +145,7 @@ void SceneryUpdateTile(const CoordsXY& sceneryPos)
 
         if (tileElement->GetType() == TileElementType::SmallScenery)
         {
-            tileElement->AsSmallScenery()->UpdateAge(sceneryPos);
+            tileElement->AsSmallScenery()->UpdateAge(sceneryPos, effects);
         }
         else if (tileElement->GetType() == TileElementType::Path)
         {
@@ -155,11 +156,11 @@ void SceneryUpdateTile(const CoordsXY& sceneryPos)
                 {
                     if (pathAddEntry->flags & PATH_ADDITION_FLAG_JUMPING_FOUNTAIN_WATER)
                     {
-                        JumpingFountain::StartAnimation(JumpingFountainType::Water, sceneryPos, tileElement);
+                        effects.StartFountain(JumpingFountainType::Water, sceneryPos, *tileElement);
                     }
                     else if (pathAddEntry->flags & PATH_ADDITION_FLAG_JUMPING_FOUNTAIN_SNOW)
                     {
-                        JumpingFountain::StartAnimation(JumpingFountainType::Snow, sceneryPos, tileElement);
+                        effects.StartFountain(JumpingFountainType::Snow, sceneryPos, *tileElement);
                     }
                 }
             }
@@ -171,7 +172,7 @@ void SceneryUpdateTile(const CoordsXY& sceneryPos)
  *
  *  rct2: 0x006E33D9
  */
-void SmallSceneryElement::UpdateAge(const CoordsXY& sceneryPos)
+void SmallSceneryElement::UpdateAge(const CoordsXY& sceneryPos, TileUpdateEffects& effects)
 {
     auto* sceneryEntry = GetEntry();
     if (sceneryEntry == nullptr)
@@ -186,7 +187,7 @@ void SmallSceneryElement::UpdateAge(const CoordsXY& sceneryPos)
 
     if (!sceneryEntry->HasFlag(SMALL_SCENERY_FLAG_CAN_BE_WATERED) || WeatherIsDry(gClimateCurrent.Weather) || GetAge() < 5)
     {
-        IncreaseAge(sceneryPos);
+        IncreaseAge(sceneryPos, effects);
         return;
     }
 
@@ -207,14 +208,14 @@ void SmallSceneryElement::UpdateAge(const CoordsXY& sceneryPos)
             case TileElementType::LargeScenery:
             case TileElementType::Entrance:
             case TileElementType::Path:
-                MapInvalidateTileZoom1({ sceneryPos, tileElementAbove->GetBaseZ(), tileElementAbove->GetClearanceZ() });
-                IncreaseAge(sceneryPos);
+                effects.InvalidateTileZoom1({ sceneryPos, tileElementAbove->GetBaseZ(), tileElementAbove->GetClearanceZ() });
+                IncreaseAge(sceneryPos, effects);
                 return;
             case TileElementType::SmallScenery:
                 sceneryEntry = tileElementAbove->AsSmallScenery()->GetEntry();
                 if (sceneryEntry->HasFlag(SMALL_SCENERY_FLAG_VOFFSET_CENTRE))
                 {
-                    IncreaseAge(sceneryPos);
+                    IncreaseAge(sceneryPos, effects);
                     return;
                 }
                 break;
@@ -225,7 +226,7 @@ void SmallSceneryElement::UpdateAge(const CoordsXY& sceneryPos)
 
     // Reset age / water plant
     SetAge(0);
-    MapInvalidateTileZoom1({ sceneryPos, GetBaseZ(), GetClearanceZ() });
+    effects.InvalidateTileZoom1({ sceneryPos, GetBaseZ(), GetClearanceZ() });
 }
 
 /**
@@ -15,6 +15,8 @@
 
 #include <vector>
 
+class TileUpdateEffects;
+
 #define SCENERY_WITHER_AGE_THRESHOLD_1 0x28
 #define SCENERY_WITHER_AGE_THRESHOLD_2 0x37
 
@@ -69,7 +71,7 @@ extern const CoordsXY SceneryQuadrantOffsets[];
 extern money64 gClearSceneryCost;
 
 void SceneryInit();
-void SceneryUpdateTile(const CoordsXY& sceneryPos);
+void SceneryUpdateTile(const CoordsXY& sceneryPos, TileUpdateEffects& effects);
 void ScenerySetDefaultPlacementConfiguration();
 void SceneryRemoveGhostToolPlacement();
 
@@ -25,6 +25,7 @@
 #include "Park.h"
 #include "Scenery.h"
 #include "Surface.h"
+#include "TileUpdateEffects.h"
 
 uint8_t SmallSceneryElement::GetSceneryQuadrant() const
 {
@@ -57,7 +58,7 @@ void SmallSceneryElement::SetAge(uint8_t newAge)
     this->age = newAge;
 }
 
-void SmallSceneryElement::IncreaseAge(const CoordsXY& sceneryPos)
+void SmallSceneryElement::IncreaseAge(const CoordsXY& sceneryPos, TileUpdateEffects& effects)
 {
     if (IsGhost())
         return;
@@ -73,7 +74,7 @@ void SmallSceneryElement::IncreaseAge(const CoordsXY& sceneryPos)
 
             if (sceneryEntry->HasFlag(SMALL_SCENERY_FLAG_CAN_WITHER))
             {
-                MapInvalidateTileZoom1({ sceneryPos, GetBaseZ(), GetClearanceZ() });
+                effects.InvalidateTileZoom1({ sceneryPos, GetBaseZ(), GetClearanceZ() });
             }
         }
     }
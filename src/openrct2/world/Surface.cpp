@@ -16,6 +16,7 @@
 #include "../scenario/Scenario.h"
 #include "Location.hpp"
 #include "Map.h"
+#include "TileUpdateEffects.h"
 
 uint32_t SurfaceElement::GetSurfaceStyle() const
 {
@@ -86,6 +87,11 @@ void SurfaceElement::SetGrassLength(uint8_t newLength)
 }
 
 void SurfaceElement::SetGrassLengthAndInvalidate(uint8_t length, const CoordsXY& coords)
+{
+    SetGrassLengthAndInvalidate(length, coords, TileUpdateEffects::Immediate());
+}
+
+void SurfaceElement::SetGrassLengthAndInvalidate(uint8_t length, const CoordsXY& coords, TileUpdateEffects& effects)
 {
     uint8_t oldLength = GrassLength & 0x7;
     uint8_t newLength = length & 0x7;
@@ -106,14 +112,14 @@ void SurfaceElement::SetGrassLengthAndInvalidate(uint8_t length, const CoordsXY&
     }
 
     int32_t z = GetBaseZ();
-    MapInvalidateTile({ coords, z, z + 16 });
+    effects.InvalidateTile({ coords, z, z + 16 });
 }
 
 /**
  *
  *  rct2: 0x006647A1
  */
-void SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
+void SurfaceElement::UpdateGrassLength(const CoordsXY& coords, TileUpdateEffects& effects)
 {
     // Check if tile is grass
     if (!CanGrassGrow())
@@ -125,7 +131,7 @@ void SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
     if (GetWaterHeight() > GetBaseZ() || !MapIsLocationInPark(coords))
     {
         if (grassLengthTmp != GRASS_LENGTH_CLEAR_0)
-            SetGrassLengthAndInvalidate(GRASS_LENGTH_CLEAR_0, coords);
+            SetGrassLengthAndInvalidate(GRASS_LENGTH_CLEAR_0, coords, effects);
 
         return;
     }
@@ -160,13 +166,13 @@ void SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
                 if (GrassLength & 8)
                 {
                     // Random growth rate (length nibble)
-                    GrassLength |= ScenarioRand() & 0x70;
+                    effects.GrowGrass(*this);
                 }
                 else
                 {
                     // Increase length if not at max length
                     if (grassLengthTmp != GRASS_LENGTH_CLUMPS_2)
-                        SetGrassLengthAndInvalidate(grassLengthTmp + 1, coords);
+                        SetGrassLengthAndInvalidate(grassLengthTmp + 1, coords, effects);
                 }
             }
         }
@@ -184,7 +190,7 @@ void SurfaceElement::UpdateGrassLength(const CoordsXY& coords)
                 continue;
 
             if (grassLengthTmp != GRASS_LENGTH_CLEAR_0)
-                SetGrassLengthAndInvalidate(GRASS_LENGTH_CLEAR_0, coords);
+                SetGrassLengthAndInvalidate(GRASS_LENGTH_CLEAR_0, coords, effects);
         }
         break;
     }
@@ -23,6 +23,7 @@ struct LargeSceneryEntry;
 struct SmallSceneryEntry;
 struct WallSceneryEntry;
 struct PathAdditionEntry;
+class TileUpdateEffects;
 struct BannerSceneryEntry;
 struct FootpathEntry;
 class LargeSceneryObject;
@@ -216,7 +217,8 @@ public:
     uint8_t GetGrassLength() const;
     void SetGrassLength(uint8_t newLength);
     void SetGrassLengthAndInvalidate(uint8_t newLength, const CoordsXY& coords);
-    void UpdateGrassLength(const CoordsXY& coords);
+    void SetGrassLengthAndInvalidate(uint8_t newLength, const CoordsXY& coords, TileUpdateEffects& effects);
+    void UpdateGrassLength(const CoordsXY& coords, TileUpdateEffects& effects);
 
     uint8_t GetOwnership() const;
     void SetOwnership(uint8_t newOwnership);
@@ -447,7 +449,7 @@ public:
     const SmallSceneryEntry* GetEntry() const;
     uint8_t GetAge() const;
     void SetAge(uint8_t newAge);
-    void IncreaseAge(const CoordsXY& sceneryPos);
+    void IncreaseAge(const CoordsXY& sceneryPos, TileUpdateEffects& effects);
     uint8_t GetSceneryQuadrant() const;
     void SetSceneryQuadrant(uint8_t newQuadrant);
     colour_t GetPrimaryColour() const;
@@ -458,7 +460,7 @@ public:
     void SetTertiaryColour(colour_t colour);
     bool NeedsSupports() const;
     void SetNeedsSupports();
-    void UpdateAge(const CoordsXY& sceneryPos);
+    void UpdateAge(const CoordsXY& sceneryPos, TileUpdateEffects& effects);
 };
 assert_struct_size(SmallSceneryElement, 16);
 
@@ -116,14 +116,14 @@ namespace OpenRCT2
 
         Iterator begin() noexcept
         {
-            T* element = reinterpret_cast<T*>(MapGetFirstElementAt(_loc));
-
-            if constexpr (!std::is_same_v<T, TileElement>)
+            if constexpr (std::is_same_v<T, TileElement>)
             {
-                element = Detail::NextMatchingTile<T>(element);
+                return Iterator{ MapGetFirstElementAt(_loc) };
+            }
+            else
+            {
+                return Iterator{ reinterpret_cast<T*>(MapGetFirstElementOfTypeAt(_loc, T::ElementType)) };
             }
-
-            return Iterator{ element };
         }
 
         Iterator end() noexcept
@@ -367,6 +367,7 @@ namespace OpenRCT2::TileInspector
             bool lastForTile = pastedElement->IsLastForTile();
             *pastedElement = element;
             pastedElement->SetLastForTile(lastForTile);
+            MapUpdateElementTypesAt(tileLoc);
 
             MapAnimationAutoCreateAtTileElement(tileLoc, pastedElement);
             MapInvalidateTileFull(loc);
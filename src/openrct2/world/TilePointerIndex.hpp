@@ -18,8 +18,31 @@
 template<typename T> class TilePointerIndex
 {
     std::vector<T*> TilePointers;
+    // A bit for every element type on each tile. Removing an element leaves its bit set until the index is rebuilt, so
+    // only a clear bit is exact: the tile has no element of that type.
+    std::vector<uint16_t> TileElementTypes;
     uint16_t MapSize{};
 
+    static uint16_t GetElementTypeBit(const T& element)
+    {
+        return static_cast<uint16_t>(1u << static_cast<uint8_t>(element.GetType()));
+    }
+
+    // Returns the number of elements on the tile.
+    size_t AddTile(T* firstElement)
+    {
+        TilePointers.emplace_back(firstElement);
+        uint16_t elementTypes = 0;
+        size_t numElements = 0;
+        do
+        {
+            elementTypes |= GetElementTypeBit(firstElement[numElements]);
+            numElements++;
+        } while (!firstElement[numElements - 1].IsLastForTile());
+        TileElementTypes.push_back(elementTypes);
+        return numElements;
+    }
+
 public:
     TilePointerIndex() = default;
 
@@ -27,6 +50,7 @@ public:
     {
         MapSize = mapSize;
         TilePointers.reserve(MapSize * MapSize);
+        TileElementTypes.reserve(MapSize * MapSize);
 
         size_t index = 0;
         for (size_t y = 0; y < MapSize; y++)
@@ -34,15 +58,25 @@ public:
             for (size_t x = 0; x < MapSize; x++)
             {
                 assert(index < count);
-                TilePointers.emplace_back(&tileElements[index]);
-                do
-                {
-                    index++;
-                } while (!tileElements[index - 1].IsLastForTile());
+                index += AddTile(&tileElements[index]);
             }
         }
     }
 
+    // For tiles that do not directly follow each other, the offset of every tile is given in the order of the index.
+    explicit TilePointerIndex(const uint16_t mapSize, T* tileElements, const std::vector<uint32_t>& tileOffsets)
+    {
+        MapSize = mapSize;
+        TilePointers.reserve(MapSize * MapSize);
+        TileElementTypes.reserve(MapSize * MapSize);
+
+        assert(tileOffsets.size() == static_cast<size_t>(MapSize) * MapSize);
+        for (auto offset : tileOffsets)
+        {
+            AddTile(&tileElements[offset]);
+        }
+    }
+
     T* GetFirstElementAt(TileCoordsXY coords)
     {
         return TilePointers[coords.x + (coords.y * MapSize)];
@@ -52,4 +86,29 @@ public:
     {
         TilePointers[coords.x + (coords.y * MapSize)] = tileElement;
     }
+
+    uint16_t GetElementTypesAt(TileCoordsXY coords) const
+    {
+        return TileElementTypes[coords.x + (coords.y * MapSize)];
+    }
+
+    void AddElementTypeAt(TileCoordsXY coords, const T& element)
+    {
+        TileElementTypes[coords.x + (coords.y * MapSize)] |= GetElementTypeBit(element);
+    }
+
+    // Recomputes the element types of a tile after elements were changed in place.
+    void UpdateElementTypesAt(TileCoordsXY coords)
+    {
+        uint16_t elementTypes = 0;
+        const T* element = GetFirstElementAt(coords);
+        if (element != nullptr)
+        {
+            do
+            {
+                elementTypes |= GetElementTypeBit(*element);
+            } while (!(element++)->IsLastForTile());
+        }
+        TileElementTypes[coords.x + (coords.y * MapSize)] = elementTypes;
+    }
 };
@@ -0,0 +1,98 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TileUpdateEffects.h"
+
+#include "../GameStateHash.h"
+#include "../entity/Fountain.h"
+#include "../scenario/Scenario.h"
+#include "Map.h"
+#include "TileElement.h"
+
+TileUpdateEffects& TileUpdateEffects::Immediate()
+{
+    static TileUpdateEffects effects(true);
+    return effects;
+}
+
+TileUpdateEffects::TileUpdateEffects(bool immediate)
+    : _immediate(immediate)
+{
+}
+
+void TileUpdateEffects::InvalidateTile(const CoordsXYRangedZ& tilePos)
+{
+    Add({ Kind::InvalidateTile, 0, tilePos, nullptr });
+}
+
+void TileUpdateEffects::InvalidateTileZoom1(const CoordsXYRangedZ& tilePos)
+{
+    Add({ Kind::InvalidateTileZoom1, 0, tilePos, nullptr });
+}
+
+void TileUpdateEffects::GrowGrass(SurfaceElement& surfaceElement)
+{
+    Add({ Kind::GrowGrass, 0, {}, reinterpret_cast<TileElement*>(&surfaceElement) });
+}
+
+void TileUpdateEffects::StartFountain(JumpingFountainType type, const CoordsXY& loc, const TileElement& pathElement)
+{
+    Add({ Kind::StartFountain, static_cast<uint8_t>(type), { loc, 0, 0 }, const_cast<TileElement*>(&pathElement) });
+}
+
+void TileUpdateEffects::MarkTileDirty(const CoordsXY& loc)
+{
+    Add({ Kind::MarkTileDirty, 0, { loc, 0, 0 }, nullptr });
+}
+
+void TileUpdateEffects::Add(const Effect& effect)
+{
+    if (_immediate)
+    {
+        Apply(effect);
+    }
+    else
+    {
+        _effects.push_back(effect);
+    }
+}
+
+void TileUpdateEffects::Apply()
+{
+    for (const auto& effect : _effects)
+    {
+        Apply(effect);
+    }
+    _effects.clear();
+}
+
+void TileUpdateEffects::Apply(const Effect& effect)
+{
+    switch (effect.Type)
+    {
+        case Kind::InvalidateTile:
+            MapInvalidateTile(effect.Pos);
+            break;
+        case Kind::InvalidateTileZoom1:
+            MapInvalidateTileZoom1(effect.Pos);
+            break;
+        case Kind::GrowGrass:
+        {
+            auto* surfaceElement = effect.Element->AsSurface();
+            surfaceElement->SetGrassLength(surfaceElement->GetGrassLength() | (ScenarioRand() & 0x70));
+            break;
+        }
+        case Kind::StartFountain:
+            JumpingFountain::StartAnimation(static_cast<JumpingFountainType>(effect.FountainType), effect.Pos, effect.Element);
+            break;
+        case Kind::MarkTileDirty:
+            OpenRCT2::GameStateHash::Get().MarkTileDirty(effect.Pos);
+            break;
+    }
+}
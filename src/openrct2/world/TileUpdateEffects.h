@@ -0,0 +1,68 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Location.hpp"
+
+#include <cstdint>
+#include <vector>
+
+enum class JumpingFountainType : uint8_t;
+struct SurfaceElement;
+struct TileElement;
+
+/**
+ * Side effects of updating a tile that reach beyond the tile itself: random numbers, viewports, entities and the
+ * game state hash. Tiles updated on worker threads record their effects, which are applied afterwards on the main
+ * thread in the same order the serial update would have caused them.
+ */
+class TileUpdateEffects
+{
+public:
+    // Applies every effect as soon as it is added, for tiles updated on the main thread.
+    static TileUpdateEffects& Immediate();
+
+    TileUpdateEffects() = default;
+
+    void InvalidateTile(const CoordsXYRangedZ& tilePos);
+    void InvalidateTileZoom1(const CoordsXYRangedZ& tilePos);
+    // Adds a random growth rate to the grass length.
+    void GrowGrass(SurfaceElement& surfaceElement);
+    void StartFountain(JumpingFountainType type, const CoordsXY& loc, const TileElement& pathElement);
+    void MarkTileDirty(const CoordsXY& loc);
+
+    void Apply();
+
+private:
+    enum class Kind : uint8_t
+    {
+        InvalidateTile,
+        InvalidateTileZoom1,
+        GrowGrass,
+        StartFountain,
+        MarkTileDirty,
+    };
+
+    struct Effect
+    {
+        Kind Type;
+        uint8_t FountainType;
+        CoordsXYRangedZ Pos;
+        TileElement* Element;
+    };
+
+    explicit TileUpdateEffects(bool immediate);
+
+    void Add(const Effect& effect);
+    static void Apply(const Effect& effect);
+
+    std::vector<Effect> _effects;
+    bool _immediate{};
+};
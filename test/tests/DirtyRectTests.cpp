@@ -0,0 +1,100 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/drawing/X8DrawingEngine.h>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2::Drawing;
+
+class DirtyRectTests : public testing::Test
+{
+protected:
+    std::vector<uint8_t> _blocks;
+    DirtyGrid _grid{};
+
+    // Each string is a row of blocks, 'x' marks a dirty block.
+    DirtyGrid& CreateGrid(const std::vector<std::string>& rows)
+    {
+        _blocks.clear();
+        for (const auto& row : rows)
+        {
+            for (auto c : row)
+            {
+                _blocks.push_back(c == 'x' ? 0xFF : 0);
+            }
+        }
+        _grid.BlockColumns = static_cast<uint32_t>(rows[0].size());
+        _grid.BlockRows = static_cast<uint32_t>(rows.size());
+        _grid.Blocks = _blocks.data();
+        return _grid;
+    }
+
+    static void AssertExactCover(const std::vector<std::string>& rows, const std::vector<DirtyRect>& rects)
+    {
+        std::vector<std::string> covered(rows.size(), std::string(rows[0].size(), '-'));
+        for (const auto& rect : rects)
+        {
+            for (uint32_t y = rect.Y; y < rect.Y + rect.Rows; y++)
+            {
+                for (uint32_t x = rect.X; x < rect.X + rect.Columns; x++)
+                {
+                    ASSERT_EQ(covered[y][x], '-');
+                    covered[y][x] = 'x';
+                }
+            }
+        }
+        ASSERT_EQ(covered, rows);
+    }
+};
+
+TEST_F(DirtyRectTests, merges_rows_and_columns)
+{
+    const std::vector<std::string> rows = {
+        "----------",
+        "-xxxx-----",
+        "-xx-------",
+        "----------",
+    };
+    std::vector<DirtyRect> rects;
+    ExtractDirtyRects(CreateGrid(rows), rects);
+
+    ASSERT_EQ(rects.size(), 2u);
+    AssertExactCover(rows, rects);
+    for (auto block : _blocks)
+    {
+        ASSERT_EQ(block, 0);
+    }
+}
+
+TEST_F(DirtyRectTests, full_grid_is_one_rect)
+{
+    const std::vector<std::string> rows(9, std::string(16, 'x'));
+    std::vector<DirtyRect> rects;
+    ExtractDirtyRects(CreateGrid(rows), rects);
+
+    ASSERT_EQ(rects.size(), 1u);
+    AssertExactCover(rows, rects);
+}
+
+TEST_F(DirtyRectTests, irregular_regions)
+{
+    const std::vector<std::string> rows = {
+        "xx--xxxx-x",
+        "xx--xxxx--",
+        "-xxxxx----",
+        "-x-x-x-x-x",
+        "xxxxxxxxxx",
+    };
+    std::vector<DirtyRect> rects;
+    ExtractDirtyRects(CreateGrid(rows), rects);
+
+    AssertExactCover(rows, rects);
+}
@@ -0,0 +1,123 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/GameStateHash.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/EntityTweener.h>
+#include <openrct2/object/ObjectManager.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Surface.h>
+#include <string>
+
+using namespace OpenRCT2;
+
+class GameStateHashTests : public testing::Test
+{
+protected:
+    std::unique_ptr<IContext> LoadPark(const std::string& parkPath)
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        auto context = CreateContext();
+        if (!context->Initialise())
+            return {};
+
+        auto importer = ParkImporter::CreateS6(context->GetObjectRepository());
+        auto loadResult = importer->LoadSavedGame(parkPath.c_str(), false);
+        context->GetObjectManager().LoadObjects(loadResult.RequiredObjects);
+        importer->Import();
+
+        ResetEntitySpatialIndices();
+        EntityTweener::Get().Reset();
+        GameStateHash::Get().Reset();
+        return context;
+    }
+
+    static uint64_t RunTicks(IContext& context, uint32_t ticks)
+    {
+        auto& stateHash = GameStateHash::Get();
+        uint64_t root = stateHash.Update();
+        for (uint32_t i = 0; i < ticks; i++)
+        {
+            context.GetGameState()->UpdateLogic();
+            root = stateHash.Update();
+        }
+        return root;
+    }
+};
+
+TEST_F(GameStateHashTests, SameSimulationSameHash)
+{
+    std::string parkPath = TestData::GetParkPath("bpb.sv6");
+
+    auto first = LoadPark(parkPath);
+    ASSERT_NE(first, nullptr);
+    auto firstRoot = RunTicks(*first, 200);
+    first.reset();
+
+    auto second = LoadPark(parkPath);
+    ASSERT_NE(second, nullptr);
+    auto secondRoot = RunTicks(*second, 200);
+
+    ASSERT_EQ(firstRoot, secondRoot);
+}
+
+TEST_F(GameStateHashTests, MarkedTileChangesOnlyMapHash)
+{
+    auto context = LoadPark(TestData::GetParkPath("bpb.sv6"));
+    ASSERT_NE(context, nullptr);
+
+    auto& stateHash = GameStateHash::Get();
+    stateHash.Update();
+    auto before = stateHash.GetCategoryHashes();
+
+    const auto coords = TileCoordsXY{ 40, 40 }.ToCoordsXY();
+    auto* surface = MapGetSurfaceElementAt(coords);
+    ASSERT_NE(surface, nullptr);
+    surface->SetSurfaceStyle(surface->GetSurfaceStyle() + 1);
+    stateHash.MarkTileDirty(coords);
+    stateHash.Update();
+    auto after = stateHash.GetCategoryHashes();
+
+    ASSERT_NE(before[EnumValue(GameStateHash::Category::Map)], after[EnumValue(GameStateHash::Category::Map)]);
+    ASSERT_EQ(before[EnumValue(GameStateHash::Category::Entities)], after[EnumValue(GameStateHash::Category::Entities)]);
+    ASSERT_EQ(before[EnumValue(GameStateHash::Category::Rides)], after[EnumValue(GameStateHash::Category::Rides)]);
+}
+
+TEST_F(GameStateHashTests, UnmarkedChangeFoundWithinScrubTicks)
+{
+    auto context = LoadPark(TestData::GetParkPath("bpb.sv6"));
+    ASSERT_NE(context, nullptr);
+
+    auto& stateHash = GameStateHash::Get();
+    stateHash.Update();
+    const auto mapHash = stateHash.GetCategoryHash(GameStateHash::Category::Map);
+
+    auto* surface = MapGetSurfaceElementAt(TileCoordsXY{ 40, 40 }.ToCoordsXY());
+    ASSERT_NE(surface, nullptr);
+    surface->SetSurfaceStyle(surface->GetSurfaceStyle() + 1);
+
+    // Only re-hash the leaves, without running the simulation.
+    for (uint32_t i = 0; i < GameStateHash::ScrubTicks; i++)
+    {
+        gCurrentTicks++;
+        stateHash.Update();
+    }
+    ASSERT_NE(mapHash, stateHash.GetCategoryHash(GameStateHash::Category::Map));
+}
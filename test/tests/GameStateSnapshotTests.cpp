@@ -0,0 +1,131 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/GameStateSnapshots.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/core/DataSerialiser.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/entity/EntityList.h>
+#include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/EntityTweener.h>
+#include <openrct2/entity/Guest.h>
+#include <openrct2/object/ObjectManager.h>
+#include <openrct2/scenario/Scenario.h>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class GameStateSnapshotTests : public testing::Test
+{
+protected:
+    std::unique_ptr<IContext> LoadPark(const std::string& parkPath)
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        auto context = CreateContext();
+        if (!context->Initialise())
+            return {};
+
+        auto importer = ParkImporter::CreateS6(context->GetObjectRepository());
+        auto loadResult = importer->LoadSavedGame(parkPath.c_str(), false);
+        context->GetObjectManager().LoadObjects(loadResult.RequiredObjects);
+        importer->Import();
+
+        ResetEntitySpatialIndices();
+        EntityTweener::Get().Reset();
+        return context;
+    }
+
+    static GameStateSnapshot_t& Capture(IGameStateSnapshots& snapshots)
+    {
+        auto& snapshot = snapshots.CreateSnapshot();
+        snapshots.Capture(snapshot);
+        snapshots.LinkSnapshot(snapshot, gCurrentTicks, ScenarioRandState().s0);
+        return snapshot;
+    }
+
+    // Snapshots are always serialised with every entity, whether they were captured as a delta or not.
+    static std::vector<uint8_t> Serialise(IGameStateSnapshots& snapshots, GameStateSnapshot_t& snapshot)
+    {
+        MemoryStream stream;
+        DataSerialiser ds(true, stream);
+        snapshots.SerialiseSnapshot(snapshot, ds);
+        const auto* data = static_cast<const uint8_t*>(stream.GetData());
+        return { data, data + stream.GetLength() };
+    }
+
+    static void AssertAllEqual(const GameStateCompareData& cmpData)
+    {
+        ASSERT_FALSE(cmpData.spriteChanges.empty());
+        for (const auto& change : cmpData.spriteChanges)
+        {
+            ASSERT_EQ(change.changeType, GameStateSpriteChange::EQUAL) << "entity " << change.spriteIndex;
+        }
+    }
+};
+
+TEST_F(GameStateSnapshotTests, delta_applied_to_keyframe_matches_full_capture)
+{
+    auto context = LoadPark(TestData::GetParkPath("bpb.sv6"));
+    ASSERT_NE(context, nullptr);
+
+    auto snapshots = CreateGameStateSnapshots();
+    Capture(*snapshots);
+
+    // Move entities around and remove one so the delta has changed, unchanged and removed entities.
+    for (int32_t i = 0; i < 100; i++)
+    {
+        context->GetGameState()->UpdateLogic();
+    }
+    auto guests = EntityList<Guest>();
+    auto it = guests.begin();
+    ASSERT_TRUE(it != guests.end());
+    EntityRemove(*it);
+
+    auto& delta = Capture(*snapshots);
+
+    // A new instance starts with a keyframe of the current state.
+    auto fullSnapshots = CreateGameStateSnapshots();
+    auto& full = Capture(*fullSnapshots);
+
+    AssertAllEqual(snapshots->Compare(delta, full));
+    ASSERT_EQ(Serialise(*snapshots, delta), Serialise(*fullSnapshots, full));
+}
+
+TEST_F(GameStateSnapshotTests, delta_round_trips_through_serialisation)
+{
+    auto context = LoadPark(TestData::GetParkPath("bpb.sv6"));
+    ASSERT_NE(context, nullptr);
+
+    auto snapshots = CreateGameStateSnapshots();
+    Capture(*snapshots);
+    for (int32_t i = 0; i < 100; i++)
+    {
+        context->GetGameState()->UpdateLogic();
+    }
+    auto& delta = Capture(*snapshots);
+
+    const auto data = Serialise(*snapshots, delta);
+    MemoryStream stream(data.data(), data.size());
+    DataSerialiser ds(false, stream);
+    auto& loaded = snapshots->CreateSnapshot();
+    snapshots->SerialiseSnapshot(loaded, ds);
+
+    AssertAllEqual(snapshots->Compare(delta, loaded));
+}
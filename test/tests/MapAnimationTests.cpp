@@ -0,0 +1,179 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/object/ObjectEntryManager.h>
+#include <openrct2/object/ObjectLimits.h>
+#include <openrct2/object/SmallSceneryEntry.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/MapAnimation.h>
+
+using namespace OpenRCT2;
+
+class MapAnimationTests : public testing::Test
+{
+protected:
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        ASSERT_TRUE(_context->Initialise());
+
+        // The park provides the scenery objects, the map itself is replaced by an empty one without animations.
+        ASSERT_TRUE(_context->LoadParkFromFile(TestData::GetParkPath("bpb.sv6")));
+        GameLoadInit();
+        MapInit({ 64, 64 });
+        gGamePaused = 0;
+    }
+
+    void TearDown() override
+    {
+        _context.reset();
+    }
+
+    // Every location is on its own tile, there are no viewports so all of them are off screen.
+    static CoordsXYZ GetLocation(int32_t index)
+    {
+        return { TileCoordsXY{ 1 + index % 32, 1 + index / 32 }.ToCoordsXY(), 128 };
+    }
+
+    static void AddBanner(const CoordsXYZ& loc)
+    {
+        ASSERT_NE(TileElementInsert<BannerElement>(loc, 0b1111), nullptr);
+    }
+
+    static void AddSmallScenery(const CoordsXYZ& loc, ObjectEntryIndex entryIndex)
+    {
+        auto* scenery = TileElementInsert<SmallSceneryElement>(loc, 0b1111);
+        ASSERT_NE(scenery, nullptr);
+        scenery->SetEntryIndex(entryIndex);
+    }
+
+    static ObjectEntryIndex FindAnimatedSmallScenery()
+    {
+        for (ObjectEntryIndex i = 0; i < MAX_SMALL_SCENERY_OBJECTS; i++)
+        {
+            const auto* entry = ObjectManager::GetObjectEntry<SmallSceneryEntry>(i);
+            if (entry != nullptr
+                && entry->HasFlag(
+                    SMALL_SCENERY_FLAG_FOUNTAIN_SPRAY_1 | SMALL_SCENERY_FLAG_FOUNTAIN_SPRAY_4 | SMALL_SCENERY_FLAG_SWAMP_GOO
+                    | SMALL_SCENERY_FLAG_HAS_FRAME_OFFSETS | SMALL_SCENERY_FLAG_IS_CLOCK))
+            {
+                return i;
+            }
+        }
+        return OBJECT_ENTRY_INDEX_NULL;
+    }
+};
+
+TEST_F(MapAnimationTests, create_dedups_and_orders_by_type)
+{
+    ASSERT_TRUE(GetMapAnimations().empty());
+
+    MapAnimationCreate(MAP_ANIMATION_TYPE_BANNER, GetLocation(0));
+    MapAnimationCreate(MAP_ANIMATION_TYPE_REMOVE, GetLocation(1));
+    MapAnimationCreate(MAP_ANIMATION_TYPE_BANNER, GetLocation(0));
+    MapAnimationCreate(MAP_ANIMATION_TYPE_REMOVE, GetLocation(0));
+    MapAnimationCreate(-1, GetLocation(2));
+    MapAnimationCreate(MAP_ANIMATION_TYPE_COUNT, GetLocation(2));
+
+    const auto animations = GetMapAnimations();
+    ASSERT_EQ(animations.size(), 3u);
+    ASSERT_EQ(animations[0].type, MAP_ANIMATION_TYPE_REMOVE);
+    ASSERT_EQ(animations[0].location, GetLocation(1));
+    ASSERT_EQ(animations[1].type, MAP_ANIMATION_TYPE_REMOVE);
+    ASSERT_EQ(animations[1].location, GetLocation(0));
+    ASSERT_EQ(animations[2].type, MAP_ANIMATION_TYPE_BANNER);
+    ASSERT_EQ(animations[2].location, GetLocation(0));
+}
+
+TEST_F(MapAnimationTests, removal_checks_animation_moved_into_slot)
+{
+    // Only the second location has a banner, the others are removed in the first pass. Removing the first one moves the
+    // last one into its slot, which has to be checked in the same pass.
+    AddBanner(GetLocation(1));
+    for (int32_t i = 0; i < 4; i++)
+    {
+        MapAnimationCreate(MAP_ANIMATION_TYPE_BANNER, GetLocation(i));
+    }
+
+    MapAnimationInvalidateAll();
+    auto animations = GetMapAnimations();
+    ASSERT_EQ(animations.size(), 1u);
+    ASSERT_EQ(animations[0].location, GetLocation(1));
+
+    // The remaining animation was moved, creating it again must still find it.
+    MapAnimationCreate(MAP_ANIMATION_TYPE_BANNER, GetLocation(1));
+    MapAnimationCreate(MAP_ANIMATION_TYPE_BANNER, GetLocation(0));
+    animations = GetMapAnimations();
+    ASSERT_EQ(animations.size(), 2u);
+    ASSERT_EQ(animations[0].location, GetLocation(1));
+    ASSERT_EQ(animations[1].location, GetLocation(0));
+
+    MapAnimationInvalidateAll();
+    animations = GetMapAnimations();
+    ASSERT_EQ(animations.size(), 1u);
+    ASSERT_EQ(animations[0].location, GetLocation(1));
+}
+
+TEST_F(MapAnimationTests, offscreen_animations_are_checked_in_a_rolling_window)
+{
+    // The first half has banners, the second half is only removed once the window reaches it.
+    for (int32_t i = 0; i < 64; i++)
+    {
+        if (i < 32)
+            AddBanner(GetLocation(i));
+        MapAnimationCreate(MAP_ANIMATION_TYPE_BANNER, GetLocation(i));
+    }
+
+    MapAnimationInvalidateAll();
+    ASSERT_EQ(GetMapAnimations().size(), 64u);
+
+    MapAnimationInvalidateAll();
+    ASSERT_EQ(GetMapAnimations().size(), 32u);
+
+    MapAnimationInvalidateAll();
+    ASSERT_EQ(GetMapAnimations().size(), 32u);
+}
+
+TEST_F(MapAnimationTests, small_scenery_is_checked_everywhere_on_clock_ticks)
+{
+    const auto entryIndex = FindAnimatedSmallScenery();
+    ASSERT_NE(entryIndex, OBJECT_ENTRY_INDEX_NULL);
+
+    // Only the last third has no scenery, outside of the first two windows.
+    for (int32_t i = 0; i < 96; i++)
+    {
+        if (i < 64)
+            AddSmallScenery(GetLocation(i), entryIndex);
+        MapAnimationCreate(MAP_ANIMATION_TYPE_SMALL_SCENERY, GetLocation(i));
+    }
+
+    gCurrentTicks = 1023;
+    MapAnimationInvalidateAll();
+    ASSERT_EQ(GetMapAnimations().size(), 96u);
+
+    gCurrentTicks = 1025;
+    MapAnimationInvalidateAll();
+    ASSERT_EQ(GetMapAnimations().size(), 96u);
+
+    // Clocks send peeps to look at them on these ticks, so every small scenery animation is checked.
+    gCurrentTicks = 2048;
+    MapAnimationInvalidateAll();
+    ASSERT_EQ(GetMapAnimations().size(), 64u);
+}
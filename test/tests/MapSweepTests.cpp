@@ -0,0 +1,131 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/core/JobPool.h>
+#include <openrct2/entity/EntityList.h>
+#include <openrct2/scenario/Scenario.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Park.h>
+
+using namespace OpenRCT2;
+
+class MapSweepTests : public testing::Test
+{
+protected:
+    struct SweepState
+    {
+        std::vector<TileElement> Elements;
+        random_engine_t::state_type RandState{};
+        uint16_t NumFountains{};
+    };
+
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        ASSERT_TRUE(_context->Initialise());
+    }
+
+    void TearDown() override
+    {
+        _context.reset();
+    }
+
+    void LoadPark()
+    {
+        ASSERT_TRUE(_context->LoadParkFromFile(TestData::GetParkPath("bpb.sv6")));
+        GameLoadInit();
+    }
+
+    static SweepState GetSweepState()
+    {
+        return { GetReorganisedTileElementsWithoutGhosts(), ScenarioRandState(),
+                 GetEntityListCount(EntityType::JumpingFountain) };
+    }
+
+    static void AssertSameState(const SweepState& expected, const SweepState& actual)
+    {
+        ASSERT_EQ(expected.Elements.size(), actual.Elements.size());
+        ASSERT_EQ(
+            std::memcmp(expected.Elements.data(), actual.Elements.data(), expected.Elements.size() * sizeof(TileElement)), 0);
+        ASSERT_EQ(expected.RandState.s0, actual.RandState.s0);
+        ASSERT_EQ(expected.RandState.s1, actual.RandState.s1);
+        ASSERT_EQ(expected.NumFountains, actual.NumFountains);
+    }
+};
+
+TEST_F(MapSweepTests, update_tiles_parallel_matches_serial)
+{
+    // Covers every position of each block a few times so grass grows and scenery ages.
+    static constexpr int32_t Calls = 64;
+    static constexpr int32_t PositionsPerCall = 4096;
+
+    LoadPark();
+    for (int32_t i = 0; i < Calls; i++)
+    {
+        MapUpdateTiles(PositionsPerCall, nullptr);
+    }
+    const auto serial = GetSweepState();
+
+    LoadPark();
+    JobPool jobPool;
+    for (int32_t i = 0; i < Calls; i++)
+    {
+        MapUpdateTiles(PositionsPerCall, &jobPool);
+    }
+    AssertSameState(serial, GetSweepState());
+}
+
+TEST_F(MapSweepTests, path_wide_flags_parallel_matches_serial)
+{
+    static constexpr int32_t Calls = 4;
+    static constexpr int32_t TilesPerCall = MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL / Calls + 1;
+
+    LoadPark();
+    for (int32_t i = 0; i < Calls; i++)
+    {
+        MapUpdatePathWideFlags(TilesPerCall, nullptr);
+    }
+    const auto serial = GetSweepState();
+
+    LoadPark();
+    JobPool jobPool;
+    for (int32_t i = 0; i < Calls; i++)
+    {
+        MapUpdatePathWideFlags(TilesPerCall, &jobPool);
+    }
+    AssertSameState(serial, GetSweepState());
+}
+
+TEST_F(MapSweepTests, fast_sweeps_cover_map_in_sixteen_ticks)
+{
+    LoadPark();
+    gParkFlags |= PARK_FLAGS_FAST_MAP_SWEEPS;
+
+    // Every position of each 256x256 block is updated once, after which the sweep is back where it started.
+    const auto start = gGrassSceneryTileLoopPosition;
+    MapUpdateTiles();
+    ASSERT_NE(gGrassSceneryTileLoopPosition, start);
+    for (int32_t i = 1; i < 16; i++)
+    {
+        MapUpdateTiles();
+    }
+    ASSERT_EQ(gGrassSceneryTileLoopPosition, start);
+}
@@ -0,0 +1,107 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/core/OrcaStream.hpp>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class OrcaStreamTests : public testing::TestWithParam<uint32_t>
+{
+protected:
+    static constexpr uint32_t LargeChunkId = 0x30;
+    static constexpr uint32_t SmallChunkId = 0x31;
+
+    // Larger than OrcaStream::ZLIB_BLOCK_SIZE so that it is split over several blocks
+    static std::vector<uint8_t> CreateLargeChunk()
+    {
+        std::vector<uint8_t> data(OrcaStream::ZLIB_BLOCK_SIZE * 2 + 12345);
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = static_cast<uint8_t>((i * 7) ^ (i >> 11));
+        }
+        return data;
+    }
+
+    static MemoryStream Write(uint32_t compression, std::vector<uint8_t> large, uint32_t small)
+    {
+        MemoryStream ms;
+        {
+            OrcaStream os(ms, OrcaStream::Mode::WRITING);
+            os.GetHeader().Compression = compression;
+            os.ReadWriteChunk(LargeChunkId, [&large](OrcaStream::ChunkStream& cs) {
+                cs.Write(static_cast<uint32_t>(large.size()));
+                cs.ReadWrite(large.data(), large.size());
+            });
+            os.ReadWriteChunk(SmallChunkId, [small](OrcaStream::ChunkStream& cs) { cs.Write(small); });
+        }
+        ms.SetPosition(0);
+        return ms;
+    }
+};
+
+TEST_P(OrcaStreamTests, RoundTrip)
+{
+    const auto large = CreateLargeChunk();
+    auto ms = Write(GetParam(), large, 0xDEADBEEF);
+
+    OrcaStream os(ms, OrcaStream::Mode::READING);
+    ASSERT_EQ(os.GetHeader().Compression, GetParam());
+
+    std::vector<uint8_t> readLarge;
+    ASSERT_TRUE(os.ReadWriteChunk(LargeChunkId, [&readLarge](OrcaStream::ChunkStream& cs) {
+        readLarge.resize(cs.Read<uint32_t>());
+        cs.ReadWrite(readLarge.data(), readLarge.size());
+    }));
+    ASSERT_EQ(readLarge, large);
+
+    uint32_t readSmall{};
+    ASSERT_TRUE(os.ReadWriteChunk(SmallChunkId, [&readSmall](OrcaStream::ChunkStream& cs) { readSmall = cs.Read<uint32_t>(); }));
+    ASSERT_EQ(readSmall, 0xDEADBEEF);
+
+    ASSERT_FALSE(os.ReadWriteChunk(0x99, [](OrcaStream::ChunkStream& cs) {}));
+}
+
+TEST_P(OrcaStreamTests, ReadChunkDetached)
+{
+    auto ms = Write(GetParam(), CreateLargeChunk(), 42);
+
+    OrcaStream os(ms, OrcaStream::Mode::READING);
+    uint32_t readSmall{};
+    ASSERT_TRUE(os.ReadChunkDetached(SmallChunkId, [&readSmall](OrcaStream::ChunkStream& cs) { readSmall = cs.Read<uint32_t>(); }));
+    ASSERT_EQ(readSmall, 42u);
+    ASSERT_FALSE(os.ReadChunkDetached(0x99, [](OrcaStream::ChunkStream& cs) {}));
+}
+
+TEST_P(OrcaStreamTests, DetachedWrite)
+{
+    const auto large = CreateLargeChunk();
+    auto source = Write(OrcaStream::COMPRESSION_NONE, large, 7);
+
+    auto pendingWrite = OrcaStream(source, OrcaStream::Mode::READING).Detach();
+    pendingWrite.SetCompression(GetParam());
+    MemoryStream ms;
+    pendingWrite.WriteTo(ms);
+    ms.SetPosition(0);
+
+    OrcaStream os(ms, OrcaStream::Mode::READING);
+    ASSERT_EQ(os.GetHeader().Compression, GetParam());
+    std::vector<uint8_t> readLarge;
+    ASSERT_TRUE(os.ReadWriteChunk(LargeChunkId, [&readLarge](OrcaStream::ChunkStream& cs) {
+        readLarge.resize(cs.Read<uint32_t>());
+        cs.ReadWrite(readLarge.data(), readLarge.size());
+    }));
+    ASSERT_EQ(readLarge, large);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Compression, OrcaStreamTests,
+    testing::Values(OrcaStream::COMPRESSION_NONE, OrcaStream::COMPRESSION_GZIP, OrcaStream::COMPRESSION_ZLIB_BLOCKS));
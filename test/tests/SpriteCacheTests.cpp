@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2023 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/core/Path.hpp>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/drawing/ImageImporter.h>
+#include <openrct2/drawing/SpriteCache.h>
+#include <vector>
+
+using namespace OpenRCT2::Drawing;
+
+class SpriteCacheTests : public testing::Test
+{
+protected:
+    static constexpr int32_t BufferSize = 160;
+
+    ImageImporter::ImportResult _sprite;
+
+    void SetUp() override
+    {
+        auto logoPath = Path::Combine(TestData::GetBasePath(), u8"images", u8"logo.png");
+        auto image = Imaging::ReadFromFile(logoPath, IMAGE_FORMAT::PNG_32);
+        ImageImporter importer;
+        _sprite = importer.Import(image, 0, 0, ImageImporter::Palette::OpenRCT2, ImageImporter::ImportFlags::RLE);
+        SpriteCache::Clear();
+    }
+
+    void TearDown() override
+    {
+        SpriteCache::Clear();
+        SpriteCache::SetMemoryLimit(SpriteCache::DefaultMemoryLimit);
+    }
+
+    static DrawPixelInfo CreateDPI(std::vector<uint8_t>& buffer, int8_t zoom)
+    {
+        buffer.assign(BufferSize * BufferSize, PALETTE_INDEX_10);
+        DrawPixelInfo dpi;
+        dpi.bits = buffer.data();
+        dpi.width = BufferSize << zoom;
+        dpi.height = BufferSize << zoom;
+        dpi.zoom_level = ZoomLevel{ zoom };
+        return dpi;
+    }
+};
+
+TEST_F(SpriteCacheTests, draws_same_pixels_as_rle)
+{
+    uint8_t remap[256];
+    for (int32_t i = 0; i < 256; i++)
+    {
+        remap[i] = static_cast<uint8_t>(i % 7 == 0 ? 0 : 255 - i);
+    }
+    const PaletteMap paletteMap(remap);
+
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> actual;
+    const auto& g1 = _sprite.Element;
+    for (int8_t zoom = 0; zoom <= 3; zoom++)
+    {
+        const int32_t zoomSize = 1 << zoom;
+        for (int32_t srcY = zoom == 0 ? 0 : 1 - zoomSize; srcY < zoomSize + 5; srcY++)
+        {
+            for (int32_t srcX = zoom == 0 ? 0 : 1 - zoomSize; srcX < zoomSize + 5; srcX++)
+            {
+                for (auto image : { ImageId(1), ImageId(1).WithPrimary(COLOUR_BRIGHT_RED) })
+                {
+                    const int32_t width = g1.width - std::max(0, srcX) - 3;
+                    const int32_t height = g1.height - std::max(0, srcY) - 2;
+
+                    auto dpi = CreateDPI(expected, zoom);
+                    const auto& palette = image.HasPrimary() ? paletteMap : PaletteMap::GetDefault();
+                    DrawSpriteArgs args(image, palette, g1, srcX, srcY, width, height, expected.data() + 1);
+                    GfxRleSpriteToBuffer(dpi, args);
+
+                    dpi = CreateDPI(actual, zoom);
+                    const auto key = SpriteCache::CreateKey(image, dpi.zoom_level, srcX, srcY);
+                    auto raster = SpriteCache::Insert(key, g1, image.HasPrimary() ? &paletteMap : nullptr);
+                    ASSERT_NE(raster, nullptr);
+                    SpriteCache::Draw(*raster, dpi, srcX, srcY, width, height, actual.data() + 1);
+
+                    ASSERT_EQ(expected, actual) << "zoom " << int32_t(zoom) << " at " << srcX << ", " << srcY;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(SpriteCacheTests, invalidate_and_evict)
+{
+    const auto& g1 = _sprite.Element;
+    for (ImageIndex index = 0; index < 32; index++)
+    {
+        const auto key = SpriteCache::CreateKey(ImageId(index), ZoomLevel{ 1 }, 0, 0);
+        ASSERT_NE(SpriteCache::Insert(key, g1, nullptr), nullptr);
+    }
+    ASSERT_EQ(SpriteCache::GetStats().Entries, 32u);
+
+    const auto key = SpriteCache::CreateKey(ImageId(5), ZoomLevel{ 1 }, 0, 0);
+    ASSERT_NE(SpriteCache::Find(key), nullptr);
+    SpriteCache::InvalidateImage(5);
+    ASSERT_EQ(SpriteCache::Find(key), nullptr);
+    ASSERT_EQ(SpriteCache::GetStats().Entries, 31u);
+
+    // Each shard can hold a single sprite at zoom level 1 with this limit
+    const auto spriteSize = SpriteCache::Find(SpriteCache::CreateKey(ImageId(6), ZoomLevel{ 1 }, 0, 0))->GetSize();
+    SpriteCache::SetMemoryLimit(spriteSize * 16);
+    const auto stats = SpriteCache::GetStats();
+    ASSERT_LE(stats.Bytes, stats.MemoryLimit);
+    ASSERT_EQ(stats.Entries, 16u);
+}
@@ -9,12 +9,16 @@
 
 #include "TestData.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <memory>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
+#include <openrct2/config/Config.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Map.h>
 #include <openrct2/world/TileElementsView.h>
@@ -49,6 +53,17 @@ protected:
         gScreenFlags = _gScreenFlags;
     }
 
+    void TearDown() override
+    {
+        // Restored here rather than at the end of the tests that enable it, so a failed assertion does not leak into
+        // the following tests.
+        if (gConfigGeneral.AlignTileElements)
+        {
+            gConfigGeneral.AlignTileElements = false;
+            ReorganiseTileElements();
+        }
+    }
+
 private:
     static std::shared_ptr<IContext> _context;
     static uint8_t _gScreenFlags;
@@ -179,3 +194,122 @@ TEST_F(TileElementsViewTests, QueryTypeBannerElements)
 {
     CheckMapTiles<BannerElement>();
 }
+
+TEST_F(TileElementsViewTests, AlignedLayout)
+{
+    const auto packedElements = GetReorganisedTileElementsWithoutGhosts();
+
+    gConfigGeneral.AlignTileElements = true;
+    ReorganiseTileElements();
+
+    for (int y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; ++y)
+    {
+        for (int x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; ++x)
+        {
+            const auto* firstElement = MapGetFirstElementAt(TileCoordsXY(x, y));
+            const auto* element = firstElement;
+            size_t numElements = 0;
+            do
+            {
+                numElements++;
+            } while (!(element++)->IsLastForTile());
+            const auto firstLine = reinterpret_cast<uintptr_t>(firstElement) / TILE_ELEMENT_CACHE_LINE_SIZE;
+            const auto lastLine = (reinterpret_cast<uintptr_t>(element) - 1) / TILE_ELEMENT_CACHE_LINE_SIZE;
+            ASSERT_LE(lastLine - firstLine + 1, (numElements + TILE_ELEMENTS_PER_CACHE_LINE - 1) / TILE_ELEMENTS_PER_CACHE_LINE)
+                << "x = " << x << ", y = " << y;
+        }
+    }
+    CheckMapTiles<TileElement>();
+    CheckMapTiles<PathElement>();
+
+    // Converting back gives the same elements as before
+    const auto elements = GetReorganisedTileElementsWithoutGhosts();
+    ASSERT_EQ(elements.size(), packedElements.size());
+    ASSERT_EQ(std::memcmp(elements.data(), packedElements.data(), elements.size() * sizeof(TileElement)), 0);
+}
+
+TEST_F(TileElementsViewTests, GrowingLastTileReclaimsOldCopy)
+{
+    gConfigGeneral.AlignTileElements = true;
+    ReorganiseTileElements();
+
+    // The last tile in the storage is the last one of the tile index, outside of the map.
+    const auto tileLoc = TileCoordsXY(MAXIMUM_MAP_SIZE_TECHNICAL - 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    const auto& elements = GetTileElements();
+    const auto tileIndex = static_cast<size_t>(MapGetFirstElementAt(tileLoc) - elements.data());
+    const auto numElements = elements.size() - tileIndex;
+    const auto numBannersBefore = std::count_if(
+        &elements[tileIndex], elements.data() + elements.size(),
+        [](const TileElement& element) { return element.GetType() == TileElementType::Banner; });
+
+    static constexpr size_t NumInserts = 10;
+    for (size_t i = 0; i < NumInserts; i++)
+    {
+        auto* banner = TileElementInsert<BannerElement>(CoordsXYZ(tileLoc.ToCoordsXY(), 8 * (i + 1)), 0);
+        ASSERT_NE(banner, nullptr);
+        ASSERT_EQ(banner->GetBaseZ(), static_cast<int32_t>(8 * (i + 1)));
+    }
+
+    // The tile is at most moved forward to the next cache line, old copies are not left in front of it.
+    const auto* firstElement = MapGetFirstElementAt(tileLoc);
+    ASSERT_LE(static_cast<size_t>(firstElement - elements.data()), tileIndex + TILE_ELEMENTS_PER_CACHE_LINE - 1);
+    ASSERT_EQ(firstElement + numElements + NumInserts, elements.data() + elements.size());
+
+    for (size_t i = 0; i < numElements + NumInserts; i++)
+    {
+        ASSERT_EQ(firstElement[i].IsLastForTile(), i == numElements + NumInserts - 1);
+    }
+    const auto numBanners = std::count_if(
+        firstElement, firstElement + numElements + NumInserts,
+        [](const TileElement& element) { return element.GetType() == TileElementType::Banner; });
+    ASSERT_EQ(numBanners, numBannersBefore + static_cast<ptrdiff_t>(NumInserts));
+}
+
+TEST_F(TileElementsViewTests, GrowingNeighbouringTilesAlternately)
+{
+    gConfigGeneral.AlignTileElements = true;
+    ReorganiseTileElements();
+
+    // The second tile is the last one in the storage, they take turns being moved to the end.
+    const std::array<TileCoordsXY, 2> tiles{
+        TileCoordsXY(MAXIMUM_MAP_SIZE_TECHNICAL - 2, MAXIMUM_MAP_SIZE_TECHNICAL - 1),
+        TileCoordsXY(MAXIMUM_MAP_SIZE_TECHNICAL - 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1),
+    };
+    auto countElements = [](const TileCoordsXY& loc, TileElementType type) {
+        size_t numElements = 0;
+        size_t numOfType = 0;
+        const auto* element = MapGetFirstElementAt(loc);
+        do
+        {
+            numElements++;
+            numOfType += element->GetType() == type ? 1 : 0;
+        } while (!(element++)->IsLastForTile());
+        return std::make_pair(numElements, numOfType);
+    };
+
+    std::array<std::pair<size_t, size_t>, 2> before;
+    for (size_t t = 0; t < tiles.size(); t++)
+    {
+        before[t] = countElements(tiles[t], TileElementType::Banner);
+    }
+
+    static constexpr size_t NumInserts = 12;
+    for (size_t i = 0; i < NumInserts; i++)
+    {
+        for (const auto& tile : tiles)
+        {
+            auto* banner = TileElementInsert<BannerElement>(CoordsXYZ(tile.ToCoordsXY(), 8 * (i + 1)), 0);
+            ASSERT_NE(banner, nullptr);
+        }
+    }
+
+    std::array<std::pair<const TileElement*, const TileElement*>, 2> ranges;
+    for (size_t t = 0; t < tiles.size(); t++)
+    {
+        const auto [numElements, numBanners] = countElements(tiles[t], TileElementType::Banner);
+        ASSERT_EQ(numElements, before[t].first + NumInserts) << "tile " << t;
+        ASSERT_EQ(numBanners, before[t].second + NumInserts) << "tile " << t;
+        ranges[t] = { MapGetFirstElementAt(tiles[t]), MapGetFirstElementAt(tiles[t]) + numElements };
+    }
+    ASSERT_TRUE(ranges[0].second <= ranges[1].first || ranges[1].second <= ranges[0].first);
+}